@@ -0,0 +1,387 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CFrameStatisticsAccumulator.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 09:52 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CFrameStatisticsAccumulator.h"
+
+// Luma weights (BT.601) in 8-bit fixed point, they sum up to 256.
+#define LUMA_WEIGHT_BLUE    29
+#define LUMA_WEIGHT_GREEN   150
+#define LUMA_WEIGHT_RED     77
+
+// Number of 8-pixel iterations after which the Laplacian's sum of squares is flushed
+//  from the 32-bit SIMD lanes, each iteration adds at most 2 * 1020^2 to a lane.
+#define LAPLACIAN_FLUSH_ITERATIONS 1024
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CFrameStatisticsAccumulator::CFrameStatisticsAccumulator() :
+    m_widthInPixels{ 0 },
+    m_pixelCount{ 0 },
+    m_sumBlue{ 0 },
+    m_sumGreen{ 0 },
+    m_sumRed{ 0 },
+    m_min{},
+    m_max{},
+    m_lumaHistograms{},
+    m_lumaRows{ nullptr },
+    m_lumaRowsCount{ 0 },
+    m_laplacianCount{ 0 },
+    m_laplacianSum{ 0 },
+    m_laplacianSumOfSquares{ 0 }
+{
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// Reset
+// --------------------------------------------------------------------
+
+void CFrameStatisticsAccumulator::Reset(UINT32 widthInPixels) noexcept(false)
+{
+    // Reallocate the rolling luma rows only if the width has changed
+    if (!m_lumaRows || m_widthInPixels != widthInPixels)
+    {
+        m_lumaRows = std::make_unique<BYTE[]>(static_cast<size_t>(widthInPixels) * 3);
+        m_widthInPixels = widthInPixels;
+    }
+
+    m_pixelCount = 0;
+
+    m_sumBlue = 0;
+    m_sumGreen = 0;
+    m_sumRed = 0;
+
+    std::fill(std::begin(m_min), std::end(m_min), static_cast<BYTE>(0xFF));
+    std::fill(std::begin(m_max), std::end(m_max), static_cast<BYTE>(0x00));
+
+    std::memset(m_lumaHistograms, 0, sizeof(m_lumaHistograms));
+
+    m_lumaRowsCount = 0;
+
+    m_laplacianCount = 0;
+    m_laplacianSum = 0;
+    m_laplacianSumOfSquares = 0;
+}
+
+// --------------------------------------------------------------------
+// AccumulateRows
+//
+// The SIMD loop handles 4 BGRA pixels per iteration, each pixel
+//  in its own 32-bit lane, so every channel can be masked out of
+//  the lane and the luma computed with 16-bit multiplications.
+// --------------------------------------------------------------------
+
+void CFrameStatisticsAccumulator::AccumulateRows(const BYTE *pbScanline0, LONG lStride, UINT32 rows)
+{
+    assert(pbScanline0 != nullptr);
+    assert(m_lumaRows != nullptr);
+
+    const __m128i maskLowByte{ _mm_set1_epi32(0xFF) };
+    const __m128i weightBlue{ _mm_set1_epi32(LUMA_WEIGHT_BLUE) };
+    const __m128i weightGreen{ _mm_set1_epi32(LUMA_WEIGHT_GREEN) };
+    const __m128i weightRed{ _mm_set1_epi32(LUMA_WEIGHT_RED) };
+    const __m128i rounding{ _mm_set1_epi32(128) };
+
+    INT32 packedMin{ 0 };
+    INT32 packedMax{ 0 };
+    std::memcpy(&packedMin, m_min, sizeof(packedMin));
+    std::memcpy(&packedMax, m_max, sizeof(packedMax));
+
+    __m128i minBgra{ _mm_set1_epi32(packedMin) };
+    __m128i maxBgra{ _mm_set1_epi32(packedMax) };
+
+    for (UINT32 y = 0; y < rows; y++)
+    {
+        const BYTE *pbRow{ pbScanline0 + static_cast<LONG_PTR>(lStride) * y };
+        BYTE *pbLumaRow{ m_lumaRows.get() + static_cast<size_t>(m_lumaRowsCount % 3) * m_widthInPixels };
+
+        __m128i sumBlue{ _mm_setzero_si128() };
+        __m128i sumGreen{ _mm_setzero_si128() };
+        __m128i sumRed{ _mm_setzero_si128() };
+
+        UINT32 x{ 0 };
+        for (; x + 4 <= m_widthInPixels; x += 4)
+        {
+            __m128i bgra{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbRow + static_cast<size_t>(x) * 4)) };
+
+            minBgra = _mm_min_epu8(minBgra, bgra);
+            maxBgra = _mm_max_epu8(maxBgra, bgra);
+
+            __m128i blue{ _mm_and_si128(bgra, maskLowByte) };
+            __m128i green{ _mm_and_si128(_mm_srli_epi32(bgra, 8), maskLowByte) };
+            __m128i red{ _mm_and_si128(_mm_srli_epi32(bgra, 16), maskLowByte) };
+
+            sumBlue = _mm_add_epi32(sumBlue, blue);
+            sumGreen = _mm_add_epi32(sumGreen, green);
+            sumRed = _mm_add_epi32(sumRed, red);
+
+            // The high 16 bits of each lane are zero, and each product fits in 16 bits,
+            //  so the 16-bit multiplication yields the full product in the 32-bit lane.
+            __m128i luma{ _mm_add_epi32(_mm_mullo_epi16(blue, weightBlue), _mm_mullo_epi16(green, weightGreen)) };
+            luma = _mm_add_epi32(luma, _mm_mullo_epi16(red, weightRed));
+            luma = _mm_srli_epi32(_mm_add_epi32(luma, rounding), 8);
+
+            UINT32 packedLuma{ static_cast<UINT32>(
+                _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(luma, luma), _mm_setzero_si128()))
+                ) };
+            std::memcpy(pbLumaRow + x, &packedLuma, sizeof(packedLuma));
+
+            m_lumaHistograms[0][packedLuma & 0xFF]++;
+            m_lumaHistograms[1][(packedLuma >> 8) & 0xFF]++;
+            m_lumaHistograms[2][(packedLuma >> 16) & 0xFF]++;
+            m_lumaHistograms[3][(packedLuma >> 24) & 0xFF]++;
+        }
+
+        alignas(16) UINT32 lanes[4]{};
+
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sumBlue);
+        m_sumBlue += static_cast<UINT64>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sumGreen);
+        m_sumGreen += static_cast<UINT64>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sumRed);
+        m_sumRed += static_cast<UINT64>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+
+        // Remaining pixels of the row
+        for (; x < m_widthInPixels; x++)
+        {
+            const BYTE *pbPixel{ pbRow + static_cast<size_t>(x) * 4 };
+
+            for (int i = 0; i < 4; i++)
+            {
+                m_min[i] = (std::min)(m_min[i], pbPixel[i]);
+                m_max[i] = (std::max)(m_max[i], pbPixel[i]);
+            }
+
+            m_sumBlue += pbPixel[0];
+            m_sumGreen += pbPixel[1];
+            m_sumRed += pbPixel[2];
+
+            BYTE luma{ static_cast<BYTE>(
+                (pbPixel[0] * LUMA_WEIGHT_BLUE + pbPixel[1] * LUMA_WEIGHT_GREEN + pbPixel[2] * LUMA_WEIGHT_RED + 128) >> 8
+                ) };
+            pbLumaRow[x] = luma;
+
+            m_lumaHistograms[0][luma]++;
+        }
+
+        m_lumaRowsCount++;
+
+        // Now the row above has both of its neighbours
+        if (m_lumaRowsCount >= 3)
+        {
+            AccumulateLaplacianRow();
+        }
+    }
+
+    // Merge the SIMD min/max with the scalar ones
+    {
+        alignas(16) BYTE minBytes[16]{};
+        alignas(16) BYTE maxBytes[16]{};
+        _mm_store_si128(reinterpret_cast<__m128i *>(minBytes), minBgra);
+        _mm_store_si128(reinterpret_cast<__m128i *>(maxBytes), maxBgra);
+
+        for (int i = 0; i < 16; i++)
+        {
+            m_min[i % 4] = (std::min)(m_min[i % 4], minBytes[i]);
+            m_max[i % 4] = (std::max)(m_max[i % 4], maxBytes[i]);
+        }
+    }
+
+    m_pixelCount += static_cast<UINT64>(m_widthInPixels) * rows;
+}
+
+// --------------------------------------------------------------------
+// Merge
+// --------------------------------------------------------------------
+
+void CFrameStatisticsAccumulator::Merge(const CFrameStatisticsAccumulator &other)
+{
+    assert(other.m_widthInPixels == m_widthInPixels);
+
+    m_pixelCount += other.m_pixelCount;
+
+    m_sumBlue += other.m_sumBlue;
+    m_sumGreen += other.m_sumGreen;
+    m_sumRed += other.m_sumRed;
+
+    for (int i = 0; i < 4; i++)
+    {
+        m_min[i] = (std::min)(m_min[i], other.m_min[i]);
+        m_max[i] = (std::max)(m_max[i], other.m_max[i]);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 256; j++)
+        {
+            m_lumaHistograms[i][j] += other.m_lumaHistograms[i][j];
+        }
+    }
+
+    m_laplacianCount += other.m_laplacianCount;
+    m_laplacianSum += other.m_laplacianSum;
+    m_laplacianSumOfSquares += other.m_laplacianSumOfSquares;
+}
+
+// --------------------------------------------------------------------
+// Finalize
+// --------------------------------------------------------------------
+
+void CFrameStatisticsAccumulator::Finalize(FRAME_STATISTICS *pStatistics) const
+{
+    assert(pStatistics != nullptr);
+
+    *pStatistics = FRAME_STATISTICS{};
+
+    if (m_pixelCount == 0) { return; }
+
+    UINT64 sumLuma{ 0 };
+    bool bMinLumaFound{ false };
+
+    for (int i = 0; i < 256; i++)
+    {
+        UINT32 count{ m_lumaHistograms[0][i] + m_lumaHistograms[1][i] + m_lumaHistograms[2][i] + m_lumaHistograms[3][i] };
+
+        pStatistics->lumaHistogram[i] = count;
+        sumLuma += static_cast<UINT64>(count) * i;
+
+        if (count == 0) { continue; }
+
+        if (!bMinLumaFound)
+        {
+            pStatistics->minLuma = static_cast<BYTE>(i);
+            bMinLumaFound = true;
+        }
+        pStatistics->maxLuma = static_cast<BYTE>(i);
+    }
+
+    const double pixelCount{ static_cast<double>(m_pixelCount) };
+
+    pStatistics->meanLuma = static_cast<double>(sumLuma) / pixelCount;
+    pStatistics->meanBlue = static_cast<double>(m_sumBlue) / pixelCount;
+    pStatistics->meanGreen = static_cast<double>(m_sumGreen) / pixelCount;
+    pStatistics->meanRed = static_cast<double>(m_sumRed) / pixelCount;
+
+    pStatistics->minBlue = m_min[0];
+    pStatistics->minGreen = m_min[1];
+    pStatistics->minRed = m_min[2];
+
+    pStatistics->maxBlue = m_max[0];
+    pStatistics->maxGreen = m_max[1];
+    pStatistics->maxRed = m_max[2];
+
+    if (m_laplacianCount > 0)
+    {
+        const double laplacianCount{ static_cast<double>(m_laplacianCount) };
+        const double laplacianMean{ static_cast<double>(m_laplacianSum) / laplacianCount };
+
+        pStatistics->sharpness
+            = static_cast<double>(m_laplacianSumOfSquares) / laplacianCount - laplacianMean * laplacianMean;
+    }
+}
+
+// ===============================
+// ====== Private Functions ======
+// ===============================
+
+// --------------------------------------------------------------------
+// AccumulateLaplacianRow
+//
+// Accumulates the Laplacian of the middle row out of the last three
+//  luma rows, border pixels are skipped.
+// --------------------------------------------------------------------
+
+void CFrameStatisticsAccumulator::AccumulateLaplacianRow()
+{
+    assert(m_lumaRowsCount >= 3);
+
+    const UINT32 width{ m_widthInPixels };
+    if (width < 3) { return; }
+
+    const BYTE *pbAbove{ m_lumaRows.get() + static_cast<size_t>((m_lumaRowsCount - 3) % 3) * width };
+    const BYTE *pbCenter{ m_lumaRows.get() + static_cast<size_t>((m_lumaRowsCount - 2) % 3) * width };
+    const BYTE *pbBelow{ m_lumaRows.get() + static_cast<size_t>((m_lumaRowsCount - 1) % 3) * width };
+
+    const __m128i zero{ _mm_setzero_si128() };
+    const __m128i ones{ _mm_set1_epi16(1) };
+
+    __m128i sum{ _mm_setzero_si128() };
+    __m128i sumOfSquares{ _mm_setzero_si128() };
+    UINT32 iterations{ 0 };
+
+    alignas(16) INT32 signedLanes[4]{};
+    alignas(16) UINT32 unsignedLanes[4]{};
+
+    auto flushSumOfSquares = [&]()
+    {
+        _mm_store_si128(reinterpret_cast<__m128i *>(unsignedLanes), sumOfSquares);
+        m_laplacianSumOfSquares
+            += static_cast<UINT64>(unsignedLanes[0]) + unsignedLanes[1] + unsignedLanes[2] + unsignedLanes[3];
+        sumOfSquares = _mm_setzero_si128();
+    };
+
+    UINT32 x{ 1 };
+    for (; x + 9 <= width; x += 8)
+    {
+        __m128i center{ _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pbCenter + x)), zero) };
+        __m128i left{ _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pbCenter + x - 1)), zero) };
+        __m128i right{ _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pbCenter + x + 1)), zero) };
+        __m128i above{ _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pbAbove + x)), zero) };
+        __m128i below{ _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pbBelow + x)), zero) };
+
+        __m128i laplacian{ _mm_sub_epi16(
+            _mm_slli_epi16(center, 2),
+            _mm_add_epi16(_mm_add_epi16(left, right), _mm_add_epi16(above, below))
+            ) };
+
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(laplacian, ones));
+        sumOfSquares = _mm_add_epi32(sumOfSquares, _mm_madd_epi16(laplacian, laplacian));
+
+        if (++iterations == LAPLACIAN_FLUSH_ITERATIONS)
+        {
+            flushSumOfSquares();
+            iterations = 0;
+        }
+    }
+
+    flushSumOfSquares();
+
+    _mm_store_si128(reinterpret_cast<__m128i *>(signedLanes), sum);
+    m_laplacianSum += static_cast<INT64>(signedLanes[0]) + signedLanes[1] + signedLanes[2] + signedLanes[3];
+
+    // Remaining pixels of the row
+    for (; x + 1 < width; x++)
+    {
+        INT32 laplacian{
+            4 * pbCenter[x] - pbCenter[x - 1] - pbCenter[x + 1] - pbAbove[x] - pbBelow[x]
+        };
+
+        m_laplacianSum += laplacian;
+        m_laplacianSumOfSquares += static_cast<UINT64>(laplacian * laplacian);
+    }
+
+    m_laplacianCount += width - 2;
+}
+
+#pragma managed(pop)
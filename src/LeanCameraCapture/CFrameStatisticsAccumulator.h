@@ -0,0 +1,120 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CFrameStatisticsAccumulator.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 09:40 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        // ========================================
+        // ====== FRAME_STATISTICS Structure ======
+        // ========================================
+
+        /// <summary>
+        /// Statistics computed over a single BGRA frame.
+        /// </summary>
+        struct FRAME_STATISTICS
+        {
+            UINT32  lumaHistogram[256];     // Count of pixels per luma (BT.601) value.
+
+            double  meanLuma;
+            double  meanBlue;
+            double  meanGreen;
+            double  meanRed;
+
+            BYTE    minLuma;
+            BYTE    minBlue;
+            BYTE    minGreen;
+            BYTE    minRed;
+
+            BYTE    maxLuma;
+            BYTE    maxBlue;
+            BYTE    maxGreen;
+            BYTE    maxRed;
+
+            double  sharpness;              // Variance of the 4-neighbour Laplacian over luma.
+        };
+
+        // ==========================================================
+        // ====== CFrameStatisticsAccumulator Class Definition ======
+        // ==========================================================
+
+        /// <summary>
+        /// Accumulates FRAME_STATISTICS over a BGRA frame fed as bands of rows from top to bottom,
+        ///  so the statistics can be computed in the same pass that copies the rows.
+        /// </summary>
+        class CFrameStatisticsAccumulator
+        {
+            /* === Member Functions === */
+        public:
+            CFrameStatisticsAccumulator();
+
+            /// <summary>
+            /// Start a new frame with the passed width.
+            /// </summary>
+            void Reset(UINT32 widthInPixels) noexcept(false);
+
+            /// <summary>
+            /// Accumulate the next band of BGRA rows of the frame.
+            /// </summary>
+            void AccumulateRows(const BYTE *pbScanline0, LONG lStride, UINT32 rows);
+
+            /// <summary>
+            /// Merge the statistics of another band of the same frame, accumulated separately.
+            /// The Laplacian isn't computed across the rows where the two bands meet.
+            /// </summary>
+            void Merge(const CFrameStatisticsAccumulator &other);
+
+            /// <summary>
+            /// Finalize the accumulated statistics into the passed structure.
+            /// </summary>
+            void Finalize(FRAME_STATISTICS *pStatistics) const;
+
+        private:
+            void AccumulateLaplacianRow();
+
+            /* === Data Members === */
+        private:
+            UINT32                  m_widthInPixels;
+            UINT64                  m_pixelCount;
+
+            UINT64                  m_sumBlue;
+            UINT64                  m_sumGreen;
+            UINT64                  m_sumRed;
+
+            BYTE                    m_min[4];               // Per byte of BGRA.
+            BYTE                    m_max[4];               // Per byte of BGRA.
+
+            // We keep 4 histograms, one per lane of the SIMD loop, and merge them on `Finalize`.
+            //  Consecutive pixels usually have the same luma, and incrementing the same counter
+            //  back to back stalls on store forwarding.
+            UINT32                  m_lumaHistograms[4][256];
+
+            // Rolling luma rows used for the Laplacian; the Laplacian of a row is computed
+            //  once the row below it has been accumulated.
+            std::unique_ptr<BYTE[]> m_lumaRows;
+            UINT32                  m_lumaRowsCount;        // Total luma rows accumulated for the frame.
+
+            UINT64                  m_laplacianCount;
+            INT64                   m_laplacianSum;
+            UINT64                  m_laplacianSumOfSquares;
+        };
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,106 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CReadQueue.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 11:46 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CReadQueue.h"
+
+#define READ_QUEUE_INDEX_MASK (READ_QUEUE_CAPACITY - 1)
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CReadQueue::CReadQueue() :
+    m_destinations{},
+    m_lTail{ 0 },
+    m_lHead{ 0 }
+{
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// TryPush
+//
+// The destination is written before the tail is advanced in an exchange,
+//  which is a full barrier, so the consumer sees it with the new tail.
+// --------------------------------------------------------------------
+
+bool CReadQueue::TryPush(const IMAGE_VIEW &destination)
+{
+    const LONG lTail{ m_lTail };
+
+    // Atomic read of the head, it's advanced by the consumer, the counts are unsigned to wrap
+    const ULONG ulCount{ static_cast<ULONG>(lTail) - static_cast<ULONG>(InterlockedCompareExchange(&m_lHead, 0, 0)) };
+
+    if (ulCount >= READ_QUEUE_CAPACITY) { return false; }
+
+    m_destinations[lTail & READ_QUEUE_INDEX_MASK] = destination;
+
+    InterlockedExchange(&m_lTail, static_cast<LONG>(static_cast<ULONG>(lTail) + 1));
+
+    return true;
+}
+
+// --------------------------------------------------------------------
+// PopBack
+// --------------------------------------------------------------------
+
+void CReadQueue::PopBack()
+{
+    assert(m_lTail != m_lHead);
+
+    InterlockedExchange(&m_lTail, static_cast<LONG>(static_cast<ULONG>(m_lTail) - 1));
+}
+
+// --------------------------------------------------------------------
+// TryPop
+//
+// The destination is copied out before the head is advanced,
+//  so the producer doesn't overwrite it while being read.
+// --------------------------------------------------------------------
+
+bool CReadQueue::TryPop(IMAGE_VIEW *pDestination)
+{
+    assert(pDestination != nullptr);
+
+    const LONG lHead{ m_lHead };
+
+    // Atomic read of the tail, it's advanced by the producer
+    if (InterlockedCompareExchange(&m_lTail, 0, 0) == lHead) { return false; }
+
+    *pDestination = m_destinations[lHead & READ_QUEUE_INDEX_MASK];
+
+    InterlockedExchange(&m_lHead, static_cast<LONG>(static_cast<ULONG>(lHead) + 1));
+
+    return true;
+}
+
+// --------------------------------------------------------------------
+// Clear
+// --------------------------------------------------------------------
+
+void CReadQueue::Clear()
+{
+    InterlockedExchange(&m_lHead, 0);
+    InterlockedExchange(&m_lTail, 0);
+}
+
+#pragma managed(pop)
@@ -0,0 +1,77 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CReadQueue.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 11:40 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+// Reads pending at once, a power of two for the indices to wrap with a mask.
+#define READ_QUEUE_CAPACITY 256
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        // =========================================
+        // ====== CReadQueue Class Definition ======
+        // =========================================
+
+        /// <summary>
+        /// Destinations of the issued reads, passed from the thread issuing the reads
+        ///  to the thread handling their samples without locking. A ring of fixed capacity
+        ///  with a single producer and a single consumer, each owning one of the indices.
+        /// </summary>
+        class CReadQueue
+        {
+            /* === Member Functions === */
+        public:
+            CReadQueue();
+
+            CReadQueue(const CReadQueue &) = delete;
+            CReadQueue &operator=(const CReadQueue &) = delete;
+
+            /// <summary>
+            /// [Producer] Push the destination of a read, returns false if the queue is full.
+            /// </summary>
+            bool TryPush(const IMAGE_VIEW &destination);
+
+            /// <summary>
+            /// [Producer] Take back the last pushed destination, for a read that failed to be issued.
+            ///  Its sample never arrives, so the consumer can't have popped it.
+            /// </summary>
+            void PopBack();
+
+            /// <summary>
+            /// [Consumer] Pop the destination of the oldest read, returns false if the queue is empty.
+            /// </summary>
+            bool TryPop(IMAGE_VIEW *pDestination);
+
+            /// <summary>
+            /// Empty the queue, neither the producer nor the consumer may be using it.
+            /// </summary>
+            void Clear();
+
+            /* === Data Members === */
+        private:
+            IMAGE_VIEW              m_destinations[READ_QUEUE_CAPACITY];
+
+            // Count of the pushed and popped destinations, wrapping, written only by their owner.
+            volatile LONG           m_lTail;                // Owned by the producer.
+            volatile LONG           m_lHead;                // Owned by the consumer.
+        };
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,206 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CReaderCounters.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 02:25 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CReaderCounters.h"
+
+// Weight of the latest frame interval in the smoothed frames per second.
+#define FRAMES_PER_SECOND_SMOOTHING 0.1
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// ReadCounter
+//
+// Atomic read of a 64-bit counter, also on 32-bit builds.
+// --------------------------------------------------------------------
+
+static LONG64 ReadCounter(volatile LONG64 *pCounter)
+{
+    return InterlockedCompareExchange64(pCounter, 0, 0);
+}
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CReaderCounters::CReaderCounters() :
+    m_nRefCount{ 1 },
+    m_llPerformanceFrequency{ 0 },
+    m_llDeliveredFrames{ 0 },
+    m_llLastDeliveryTime{ 0 },
+    m_llFramesPerSecondBits{ 0 },
+    m_llStreamTicks{ 0 },
+    m_llBackpressureDrops{ 0 },
+    m_llStaleDrops{ 0 },
+    m_llDecimatedFrames{ 0 },
+    m_llFramePoolDrops{ 0 },
+    m_llConversionFailures{ 0 },
+    m_llFormatChanges{ 0 },
+    m_llOpens{ 0 },
+    m_llBytesCopied{ 0 },
+    m_llDispatchAllocatedBytes{ 0 },
+    m_llOpenStartTime{ 0 },
+    m_llTimeToFirstFrame{ 0 },
+    m_lIsNegotiationCached{ 0 },
+    m_lQueueDepth{ 0 }
+{
+    LARGE_INTEGER frequency{};
+    QueryPerformanceFrequency(&frequency);
+    m_llPerformanceFrequency = frequency.QuadPart;
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+ULONG CReaderCounters::AddRef()
+{
+    return InterlockedIncrement(&m_nRefCount);
+}
+
+ULONG CReaderCounters::Release()
+{
+    ULONG uCount = InterlockedDecrement(&m_nRefCount);
+    if (uCount == 0)
+    {
+        delete this;
+    }
+    return uCount;
+}
+
+// --------------------------------------------------------------------
+// AddDeliveredFrame
+//
+// The frames per second are smoothed with an exponentially weighted
+//  moving average of the rate between consecutive frames.
+// --------------------------------------------------------------------
+
+void CReaderCounters::AddDeliveredFrame(UINT64 cbCopied)
+{
+    LARGE_INTEGER now{};
+    QueryPerformanceCounter(&now);
+
+    const LONG64 llLastDeliveryTime{ ReadCounter(&m_llLastDeliveryTime) };
+
+    if (llLastDeliveryTime != 0 && now.QuadPart > llLastDeliveryTime)
+    {
+        const double rate{
+            static_cast<double>(m_llPerformanceFrequency) / static_cast<double>(now.QuadPart - llLastDeliveryTime)
+        };
+
+        LONG64 llBits{ ReadCounter(&m_llFramesPerSecondBits) };
+        double framesPerSecond{ 0.0 };
+        std::memcpy(&framesPerSecond, &llBits, sizeof(framesPerSecond));
+
+        framesPerSecond = (framesPerSecond == 0.0)
+            ? rate
+            : framesPerSecond + FRAMES_PER_SECOND_SMOOTHING * (rate - framesPerSecond);
+
+        std::memcpy(&llBits, &framesPerSecond, sizeof(llBits));
+        InterlockedExchange64(&m_llFramesPerSecondBits, llBits);
+    }
+
+    // First frame of the open
+    if (ReadCounter(&m_llOpenStartTime) != 0)
+    {
+        const LONG64 llOpenStartTime{ InterlockedExchange64(&m_llOpenStartTime, 0) };
+        if (llOpenStartTime != 0 && now.QuadPart > llOpenStartTime)
+        {
+            InterlockedExchange64(
+                &m_llTimeToFirstFrame,
+                static_cast<LONG64>(static_cast<double>(now.QuadPart - llOpenStartTime) * 10000000.0 / static_cast<double>(m_llPerformanceFrequency))
+                );
+        }
+    }
+
+    InterlockedExchange64(&m_llLastDeliveryTime, now.QuadPart);
+    InterlockedIncrement64(&m_llDeliveredFrames);
+    InterlockedAdd64(&m_llBytesCopied, static_cast<LONG64>(cbCopied));
+}
+
+// --------------------------------------------------------------------
+// SetOpenStart
+//
+// Sets the performance counter on starting to open the device, the
+//  time to its first frame is measured from it and reported once the
+//  frame is delivered.
+// --------------------------------------------------------------------
+
+void CReaderCounters::SetOpenStart(LONGLONG llOpenStartTime, bool bIsNegotiationCached)
+{
+    InterlockedExchange64(&m_llTimeToFirstFrame, 0);
+    InterlockedExchange(&m_lIsNegotiationCached, bIsNegotiationCached ? 1 : 0);
+    InterlockedExchange64(&m_llOpenStartTime, llOpenStartTime);
+}
+
+// --------------------------------------------------------------------
+// GetSnapshot
+//
+// The smoothed rate only moves on delivered frames, so if no frame
+//  has been delivered for longer than the smoothed interval, the rate
+//  since the last frame is reported instead, and it falls towards zero
+//  while the reader is stalled.
+// --------------------------------------------------------------------
+
+void CReaderCounters::GetSnapshot(READER_COUNTERS *pCounters)
+{
+    assert(pCounters != nullptr);
+
+    const LONG64 llBits{ ReadCounter(&m_llFramesPerSecondBits) };
+    double framesPerSecond{ 0.0 };
+    std::memcpy(&framesPerSecond, &llBits, sizeof(framesPerSecond));
+
+    const LONG64 llLastDeliveryTime{ ReadCounter(&m_llLastDeliveryTime) };
+    if (llLastDeliveryTime != 0 && framesPerSecond > 0.0)
+    {
+        LARGE_INTEGER now{};
+        QueryPerformanceCounter(&now);
+
+        if (now.QuadPart > llLastDeliveryTime)
+        {
+            const double rateSinceLastFrame{
+                static_cast<double>(m_llPerformanceFrequency) / static_cast<double>(now.QuadPart - llLastDeliveryTime)
+            };
+            framesPerSecond = (std::min)(framesPerSecond, rateSinceLastFrame);
+        }
+    }
+
+    const LONG64 llOpens{ ReadCounter(&m_llOpens) };
+    const LONG lQueueDepth{ m_lQueueDepth };
+
+    pCounters->deliveredFramesPerSecond = framesPerSecond;
+    pCounters->deliveredFrames = static_cast<UINT64>(ReadCounter(&m_llDeliveredFrames));
+    pCounters->streamTicks = static_cast<UINT64>(ReadCounter(&m_llStreamTicks));
+    pCounters->backpressureDrops = static_cast<UINT64>(ReadCounter(&m_llBackpressureDrops));
+    pCounters->staleDrops = static_cast<UINT64>(ReadCounter(&m_llStaleDrops));
+    pCounters->decimatedFrames = static_cast<UINT64>(ReadCounter(&m_llDecimatedFrames));
+    pCounters->framePoolDrops = static_cast<UINT64>(ReadCounter(&m_llFramePoolDrops));
+    pCounters->conversionFailures = static_cast<UINT64>(ReadCounter(&m_llConversionFailures));
+    pCounters->formatChanges = static_cast<UINT64>(ReadCounter(&m_llFormatChanges));
+    pCounters->reopens = (llOpens > 1) ? static_cast<UINT64>(llOpens - 1) : 0;
+    pCounters->bytesCopied = static_cast<UINT64>(ReadCounter(&m_llBytesCopied));
+    pCounters->dispatchAllocatedBytes = static_cast<UINT64>(ReadCounter(&m_llDispatchAllocatedBytes));
+    pCounters->queueDepth = (lQueueDepth > 0) ? static_cast<UINT32>(lQueueDepth) : 0;
+    pCounters->timeToFirstFrame = ReadCounter(&m_llTimeToFirstFrame);
+    pCounters->isNegotiationCached = m_lIsNegotiationCached != 0;
+}
+
+#pragma managed(pop)
@@ -0,0 +1,131 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CReaderCounters.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 02:14 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        // =======================================
+        // ====== READER_COUNTERS Structure ======
+        // =======================================
+
+        /// <summary>
+        /// Snapshot of the health counters of a reader.
+        /// </summary>
+        struct READER_COUNTERS
+        {
+            double  deliveredFramesPerSecond;   // Smoothed rate of the delivered frames.
+            UINT64  deliveredFrames;
+            UINT64  streamTicks;                // Gaps reported by the source, i.e. frames dropped by the device.
+            UINT64  backpressureDrops;          // Frames the device captured while no read was pending.
+            UINT64  staleDrops;                 // Samples dropped in low latency mode for waiting in the queue.
+            UINT64  decimatedFrames;            // Samples dropped by decimation before being processed.
+            UINT64  framePoolDrops;             // Samples dropped for having no free frame in the frame pool.
+            UINT64  conversionFailures;
+            UINT64  formatChanges;              // Media type changes of the source handled without reopening.
+            UINT64  reopens;
+            UINT64  bytesCopied;
+            UINT64  dispatchAllocatedBytes;     // Managed bytes allocated delivering the frames, excluding the event handlers.
+            UINT32  queueDepth;                 // Reads issued and not completed yet.
+            INT64   timeToFirstFrame;           // From the start of the last open to its first frame in 100-nanosecond units,
+                                                //  zero until the frame is delivered.
+            bool    isNegotiationCached;        // True if the last open used the negotiation cache.
+        };
+
+        // ==============================================
+        // ====== CReaderCounters Class Definition ======
+        // ==============================================
+
+        /// <summary>
+        /// Health counters of a reader, kept across reopening the reader.
+        /// The counters are updated with interlocked operations, so a snapshot can be taken
+        ///  from any thread without taking the reader's lock. The delivered frames are
+        ///  reported from a single thread at a time, the one holding the reader's lock.
+        /// Reference counted, as a native reader closed from its callbacks updates them
+        ///  after the consumer that created them may be finalized.
+        /// </summary>
+        class CReaderCounters
+        {
+            /* === Member Functions === */
+        public:
+            CReaderCounters();
+
+            CReaderCounters(const CReaderCounters &) = delete;
+            CReaderCounters &operator=(const CReaderCounters &) = delete;
+
+            ULONG AddRef();
+            ULONG Release();
+
+            void AddDeliveredFrame(UINT64 cbCopied);
+            void AddBytesCopied(UINT64 cbCopied) { InterlockedAdd64(&m_llBytesCopied, static_cast<LONG64>(cbCopied)); }
+            void AddStreamTick() { InterlockedIncrement64(&m_llStreamTicks); }
+            void AddBackpressureDrops(UINT64 drops) { InterlockedAdd64(&m_llBackpressureDrops, static_cast<LONG64>(drops)); }
+            void AddStaleDrop() { InterlockedIncrement64(&m_llStaleDrops); }
+            void AddDecimatedFrame() { InterlockedIncrement64(&m_llDecimatedFrames); }
+            void AddFramePoolDrop() { InterlockedIncrement64(&m_llFramePoolDrops); }
+            void AddConversionFailure() { InterlockedIncrement64(&m_llConversionFailures); }
+            void AddFormatChange() { InterlockedIncrement64(&m_llFormatChanges); }
+            void AddOpen() { InterlockedIncrement64(&m_llOpens); }
+            void AddDispatchAllocatedBytes(UINT64 cbAllocated) { InterlockedAdd64(&m_llDispatchAllocatedBytes, static_cast<LONG64>(cbAllocated)); }
+
+            void SetOpenStart(LONGLONG llOpenStartTime, bool bIsNegotiationCached);
+
+            void IncrementQueueDepth() { InterlockedIncrement(&m_lQueueDepth); }
+            void DecrementQueueDepth() { InterlockedDecrement(&m_lQueueDepth); }
+            void ResetQueueDepth() { InterlockedExchange(&m_lQueueDepth, 0); }
+
+            /// <summary>
+            /// Take a snapshot of the counters.
+            /// </summary>
+            void GetSnapshot(READER_COUNTERS *pCounters);
+
+        private:
+            ~CReaderCounters() = default;
+
+            /* === Data Members === */
+        private:
+            long                    m_nRefCount;            // Reference count, freed on the last release.
+
+            LONGLONG                m_llPerformanceFrequency;
+
+            volatile LONG64         m_llDeliveredFrames;
+            volatile LONG64         m_llLastDeliveryTime;       // Performance counter of the last delivered frame.
+            volatile LONG64         m_llFramesPerSecondBits;    // Smoothed frames per second, as the bits of a double.
+
+            volatile LONG64         m_llStreamTicks;
+            volatile LONG64         m_llBackpressureDrops;
+            volatile LONG64         m_llStaleDrops;
+            volatile LONG64         m_llDecimatedFrames;
+            volatile LONG64         m_llFramePoolDrops;
+            volatile LONG64         m_llConversionFailures;
+            volatile LONG64         m_llFormatChanges;
+            volatile LONG64         m_llOpens;
+            volatile LONG64         m_llBytesCopied;
+            volatile LONG64         m_llDispatchAllocatedBytes;
+
+            volatile LONG64         m_llOpenStartTime;          // Performance counter on starting the open, zero after its first frame.
+            volatile LONG64         m_llTimeToFirstFrame;
+            volatile LONG           m_lIsNegotiationCached;
+
+            volatile LONG           m_lQueueDepth;
+        };
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,695 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CResampler.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:34 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CResampler.h"
+
+// Fixed point precision of the filter weights.
+#define WEIGHT_BITS     14
+#define WEIGHT_ONE      (1 << WEIGHT_BITS)
+#define WEIGHT_ROUNDING (1 << (WEIGHT_BITS - 1))
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// ==============================
+// ====== Filter Functions ======
+// ==============================
+
+static double GetFilterRadius(RESAMPLE_FILTER filter)
+{
+    switch (filter)
+    {
+    case RESAMPLE_FILTER::BOX:
+        return 0.5;
+    case RESAMPLE_FILTER::BILINEAR:
+        return 1.0;
+    case RESAMPLE_FILTER::LANCZOS3:
+    default:
+        return 3.0;
+    }
+}
+
+static double Sinc(double x)
+{
+    constexpr double pi{ 3.14159265358979323846 };
+
+    if (x == 0.0) { return 1.0; }
+
+    x *= pi;
+    return std::sin(x) / x;
+}
+
+static double EvaluateFilter(RESAMPLE_FILTER filter, double x)
+{
+    switch (filter)
+    {
+    case RESAMPLE_FILTER::BOX:
+        return (x > -0.5 && x <= 0.5) ? 1.0 : 0.0;
+    case RESAMPLE_FILTER::BILINEAR:
+        x = std::abs(x);
+        return (x < 1.0) ? 1.0 - x : 0.0;
+    case RESAMPLE_FILTER::LANCZOS3:
+    default:
+        return (std::abs(x) < 3.0) ? Sinc(x) * Sinc(x / 3.0) : 0.0;
+    }
+}
+
+static inline BYTE ClampToByte(INT32 value)
+{
+    return static_cast<BYTE>((value < 0) ? 0 : ((value > 255) ? 255 : value));
+}
+
+// =====================================
+// ====== Horizontal Pass Kernels ======
+// =====================================
+
+// --------------------------------------------------------------------
+// ResampleRowHorizontalScalar
+// --------------------------------------------------------------------
+
+template <UINT32 channels>
+static void ResampleRowHorizontalScalar(
+    const BYTE *pbSource,
+    BYTE *pbDestination,
+    UINT32 destinationWidth,
+    UINT32 taps,
+    const UINT32 *pStarts,
+    const INT16 *pWeights
+    )
+{
+    for (UINT32 x = 0; x < destinationWidth; x++)
+    {
+        const BYTE *pbInput{ pbSource + static_cast<size_t>(pStarts[x]) * channels };
+        const INT16 *pWeight{ pWeights + static_cast<size_t>(x) * taps };
+
+        for (UINT32 c = 0; c < channels; c++)
+        {
+            INT32 accumulator{ WEIGHT_ROUNDING };
+            for (UINT32 t = 0; t < taps; t++)
+            {
+                accumulator += pbInput[t * channels + c] * pWeight[t];
+            }
+            pbDestination[x * channels + c] = ClampToByte(accumulator >> WEIGHT_BITS);
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// ResampleRowHorizontalBgraSse2
+//
+// The 4 channels of a pixel are in 4 32-bit lanes, two adjacent taps
+//  are interleaved as 16-bit pairs so `_mm_madd_epi16` applies both
+//  weights at once.
+// --------------------------------------------------------------------
+
+static void ResampleRowHorizontalBgraSse2(
+    const BYTE *pbSource,
+    BYTE *pbDestination,
+    UINT32 destinationWidth,
+    UINT32 taps,
+    const UINT32 *pStarts,
+    const INT16 *pWeights
+    )
+{
+    const __m128i zero{ _mm_setzero_si128() };
+    const __m128i rounding{ _mm_set1_epi32(WEIGHT_ROUNDING) };
+
+    for (UINT32 x = 0; x < destinationWidth; x++)
+    {
+        const BYTE *pbInput{ pbSource + static_cast<size_t>(pStarts[x]) * 4 };
+        const INT16 *pWeight{ pWeights + static_cast<size_t>(x) * taps };
+
+        __m128i accumulator{ rounding };
+
+        UINT32 t{ 0 };
+        for (; t + 1 < taps; t += 2)
+        {
+            // 8 bytes are two adjacent pixels, the taps are contiguous in the input.
+            __m128i pixels{ _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pbInput + t * 4)), zero) };
+            __m128i interleaved{ _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8)) };
+            __m128i weights{ _mm_set1_epi32(
+                static_cast<INT32>((static_cast<UINT32>(static_cast<UINT16>(pWeight[t + 1])) << 16) | static_cast<UINT16>(pWeight[t]))
+                ) };
+
+            accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(interleaved, weights));
+        }
+
+        if (t < taps)
+        {
+            INT32 pixel{ 0 };
+            std::memcpy(&pixel, pbInput + t * 4, sizeof(pixel));
+
+            __m128i pixels{ _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero) };
+            __m128i weights{ _mm_set1_epi32(static_cast<UINT16>(pWeight[t])) };
+
+            accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(pixels, weights));
+        }
+
+        accumulator = _mm_srai_epi32(accumulator, WEIGHT_BITS);
+        accumulator = _mm_packus_epi16(_mm_packs_epi32(accumulator, zero), zero);
+
+        INT32 result{ _mm_cvtsi128_si32(accumulator) };
+        std::memcpy(pbDestination + static_cast<size_t>(x) * 4, &result, sizeof(result));
+    }
+}
+
+// ===================================
+// ====== Vertical Pass Kernels ======
+// ===================================
+
+// --------------------------------------------------------------------
+// ResampleRowVerticalScalar
+// --------------------------------------------------------------------
+
+static void ResampleRowVerticalScalar(
+    const BYTE *pbRows,
+    size_t cbRowStride,
+    const INT16 *pWeights,
+    UINT32 taps,
+    BYTE *pbDestination,
+    size_t cbBegin,
+    size_t cbEnd
+    )
+{
+    for (size_t i = cbBegin; i < cbEnd; i++)
+    {
+        INT32 accumulator{ WEIGHT_ROUNDING };
+        for (UINT32 t = 0; t < taps; t++)
+        {
+            accumulator += pbRows[cbRowStride * t + i] * pWeights[t];
+        }
+        pbDestination[i] = ClampToByte(accumulator >> WEIGHT_BITS);
+    }
+}
+
+// --------------------------------------------------------------------
+// ResampleRowVerticalSse2
+//
+// All the bytes of a row share the same weights, two taps are
+//  interleaved as 16-bit pairs and multiplied with `_mm_madd_epi16`.
+// Starts at `cbBegin`, returns the end of the bytes processed.
+// --------------------------------------------------------------------
+
+static size_t ResampleRowVerticalSse2(
+    const BYTE *pbRows,
+    size_t cbRowStride,
+    const INT16 *pWeights,
+    UINT32 taps,
+    BYTE *pbDestination,
+    size_t cbBegin,
+    size_t cbEnd
+    )
+{
+    const __m128i zero{ _mm_setzero_si128() };
+    const __m128i rounding{ _mm_set1_epi32(WEIGHT_ROUNDING) };
+
+    size_t i{ cbBegin };
+    for (; i + 16 <= cbEnd; i += 16)
+    {
+        __m128i accumulator0{ rounding };
+        __m128i accumulator1{ rounding };
+        __m128i accumulator2{ rounding };
+        __m128i accumulator3{ rounding };
+
+        for (UINT32 t = 0; t < taps; t += 2)
+        {
+            const bool bHasPair{ t + 1 < taps };
+
+            __m128i rowA{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbRows + cbRowStride * t + i)) };
+            __m128i rowB{ bHasPair ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbRows + cbRowStride * (t + 1) + i)) : zero };
+            __m128i weights{ _mm_set1_epi32(
+                static_cast<INT32>(
+                    (static_cast<UINT32>(static_cast<UINT16>(bHasPair ? pWeights[t + 1] : 0)) << 16)
+                    | static_cast<UINT16>(pWeights[t]))
+                ) };
+
+            __m128i rowALow{ _mm_unpacklo_epi8(rowA, zero) };
+            __m128i rowAHigh{ _mm_unpackhi_epi8(rowA, zero) };
+            __m128i rowBLow{ _mm_unpacklo_epi8(rowB, zero) };
+            __m128i rowBHigh{ _mm_unpackhi_epi8(rowB, zero) };
+
+            accumulator0 = _mm_add_epi32(accumulator0, _mm_madd_epi16(_mm_unpacklo_epi16(rowALow, rowBLow), weights));
+            accumulator1 = _mm_add_epi32(accumulator1, _mm_madd_epi16(_mm_unpackhi_epi16(rowALow, rowBLow), weights));
+            accumulator2 = _mm_add_epi32(accumulator2, _mm_madd_epi16(_mm_unpacklo_epi16(rowAHigh, rowBHigh), weights));
+            accumulator3 = _mm_add_epi32(accumulator3, _mm_madd_epi16(_mm_unpackhi_epi16(rowAHigh, rowBHigh), weights));
+        }
+
+        __m128i low{ _mm_packs_epi32(_mm_srai_epi32(accumulator0, WEIGHT_BITS), _mm_srai_epi32(accumulator1, WEIGHT_BITS)) };
+        __m128i high{ _mm_packs_epi32(_mm_srai_epi32(accumulator2, WEIGHT_BITS), _mm_srai_epi32(accumulator3, WEIGHT_BITS)) };
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pbDestination + i), _mm_packus_epi16(low, high));
+    }
+
+    return i;
+}
+
+// --------------------------------------------------------------------
+// ResampleRowVerticalAvx2
+//
+// Same as the SSE2 kernel on 32 bytes. The unpack and pack
+//  instructions work within 128-bit lanes, and as both are applied
+//  symmetrically, the bytes end up in their original order.
+// --------------------------------------------------------------------
+
+static size_t ResampleRowVerticalAvx2(
+    const BYTE *pbRows,
+    size_t cbRowStride,
+    const INT16 *pWeights,
+    UINT32 taps,
+    BYTE *pbDestination,
+    size_t cbBegin,
+    size_t cbEnd
+    )
+{
+    const __m256i zero{ _mm256_setzero_si256() };
+    const __m256i rounding{ _mm256_set1_epi32(WEIGHT_ROUNDING) };
+
+    size_t i{ cbBegin };
+    for (; i + 32 <= cbEnd; i += 32)
+    {
+        __m256i accumulator0{ rounding };
+        __m256i accumulator1{ rounding };
+        __m256i accumulator2{ rounding };
+        __m256i accumulator3{ rounding };
+
+        for (UINT32 t = 0; t < taps; t += 2)
+        {
+            const bool bHasPair{ t + 1 < taps };
+
+            __m256i rowA{ _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pbRows + cbRowStride * t + i)) };
+            __m256i rowB{ bHasPair ? _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pbRows + cbRowStride * (t + 1) + i)) : zero };
+            __m256i weights{ _mm256_set1_epi32(
+                static_cast<INT32>(
+                    (static_cast<UINT32>(static_cast<UINT16>(bHasPair ? pWeights[t + 1] : 0)) << 16)
+                    | static_cast<UINT16>(pWeights[t]))
+                ) };
+
+            __m256i rowALow{ _mm256_unpacklo_epi8(rowA, zero) };
+            __m256i rowAHigh{ _mm256_unpackhi_epi8(rowA, zero) };
+            __m256i rowBLow{ _mm256_unpacklo_epi8(rowB, zero) };
+            __m256i rowBHigh{ _mm256_unpackhi_epi8(rowB, zero) };
+
+            accumulator0 = _mm256_add_epi32(accumulator0, _mm256_madd_epi16(_mm256_unpacklo_epi16(rowALow, rowBLow), weights));
+            accumulator1 = _mm256_add_epi32(accumulator1, _mm256_madd_epi16(_mm256_unpackhi_epi16(rowALow, rowBLow), weights));
+            accumulator2 = _mm256_add_epi32(accumulator2, _mm256_madd_epi16(_mm256_unpacklo_epi16(rowAHigh, rowBHigh), weights));
+            accumulator3 = _mm256_add_epi32(accumulator3, _mm256_madd_epi16(_mm256_unpackhi_epi16(rowAHigh, rowBHigh), weights));
+        }
+
+        __m256i low{ _mm256_packs_epi32(_mm256_srai_epi32(accumulator0, WEIGHT_BITS), _mm256_srai_epi32(accumulator1, WEIGHT_BITS)) };
+        __m256i high{ _mm256_packs_epi32(_mm256_srai_epi32(accumulator2, WEIGHT_BITS), _mm256_srai_epi32(accumulator3, WEIGHT_BITS)) };
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pbDestination + i), _mm256_packus_epi16(low, high));
+    }
+
+    return i;
+}
+
+// =====================================
+// ====== Scalar Reference Checks ======
+// =====================================
+
+// --------------------------------------------------------------------
+// GetIsMatchingScalarHorizontal
+//
+// Checks a row written by the SIMD kernel against the scalar kernel,
+//  which is the reference. Evaluated only within asserts.
+// --------------------------------------------------------------------
+
+static bool GetIsMatchingScalarHorizontal(
+    const BYTE *pbSource,
+    const BYTE *pbResult,
+    UINT32 destinationWidth,
+    UINT32 taps,
+    const UINT32 *pStarts,
+    const INT16 *pWeights
+    )
+{
+    std::vector<BYTE> reference(static_cast<size_t>(destinationWidth) * 4);
+    ResampleRowHorizontalScalar<4>(pbSource, reference.data(), destinationWidth, taps, pStarts, pWeights);
+
+    return std::memcmp(reference.data(), pbResult, reference.size()) == 0;
+}
+
+// --------------------------------------------------------------------
+// GetIsMatchingScalarVertical
+//
+// Same as the horizontal check, for the bytes [0, cbEnd) of a row.
+// --------------------------------------------------------------------
+
+static bool GetIsMatchingScalarVertical(
+    const BYTE *pbRows,
+    size_t cbRowStride,
+    const INT16 *pWeights,
+    UINT32 taps,
+    const BYTE *pbResult,
+    size_t cbEnd
+    )
+{
+    std::vector<BYTE> reference(cbEnd);
+    ResampleRowVerticalScalar(pbRows, cbRowStride, pWeights, taps, reference.data(), 0, cbEnd);
+
+    return std::memcmp(reference.data(), pbResult, cbEnd) == 0;
+}
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CResampler::CResampler() :
+    m_bIsConfigured{ false },
+    m_format{ PIXEL_FORMAT::BGRA32 },
+    m_planes{},
+    m_planeCount{ 0 }
+{
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// Configure
+// --------------------------------------------------------------------
+
+void CResampler::Configure(
+    PIXEL_FORMAT    format,
+    UINT32          sourceWidth,
+    UINT32          sourceHeight,
+    UINT32          destinationWidth,
+    UINT32          destinationHeight,
+    RESAMPLE_FILTER filter,
+    bool            bMirror
+    ) noexcept(false)
+{
+    m_bIsConfigured = false;
+
+    if (sourceWidth == 0 || sourceHeight == 0 || destinationWidth == 0 || destinationHeight == 0)
+    {
+        throw std::invalid_argument{ "Resampling dimensions can't be zero." };
+    }
+
+    if (filter == RESAMPLE_FILTER::BOX
+        && (sourceWidth < destinationWidth || sourceHeight < destinationHeight
+            || sourceWidth % destinationWidth != 0 || sourceHeight % destinationHeight != 0))
+    {
+        throw std::invalid_argument{ "Box filter supports only integer downscaling ratios." };
+    }
+
+    switch (format)
+    {
+    case PIXEL_FORMAT::BGRA32:
+        ConfigurePlane(m_planes[0], 4, sourceWidth, sourceHeight, destinationWidth, destinationHeight, filter, bMirror);
+        m_planeCount = 1;
+        break;
+
+    case PIXEL_FORMAT::GRAY8:
+        ConfigurePlane(m_planes[0], 1, sourceWidth, sourceHeight, destinationWidth, destinationHeight, filter, bMirror);
+        m_planeCount = 1;
+        break;
+
+    case PIXEL_FORMAT::NV12:
+        if ((sourceWidth | sourceHeight | destinationWidth | destinationHeight) & 1)
+        {
+            throw std::invalid_argument{ "NV12 dimensions have to be even." };
+        }
+
+        if (filter == RESAMPLE_FILTER::BOX
+            && ((sourceWidth / 2) % (destinationWidth / 2) != 0 || (sourceHeight / 2) % (destinationHeight / 2) != 0))
+        {
+            throw std::invalid_argument{ "Box filter supports only integer downscaling ratios for the chroma plane." };
+        }
+
+        ConfigurePlane(m_planes[0], 1, sourceWidth, sourceHeight, destinationWidth, destinationHeight, filter, bMirror);
+        ConfigurePlane(m_planes[1], 2, sourceWidth / 2, sourceHeight / 2, destinationWidth / 2, destinationHeight / 2, filter, bMirror);
+        m_planeCount = 2;
+        break;
+
+    default:
+        throw std::invalid_argument{ "Unsupported pixel format for resampling." };
+    }
+
+    m_format = format;
+    m_bIsConfigured = true;
+}
+
+// --------------------------------------------------------------------
+// Resample
+// --------------------------------------------------------------------
+
+void CResampler::Resample(const IMAGE_VIEW &source, const IMAGE_VIEW &destination)
+{
+    assert(m_bIsConfigured);
+
+    assert(source.format == m_format);
+    assert(destination.format == m_format);
+
+    for (UINT32 plane = 0; plane < m_planeCount; plane++)
+    {
+        ResampleHorizontal(
+            (plane == 0) ? source.pbScanline0 : source.pbChromaScanline0,
+            (plane == 0) ? source.lStride : source.lChromaStride,
+            plane,
+            0,
+            m_planes[plane].sourceHeight
+            );
+        ResampleVertical(
+            (plane == 0) ? destination.pbScanline0 : destination.pbChromaScanline0,
+            (plane == 0) ? destination.lStride : destination.lChromaStride,
+            plane,
+            0,
+            m_planes[plane].destinationHeight
+            );
+    }
+}
+
+// --------------------------------------------------------------------
+// ResampleHorizontal
+// --------------------------------------------------------------------
+
+void CResampler::ResampleHorizontal(const BYTE *pbSourceRow, LONG lSourceStride, UINT32 plane, UINT32 rowBegin, UINT32 rowEnd)
+{
+    assert(m_bIsConfigured);
+    assert(pbSourceRow != nullptr);
+    assert(plane < m_planeCount);
+
+    const PLANE &p{ m_planes[plane] };
+
+    assert(rowEnd <= p.sourceHeight);
+
+    for (UINT32 y = rowBegin; y < rowEnd; y++)
+    {
+        const BYTE *pbSource{ pbSourceRow + static_cast<LONG_PTR>(lSourceStride) * (y - rowBegin) };
+        BYTE *pbDestination{ p.intermediate.get() + p.cbIntermediateStride * y };
+
+        switch (p.channels)
+        {
+        case 4:
+            ResampleRowHorizontalBgraSse2(
+                pbSource, pbDestination, p.destinationWidth, p.horizontal.taps, p.horizontal.starts.get(), p.horizontal.weights.get());
+            assert(GetIsMatchingScalarHorizontal(
+                pbSource, pbDestination, p.destinationWidth, p.horizontal.taps, p.horizontal.starts.get(), p.horizontal.weights.get())
+                && "The SSE2 horizontal kernel differs from the scalar one.");
+            break;
+        case 2:
+            ResampleRowHorizontalScalar<2>(
+                pbSource, pbDestination, p.destinationWidth, p.horizontal.taps, p.horizontal.starts.get(), p.horizontal.weights.get());
+            break;
+        default:
+            ResampleRowHorizontalScalar<1>(
+                pbSource, pbDestination, p.destinationWidth, p.horizontal.taps, p.horizontal.starts.get(), p.horizontal.weights.get());
+            break;
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// ResampleVertical
+// --------------------------------------------------------------------
+
+void CResampler::ResampleVertical(BYTE *pbDestinationRow, LONG lDestinationStride, UINT32 plane, UINT32 rowBegin, UINT32 rowEnd)
+{
+    assert(m_bIsConfigured);
+    assert(pbDestinationRow != nullptr);
+    assert(plane < m_planeCount);
+
+    const PLANE &p{ m_planes[plane] };
+
+    assert(rowEnd <= p.destinationHeight);
+
+    const size_t cbRow{ static_cast<size_t>(p.destinationWidth) * p.channels };
+    const UINT32 taps{ p.vertical.taps };
+    const bool bUseAvx2{ GetIsAvx2Supported() };
+
+    for (UINT32 y = rowBegin; y < rowEnd; y++)
+    {
+        // The input rows of the taps are consecutive in the intermediate buffer
+        const BYTE *pbRows{ p.intermediate.get() + p.cbIntermediateStride * p.vertical.starts[y] };
+        const INT16 *pWeights{ p.vertical.weights.get() + static_cast<size_t>(y) * taps };
+
+        BYTE *pbDestination{ pbDestinationRow + static_cast<LONG_PTR>(lDestinationStride) * (y - rowBegin) };
+
+        size_t cbDone{ bUseAvx2 ? ResampleRowVerticalAvx2(pbRows, p.cbIntermediateStride, pWeights, taps, pbDestination, 0, cbRow) : 0 };
+        cbDone = ResampleRowVerticalSse2(pbRows, p.cbIntermediateStride, pWeights, taps, pbDestination, cbDone, cbRow);
+        ResampleRowVerticalScalar(pbRows, p.cbIntermediateStride, pWeights, taps, pbDestination, cbDone, cbRow);
+
+        assert(GetIsMatchingScalarVertical(pbRows, p.cbIntermediateStride, pWeights, taps, pbDestination, cbRow)
+            && "The SIMD vertical kernels differ from the scalar one.");
+    }
+}
+
+// ===============================
+// ====== Private Functions ======
+// ===============================
+
+// --------------------------------------------------------------------
+// ConfigurePlane [static]
+// --------------------------------------------------------------------
+
+void CResampler::ConfigurePlane(
+    PLANE           &plane,
+    UINT32          channels,
+    UINT32          sourceWidth,
+    UINT32          sourceHeight,
+    UINT32          destinationWidth,
+    UINT32          destinationHeight,
+    RESAMPLE_FILTER filter,
+    bool            bMirror
+    ) noexcept(false)
+{
+    ComputeAxisCoefficients(sourceWidth, destinationWidth, filter, bMirror, plane.horizontal);
+    ComputeAxisCoefficients(sourceHeight, destinationHeight, filter, false, plane.vertical);
+
+    plane.channels = channels;
+    plane.sourceWidth = sourceWidth;
+    plane.sourceHeight = sourceHeight;
+    plane.destinationWidth = destinationWidth;
+    plane.destinationHeight = destinationHeight;
+
+    // Round the intermediate rows up to a cache line
+    plane.cbIntermediateStride = ((static_cast<size_t>(destinationWidth) * channels) + 63) & ~static_cast<size_t>(63);
+    plane.intermediate = std::make_unique<BYTE[]>(plane.cbIntermediateStride * sourceHeight);
+}
+
+// --------------------------------------------------------------------
+// ComputeAxisCoefficients [static]
+//
+// For every output sample, the filter is centered on its position in
+//  the input, and stretched by the scale when downscaling so all the
+//  input samples contribute. The weights are normalized, converted
+//  to fixed point, and padded to the same number of taps. Windows are
+//  shifted inwards near the end so no tap reads past the input.
+// If reversed, output sample `x` takes the window of `outputSize - 1 - x`,
+//  which mirrors the output along the axis.
+// --------------------------------------------------------------------
+
+void CResampler::ComputeAxisCoefficients(
+    UINT32              inputSize,
+    UINT32              outputSize,
+    RESAMPLE_FILTER     filter,
+    bool                bReverse,
+    AXIS_COEFFICIENTS   &coefficients
+    ) noexcept(false)
+{
+    const double scale{ static_cast<double>(inputSize) / outputSize };
+    const double filterScale{ (std::max)(scale, 1.0) };
+    const double support{ GetFilterRadius(filter) * filterScale };
+    const UINT32 maxWindow{ static_cast<UINT32>(std::ceil(support)) * 2 + 1 };
+
+    auto windowStarts = std::make_unique<UINT32[]>(outputSize);
+    auto windowSizes = std::make_unique<UINT32[]>(outputSize);
+    auto windowWeights = std::make_unique<double[]>(static_cast<size_t>(outputSize) * maxWindow);
+
+    UINT32 taps{ 1 };
+
+    for (UINT32 x = 0; x < outputSize; x++)
+    {
+        const double center{ (x + 0.5) * scale };
+
+        INT64 first{ static_cast<INT64>(std::floor(center - support + 0.5)) };
+        INT64 last{ static_cast<INT64>(std::floor(center + support + 0.5)) };
+        first = (std::max)(first, static_cast<INT64>(0));
+        last = (std::min)(last, static_cast<INT64>(inputSize));
+
+        UINT32 size{ static_cast<UINT32>((std::min)((std::max)(last - first, static_cast<INT64>(0)), static_cast<INT64>(maxWindow))) };
+
+        double *pWeights{ windowWeights.get() + static_cast<size_t>(x) * maxWindow };
+        double sum{ 0.0 };
+
+        for (UINT32 i = 0; i < size; i++)
+        {
+            pWeights[i] = EvaluateFilter(filter, (i + first - center + 0.5) / filterScale);
+            sum += pWeights[i];
+        }
+
+        if (size == 0 || sum == 0.0)
+        {
+            // Fall back to the nearest input sample
+            first = (std::min)(static_cast<INT64>(center), static_cast<INT64>(inputSize) - 1);
+            size = 1;
+            pWeights[0] = 1.0;
+            sum = 1.0;
+        }
+
+        for (UINT32 i = 0; i < size; i++)
+        {
+            pWeights[i] /= sum;
+        }
+
+        windowStarts[x] = static_cast<UINT32>(first);
+        windowSizes[x] = size;
+        taps = (std::max)(taps, size);
+    }
+
+    coefficients.taps = taps;
+    coefficients.starts = std::make_unique<UINT32[]>(outputSize);
+    coefficients.weights = std::make_unique<INT16[]>(static_cast<size_t>(outputSize) * taps); // Zero initialized.
+
+    for (UINT32 x = 0; x < outputSize; x++)
+    {
+        UINT32 start{ windowStarts[x] };
+        UINT32 offset{ 0 };
+
+        // Every window lies within the input, so `taps` can't exceed the input size.
+        if (start + taps > inputSize)
+        {
+            offset = start + taps - inputSize;
+            start -= offset;
+        }
+
+        const UINT32 outputIndex{ bReverse ? outputSize - 1 - x : x };
+
+        INT16 *pWeights{ coefficients.weights.get() + static_cast<size_t>(outputIndex) * taps + offset };
+        const double *pWindowWeights{ windowWeights.get() + static_cast<size_t>(x) * maxWindow };
+
+        INT32 sum{ 0 };
+        UINT32 largest{ 0 };
+
+        for (UINT32 i = 0; i < windowSizes[x]; i++)
+        {
+            pWeights[i] = static_cast<INT16>(std::lround(pWindowWeights[i] * WEIGHT_ONE));
+            sum += pWeights[i];
+
+            if (pWeights[i] > pWeights[largest]) { largest = i; }
+        }
+
+        // Put the rounding error on the largest weight so a flat input stays flat.
+        pWeights[largest] = static_cast<INT16>(pWeights[largest] + (WEIGHT_ONE - sum));
+
+        coefficients.starts[outputIndex] = start;
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,153 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CResampler.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:20 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        /// <summary>
+        /// Filters available for resampling.
+        /// </summary>
+        enum class RESAMPLE_FILTER
+        {
+            BOX,        // Area average, only for integer downscaling ratios.
+            BILINEAR,   // Triangle filter, widened when downscaling.
+            LANCZOS3    // Windowed sinc with 3 lobes, widened when downscaling.
+        };
+
+        // =========================================
+        // ====== CResampler Class Definition ======
+        // =========================================
+
+        /// <summary>
+        /// Separable image resampler for BGRA32, GRAY8, and NV12 images.
+        /// </summary>
+        /// <remarks>
+        /// Filter coefficients and the intermediate buffer are computed once on `Configure`,
+        ///  so resampling a frame doesn't allocate. Mirroring is folded into the horizontal coefficients
+        ///  so it costs nothing extra.
+        /// Each plane is resampled horizontally first, for all the source rows into an intermediate buffer,
+        ///  then vertically into the destination. The passes are exposed separately per plane and row range
+        ///  so the rows can be split across threads, as long as the horizontal pass of a plane
+        ///  completes before its vertical pass starts.
+        /// </remarks>
+        class CResampler
+        {
+            /* === Member Functions === */
+        public:
+            CResampler();
+
+            /// <summary>
+            /// Configure the resampler, throws `std::invalid_argument` on unsupported combination.
+            /// </summary>
+            void Configure(
+                PIXEL_FORMAT    format,
+                UINT32          sourceWidth,
+                UINT32          sourceHeight,
+                UINT32          destinationWidth,
+                UINT32          destinationHeight,
+                RESAMPLE_FILTER filter,
+                bool            bMirror = false
+                ) noexcept(false);
+
+            /// <summary>
+            /// Resample the whole source image into the destination image.
+            /// </summary>
+            void Resample(const IMAGE_VIEW &source, const IMAGE_VIEW &destination);
+
+            /// <summary>
+            /// Horizontal pass for the source rows [rowBegin, rowEnd) of the plane,
+            ///  `pbSourceRow` points to the row `rowBegin`.
+            /// </summary>
+            void ResampleHorizontal(const BYTE *pbSourceRow, LONG lSourceStride, UINT32 plane, UINT32 rowBegin, UINT32 rowEnd);
+
+            /// <summary>
+            /// Vertical pass for the destination rows [rowBegin, rowEnd) of the plane,
+            ///  `pbDestinationRow` points to where the row `rowBegin` is written.
+            /// </summary>
+            void ResampleVertical(BYTE *pbDestinationRow, LONG lDestinationStride, UINT32 plane, UINT32 rowBegin, UINT32 rowEnd);
+
+            /// <summary>
+            /// Stop resampling until configured again, the memory is kept for the next configuration.
+            /// </summary>
+            void Reset() { m_bIsConfigured = false; }
+
+            bool GetIsConfigured() const { return m_bIsConfigured; }
+            UINT32 GetPlaneCount() const { return m_planeCount; }
+            UINT32 GetPlaneSourceHeight(UINT32 plane) const { return m_planes[plane].sourceHeight; }
+            UINT32 GetPlaneDestinationHeight(UINT32 plane) const { return m_planes[plane].destinationHeight; }
+
+        private:
+            /// <summary>
+            /// Fixed point filter coefficients for one axis.
+            /// </summary>
+            struct AXIS_COEFFICIENTS
+            {
+                UINT32                      taps;       // Weights per output sample, padded with zeros.
+                std::unique_ptr<UINT32[]>   starts;     // First input sample per output sample,
+                                                        //  `start + taps` never exceeds the input size.
+                std::unique_ptr<INT16[]>    weights;    // `taps` weights per output sample.
+            };
+
+            struct PLANE
+            {
+                UINT32                  channels;
+                UINT32                  sourceWidth;
+                UINT32                  sourceHeight;
+                UINT32                  destinationWidth;
+                UINT32                  destinationHeight;
+
+                AXIS_COEFFICIENTS       horizontal;
+                AXIS_COEFFICIENTS       vertical;
+
+                std::unique_ptr<BYTE[]> intermediate;       // destinationWidth x sourceHeight.
+                size_t                  cbIntermediateStride;
+            };
+
+            static void ConfigurePlane(
+                PLANE           &plane,
+                UINT32          channels,
+                UINT32          sourceWidth,
+                UINT32          sourceHeight,
+                UINT32          destinationWidth,
+                UINT32          destinationHeight,
+                RESAMPLE_FILTER filter,
+                bool            bMirror
+                ) noexcept(false);
+
+            static void ComputeAxisCoefficients(
+                UINT32              inputSize,
+                UINT32              outputSize,
+                RESAMPLE_FILTER     filter,
+                bool                bReverse,
+                AXIS_COEFFICIENTS   &coefficients
+                ) noexcept(false);
+
+            /* === Data Members === */
+        private:
+            bool            m_bIsConfigured;
+            PIXEL_FORMAT    m_format;
+
+            PLANE           m_planes[2];    // Y and UV for NV12, only the first is used otherwise.
+            UINT32          m_planeCount;
+        };
+    }
+}
+
+#pragma managed(pop)
@@ -16,7 +16,35 @@
 #include "CSourceReader.h"
 
 #define OUTPUT_VIDEO_SUBTYPE MFVideoFormat_RGB32
-#define OUTPUT_BYTES_PER_PIXEL 4
+
+// Rows written per band, the statistics and the transpose work on a band while it is still in cache.
+#define OUTPUT_BAND_ROWS 16
+
+// Pixels per write task. The threshold is an estimate that hasn't been measured, it only keeps
+//  small frames on the calling thread, and has to be tuned on the target machines.
+#define MIN_PIXELS_PER_WRITE_TASK (256 * 1024)
+
+// Frame bytes from which a plain copy into a caller destination is written with non-temporal stores, about
+//  the size of a shared L3 cache. Streaming is slower than a cached copy for its own sake, it pays off only
+//  when the frame would evict the whole cache the capture thread works on, e.g. 4K BGRA frames, and nothing
+//  reads it back right away. The reader's own buffers are copied again for the consumer, so they aren't streamed.
+#define MIN_BYTES_FOR_STREAM_COPY (16 * 1024 * 1024)
+
+// Max frame age in low latency mode if none is requested and the frame rate of the device is unknown,
+//  a frame at 30 fps in 100-nanosecond units.
+#define DEFAULT_MAX_FRAME_AGE 333333
+
+// Stale samples dropped in a row before their latency is taken as the lowest latency, so a read
+//  still completes with the next fresh sample if the latency of the device rises and stays high.
+#define MAX_CONSECUTIVE_STALE_SAMPLES 8
+
+// Failed reads in a row in latest frame mode before the reader is lost, so the source is
+//  read again through transient failures, and a source that keeps failing is reconnected.
+#define MAX_CONSECUTIVE_LATEST_READ_FAILURES 8
+
+// Alignment of the rows of the reader's own frame buffers, a cache line, so no row shares
+//  a line with the next one and the bands written in parallel never write to the same line.
+#define FRAME_STRIDE_ALIGNMENT 64
 
 #pragma managed(push, off)
 
@@ -66,14 +94,25 @@ HRESULT CSourceReader::QueryInterface(REFIID riid, void **ppv)
 HRESULT CSourceReader::OnReadSample(
     HRESULT hrStatus,
     DWORD /*dwStreamIndex*/,
-    DWORD /*dwStreamFlags*/,
-    LONGLONG /*llTimestamp*/,
+    DWORD dwStreamFlags,
+    LONGLONG llTimestamp,
     IMFSample *pSample
     )
 {
     HRESULT hr{ hrStatus };
 
+    // The status as passed by the source, before any injected fault
+    const HRESULT hrSourceStatus{ hrStatus };
+
+    // The error string is built from where the failure occurred only if it is passed on,
+    //  so a failing device doesn't build strings for every sample. Rare failures set it directly.
     std::string exWhatString{};
+    const char *pszExWhat{ nullptr };
+    const char *pszInnerExWhat{ nullptr };
+
+    FRAME_METADATA metadata{};
+    metadata.llTimestamp = llTimestamp;
+    metadata.llLatency = pSample ? GetSampleLatency(pSample) : -1;
 
     IMFSample       *pOutputSample{ nullptr };
     IMFMediaBuffer  *pBuffer{ nullptr };
@@ -81,62 +120,291 @@ HRESULT CSourceReader::OnReadSample(
     BYTE *pbScanline0{ nullptr };
     LONG lStride{ 0 };
 
-    _RPT1(_CRT_WARN, "Waiting to enter critical section from %s.\n", STRINGIZE(OnReadSample));
+    IMAGE_VIEW destination{};
+    BYTE *pbFrameScanline0{ nullptr };
+    LONG lFrameStride{ 0 };
+
+    IMAGE_VIEW frameView{};
+
+    LONGLONG llReconfigurationTime{ 0 };
+    bool bIsReconfigurationFailed{ false };
+
+    CTraceSpan span{ "OnReadSample", this };
 
-    EnterCriticalSection(&m_criticalSection);
+    // Nothing is touched once the reader is lost or closed, checked without the lock
+    if (GetState() != READER_STATE::AVAILABLE) { return hr; }
 
-    _RPT1(_CRT_WARN, "Entered critical section in %s.\n", STRINGIZE(OnReadSample));
+    // Injected faults hit the sample as if the source failed it or changed its type, before anything
+    //  else sees it. They are injected before taking the lock, so the delay is a slow source
+    //  and doesn't hold back reconfiguring, reconnecting and closing.
+    if (m_lFailEveryNthSample > 0 || m_lChangeFormatEveryNthSample > 0 || m_lSampleDelayMs > 0)
+    {
+        InjectSampleFaults(&hrStatus, &dwStreamFlags);
+        hr = hrStatus;
+    }
 
-    // Check if the CSourceReader has been closed before entering the critical section.
-    if (!m_bIsAvailable)
+    EnterCallback();
+
+    // Check if the reader was lost or closed while waiting for the lock
+    if (GetState() != READER_STATE::AVAILABLE)
     {
-        LeaveCriticalSection(&m_criticalSection);
-        _RPT1(_CRT_WARN, "CSourceReader isn't available during '%s', left critical section and returning.\n", STRINGIZE(OnReadSample));
+        LeaveCallback();
         return hr;
     }
 
+    // The frames are reconfigured for a new type before the sample can be decimated or dropped,
+    //  so no sample of the new type is written with the previous configuration. The native type
+    //  is read as is, so a change of the native type is a change of the current type too.
+    //  Reconfiguring replaces the buffers, so the lock is taken exclusively for it. A failure
+    //  injected into the same sample doesn't skip it, as the type has changed all the same,
+    //  and is passed on after it unless reconfiguring fails too.
+    if ((dwStreamFlags & (MF_SOURCE_READERF_CURRENTMEDIATYPECHANGED | MF_SOURCE_READERF_NATIVEMEDIATYPECHANGED)) != 0
+        && SUCCEEDED(hrSourceStatus))
+    {
+        ReleaseSRWLockShared(&m_srwLock);
+
+        {
+            CTraceSpan waitSpan{ "ExclusiveLockWait", this };
+            AcquireSRWLockExclusive(&m_srwLock);
+        }
+
+        if (GetState() == READER_STATE::AVAILABLE)
+        {
+            try
+            {
+                ReconfigureForCurrentMediaType(&llReconfigurationTime);
+            }
+            catch (const std::system_error &ex)
+            {
+                hr = ex.code().value();
+
+                exWhatString = std::string{ MAKE_EX_STR("Error occurred while reconfiguring for the new media type.") }
+                    + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+
+                bIsReconfigurationFailed = true;
+
+                // The frames are left partly configured, so the reader is unavailable until it is reopened
+                TransitionState(READER_STATE::AVAILABLE, READER_STATE::LOST);
+            }
+        }
+
+        ReleaseSRWLockExclusive(&m_srwLock);
+
+        {
+            CTraceSpan waitSpan{ "SharedLockWait", this };
+            AcquireSRWLockShared(&m_srwLock);
+        }
+
+        // Check if the reader was lost or closed while the lock was released, the failure is still passed on
+        if (GetState() != READER_STATE::AVAILABLE && !bIsReconfigurationFailed)
+        {
+            LeaveCallback();
+            return hr;
+        }
+
+        if (!bIsReconfigurationFailed && m_pFormatChangedCallback)
+        {
+            m_pFormatChangedCallback(m_frameWidth, m_frameHeight, llReconfigurationTime);
+        }
+    }
+
+    // A decimated sample is dropped before being processed, and the next one is read
+    //  for the same pending read, so its destination stays queued.
+    if ((m_frameDecimation > 1 || m_llMinFrameInterval > 0) && SUCCEEDED(hr) && pSample
+        && GetIsSampleDecimated(llTimestamp)
+        && SUCCEEDED(m_pSourceReader->ReadSample(static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM), 0, nullptr, nullptr, nullptr, nullptr)))
+    {
+        // The decimated sample isn't a gap for the backpressure count
+        m_llLastSampleTime = llTimestamp;
+
+        if (m_pCounters) { m_pCounters->AddDecimatedFrame(); }
+
+        LeaveCallback();
+
+        return S_OK;
+    }
+
+    // In low latency mode, a sample that waited in the queue of the source is dropped
+    //  and a newer one is read for the same pending read, so its destination stays queued.
+    if (m_bLowLatency && SUCCEEDED(hr) && metadata.llLatency >= 0)
+    {
+        if (m_llMinLatency < 0 || metadata.llLatency < m_llMinLatency)
+        {
+            m_llMinLatency = metadata.llLatency;
+        }
+
+        if (metadata.llLatency - m_llMinLatency > m_llMaxFrameAge
+            && SUCCEEDED(m_pSourceReader->ReadSample(static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM), 0, nullptr, nullptr, nullptr, nullptr)))
+        {
+            // A latency that stays high is the lowest latency the device has now, not a queue,
+            //  so the next samples are aged from it instead of delivering a stale one
+            if (++m_staleSamplesCount >= MAX_CONSECUTIVE_STALE_SAMPLES)
+            {
+                m_llMinLatency = metadata.llLatency;
+                m_staleSamplesCount = 0;
+            }
+
+            // The dropped sample isn't a gap for the backpressure count
+            m_llLastSampleTime = llTimestamp;
+
+            if (m_pCounters) { m_pCounters->AddStaleDrop(); }
+
+            LeaveCallback();
+
+            return S_OK;
+        }
+
+        m_staleSamplesCount = 0;
+    }
+
+    // Take the destination of the read this callback is for
+    if (m_pendingReads.TryPop(&destination))
+    {
+        if (m_pCounters) { m_pCounters->DecrementQueueDepth(); }
+    }
+
+    if (destination.pbScanline0)
+    {
+        metadata.pDestination = &destination;
+        pbFrameScanline0 = destination.pbScanline0;
+        lFrameStride = destination.lStride;
+    }
+    else if (m_bPublishLatestFrame)
+    {
+        pbFrameScanline0 = m_latestFrames.GetBackBuffer();
+        lFrameStride = GetFrameStride();
+    }
+    else
+    {
+        pbFrameScanline0 = m_frameBuffer.get();
+        lFrameStride = GetFrameStride();
+    }
+
+    // The failed reconfiguration has its own error string
+    if (bIsReconfigurationFailed) { goto done; }
+
     // Check if hr is failed
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error passed from IMFSourceReader.");
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error passed from IMFSourceReader.");
+
+    // Reads issued before the type changed may have destinations for the previous frame size
+    if (destination.pbScanline0
+        && (destination.widthInPixels != m_frameWidth || destination.heightInPixels != m_frameHeight))
+    {
+        hr = MF_E_INVALIDMEDIATYPE;
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "The destination of the read doesn't match the frame size after the media type changed.");
+    }
+
+    // A stream tick marks a gap in the stream the source knows about,
+    //  the gap isn't counted again from the timestamps.
+    if ((dwStreamFlags & MF_SOURCE_READERF_STREAMTICK) == MF_SOURCE_READERF_STREAMTICK)
+    {
+        m_llLastSampleTime = -1;
+
+        if (m_pCounters) { m_pCounters->AddStreamTick(); }
+    }
 
     // Read from the sample if available
     if (pSample)
     {
-        // Convert the buffer to RGB32
-        try
+        if (m_outputFormat == PIXEL_FORMAT::GRAY8)
         {
-            ProcessorProcessSample(0, pSample, &pOutputSample);
+            // The luma is read from the native sample as is
+            pOutputSample = pSample;
+            pOutputSample->AddRef();
         }
-        catch (const std::system_error &ex)
+        else
         {
-            hr = ex.code().value();
+            // Convert the buffer to RGB32
+            hr = ProcessorProcessSample(0, pSample, &pOutputSample, &pszInnerExWhat);
+            if (FAILED(hr))
+            {
+                pszExWhat = MAKE_EX_STR("Error occurred while processing sample.");
 
-            exWhatString = std::string{ MAKE_EX_STR("Error occurred while processing sample.") }
-                + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+                if (m_pCounters) { m_pCounters->AddConversionFailure(); }
 
-            goto done;
+                goto done;
+            }
+        }
+
+        // Frames the device captured between the two samples while no read was pending
+        if (m_llFrameDuration > 0 && m_llLastSampleTime >= 0 && llTimestamp > m_llLastSampleTime && m_pCounters)
+        {
+            const LONGLONG llFrames{ (llTimestamp - m_llLastSampleTime + m_llFrameDuration / 2) / m_llFrameDuration };
+            if (llFrames > 1)
+            {
+                m_pCounters->AddBackpressureDrops(static_cast<UINT64>(llFrames - 1));
+            }
         }
+        m_llLastSampleTime = llTimestamp;
 
         // Get the buffer for the frame from the sample if the buffer is set
         if (pOutputSample)
         {
             hr = pOutputSample->GetBufferByIndex(0, &pBuffer);
-            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFSample::GetBufferByIndex().");
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFSample::GetBufferByIndex().");
 
             // Lock the buffer
             CBufferLock buffer{ pBuffer };
-            hr = buffer.LockBuffer(m_lSrcDefaultStride, m_frameHeight, &pbScanline0, &lStride);
-            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during locking buffer.");
+            hr = buffer.LockBuffer(m_lSrcDefaultStride, m_sourceHeight, &pbScanline0, &lStride);
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during locking buffer.");
+
+            // The locked buffer is the frame as is, so it is passed before being unlocked instead of being copied
+            if (GetIsZeroCopySample(metadata))
+            {
+                frameView = IMAGE_VIEW{ pbScanline0, lStride, nullptr, 0, m_frameWidth, m_frameHeight, m_outputFormat };
+
+                metadata.pView = &frameView;
+                metadata.bIsZeroCopy = true;
+                metadata.bIsWritten = true;
+
+                if (m_pCounters) { m_pCounters->AddDeliveredFrame(0); }
+
+                if (m_pReadSampleSuccessCallback)
+                {
+                    m_pReadSampleSuccessCallback(pbScanline0, m_frameWidth, m_frameHeight, GetBytesPerPixel(m_outputFormat), &metadata);
+                }
+
+                goto done;
+            }
 
             // Copy the frame
-            // Note that here we are multiplying with 4 as we are using RGB32 (4 byte) format
-            hr = MFCopyImage(m_frameBuffer.get(), m_frameWidth, pbScanline0, lStride, m_frameWidth * OUTPUT_BYTES_PER_PIXEL, m_frameHeight);
-            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCopyImage().");
+            hr = (m_outputFormat == PIXEL_FORMAT::GRAY8)
+                ? WriteLumaFrame(pbScanline0, lStride, pbFrameScanline0, lFrameStride, &metadata)
+                : WriteOutputFrame(pbScanline0, lStride, pbFrameScanline0, lFrameStride, &metadata);
+            if (FAILED(hr) && m_pCounters) { m_pCounters->AddConversionFailure(); }
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred while writing the output frame.");
+
+            // The tensor is read from the native sample rather than from the frame
+            if (m_tensorWriter.GetIsYuvSource())
+            {
+                hr = WriteTensorFromSample(pSample, &metadata);
+                if (FAILED(hr) && m_pCounters) { m_pCounters->AddConversionFailure(); }
+                CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred while reading the tensor from the native sample.");
+            }
+
+            metadata.bIsWritten = true;
+
+            if (m_pCounters)
+            {
+                m_pCounters->AddDeliveredFrame(static_cast<UINT64>(m_frameWidth) * m_frameHeight * GetBytesPerPixel(m_outputFormat));
+            }
         }
     }
 
-    if (m_pReadSampleSuccessCallback)
+    if (m_bPublishLatestFrame)
+    {
+        // The consumer takes the frames from the triple buffer, so the success callback isn't called
+        if (metadata.bIsWritten)
+        {
+            m_latestFrames.Publish(llTimestamp);
+        }
+    }
+    else if (m_pReadSampleSuccessCallback)
     {
-        m_pReadSampleSuccessCallback(m_frameBuffer.get(), m_frameWidth, m_frameHeight, OUTPUT_BYTES_PER_PIXEL);
+        frameView = IMAGE_VIEW{ pbFrameScanline0, lFrameStride, nullptr, 0, m_frameWidth, m_frameHeight, m_outputFormat };
+        metadata.pView = &frameView;
+
+        m_pReadSampleSuccessCallback(pbFrameScanline0, m_frameWidth, m_frameHeight, GetBytesPerPixel(m_outputFormat), &metadata);
     }
 
 done:
@@ -147,13 +415,41 @@ HRESULT CSourceReader::OnReadSample(
     {
         if (m_pReadSampleFailCallback)
         {
+            if (pszExWhat)
+            {
+                exWhatString = pszExWhat;
+
+                if (pszInnerExWhat)
+                {
+                    exWhatString = exWhatString + "\nWith Error: " + pszInnerExWhat + " (" + std::to_string(hr) + ")";
+                }
+            }
+
             m_pReadSampleFailCallback(hr, exWhatString);
         }
     }
 
-    LeaveCriticalSection(&m_criticalSection);
+    // Keep the next frame coming unless the reader was lost. Nothing else issues the reads in this
+    //  mode, so a source that keeps failing, or a read that can't be issued, loses the reader,
+    //  leaving the recovery to reconnecting or reopening instead of stopping the frames silently.
+    if (m_bPublishLatestFrame && GetState() == READER_STATE::AVAILABLE)
+    {
+        m_latestReadFailuresCount = SUCCEEDED(hrStatus) ? 0 : m_latestReadFailuresCount + 1;
+
+        if (m_latestReadFailuresCount >= MAX_CONSECUTIVE_LATEST_READ_FAILURES
+            || FAILED(IssueLatestFrameRead()))
+        {
+            LARGE_INTEGER now{};
+            QueryPerformanceCounter(&now);
+
+            if (TransitionState(READER_STATE::AVAILABLE, READER_STATE::LOST))
+            {
+                InterlockedExchange64(&m_llDeviceLostTime, now.QuadPart);
+            }
+        }
+    }
 
-    _RPT1(_CRT_WARN, "Left critical section in %s.\n", STRINGIZE(OnReadSample));
+    LeaveCallback();
 
     return hr;
 }
@@ -164,25 +460,90 @@ HRESULT CSourceReader::OnReadSample(
 
 CSourceReader::CSourceReader() :
     m_nRefCount{ 1 },
-    m_criticalSection{},
-    m_bIsInitialized{ false },
-    m_bIsAvailable{ false },
+    m_srwLock{},
+    m_lState{ static_cast<LONG>(READER_STATE::UNINITIALIZED) },
+    m_dwCallbackThreadId{ 0 },
+    m_srwCallbackLock{},
+    m_lIsCloseDeferred{ FALSE },
     m_pMediaSource{ nullptr },
     m_pSourceReader{ nullptr },
     m_pProcessor{ nullptr },
+    m_pProcessorOutputBuffer{ nullptr },
+    m_pNativeMediaType{ nullptr },
+    m_outputFormat{ PIXEL_FORMAT::BGRA32 },
+    m_nativeSubtype{ GUID_NULL },
     m_lSrcDefaultStride{ 0 },
+    m_lNativeDefaultStride{ 0 },
+    m_nativeHeight{ 0 },
+    m_llFrameDuration{ 0 },
+    m_llLastSampleTime{ -1 },
+    m_sourceWidth{ 0 },
+    m_sourceHeight{ 0 },
+    m_scaledWidth{ 0 },
+    m_scaledHeight{ 0 },
     m_frameWidth{ 0 },
     m_frameHeight{ 0 },
     m_frameBuffer{ nullptr },
+    m_lumaBuffer{ nullptr },
+    m_pendingReads{},
+    m_srwIssueLock{},
+    m_requestedOutputWidth{ 0 },
+    m_requestedOutputHeight{ 0 },
+    m_resampleFilter{ RESAMPLE_FILTER::BILINEAR },
+    m_resampler{},
+    m_rotation{ ROTATION::NONE },
+    m_bMirror{ false },
+    m_bFlipVertical{ false },
+    m_bTranspose{ false },
+    m_bMirrorRows{ false },
+    m_bReverseSourceRows{ false },
+    m_bReverseDestinationRows{ false },
+    m_writeTasks{ nullptr },
+    m_writeTasksCount{ 0 },
+    m_writeFrame{},
+    m_pWorkerPool{ nullptr },
+    m_lComputeFrameStatistics{ FALSE },
+    m_frameStatistics{},
+    m_bWriteTensor{ false },
+    m_tensorFormat{},
+    m_tensorWriter{},
+    m_frameDecimation{ 0 },
+    m_llMinFrameInterval{ 0 },
+    m_decimationCounter{ 0 },
+    m_llNextDeliveryTime{ -1 },
+    m_bPublishLatestFrame{ false },
+    m_latestFrames{},
+    m_lIsTakingLatestFrame{ FALSE },
+    m_latestReadFailuresCount{ 0 },
+    m_bZeroCopy{ false },
+    m_bLowLatency{ false },
+    m_llRequestedMaxFrameAge{ 0 },
+    m_llMaxFrameAge{ 0 },
+    m_llMinLatency{ -1 },
+    m_staleSamplesCount{ 0 },
+    m_bUseNegotiationCache{ true },
+    m_lAutoReconnect{ FALSE },
+    m_lIsReconnectScheduled{ FALSE },
+    m_llDeviceLostTime{ 0 },
+    m_lFailEveryNthSample{ 0 },
+    m_lFaultHResult{ S_OK },
+    m_lChangeFormatEveryNthSample{ 0 },
+    m_lSampleDelayMs{ 0 },
+    m_llFaultSamplesCount{ 0 },
+    m_pCounters{ nullptr },
     m_wstrDeviceSymbolicLink{},
     m_pReadSampleSuccessCallback{ nullptr },
     m_pReadSampleFailCallback{ nullptr },
+    m_pDeviceReconnectedCallback{ nullptr },
+    m_pFormatChangedCallback{ nullptr },
     m_pDeviceChangeNotifHandler{ nullptr }
 {
-    InitializeCriticalSection(&m_criticalSection);
+    InitializeSRWLock(&m_srwLock);
+    InitializeSRWLock(&m_srwIssueLock);
+    InitializeSRWLock(&m_srwCallbackLock);
 
     // Set device change notification handler
-    m_pDeviceChangeNotifHandler = [this] { CaptureDeviceChangeNotificationHandler(); };
+    m_pDeviceChangeNotifHandler = [this](bool bIsArrival) { CaptureDeviceChangeNotificationHandler(bIsArrival); };
 }
 
 // ========================
@@ -196,7 +557,7 @@ CSourceReader::~CSourceReader()
     // Remove the device change notification handler
     RemoveCaptureDeviceChangeNotificationHandler(m_wstrDeviceSymbolicLink, &m_pDeviceChangeNotifHandler);
 
-    DeleteCriticalSection(&m_criticalSection);
+    SafeRelease(&m_pCounters);
 
     _RPT0(_CRT_WARN, "CSourceReader destructor has been called.\n");
 }
@@ -207,15 +568,42 @@ CSourceReader::~CSourceReader()
 
 // --------------------------------------------------------------------
 // FreeResources
+//
+// The reader is closed before waiting for the lock, so the callbacks
+//  waiting behind it return early. The lock isn't reentrant, so on the
+//  callback thread the resources are freed once the sample is handled.
+//  The media source is shut down there at once, releasing the device,
+//  so a reader reopened from the handlers can open it.
 // --------------------------------------------------------------------
 
 void CSourceReader::FreeResources()
 {
-    _RPT1(_CRT_WARN, "Waiting to enter critical section from %s.\n", STRINGIZE(FreeResources));
+    CTraceSpan span{ "FreeResources", this };
+
+    // A reader that failed to initialize is still uninitialized
+    if (GetState() != READER_STATE::UNINITIALIZED)
+    {
+        SetState(READER_STATE::CLOSED);
+    }
+
+    if (GetIsCallbackThread())
+    {
+        // Safe under the shared lock the callback holds, as the media source is free-threaded
+        //  and nothing replaces it meanwhile. The interfaces are released once the lock is free,
+        //  as reads issued on other threads may still be using them.
+        if (m_pMediaSource)
+        {
+            m_pMediaSource->Shutdown();
+        }
 
-    EnterCriticalSection(&m_criticalSection);
+        InterlockedExchange(&m_lIsCloseDeferred, TRUE);
+        return;
+    }
 
-    _RPT1(_CRT_WARN, "Entered critical section in %s.\n", STRINGIZE(FreeResources));
+    {
+        CTraceSpan waitSpan{ "ExclusiveLockWait", this };
+        AcquireSRWLockExclusive(&m_srwLock);
+    }
 
     // Shutdown the media source before releasing
     if (m_pMediaSource)
@@ -224,280 +612,2012 @@ void CSourceReader::FreeResources()
     }
 
     SafeRelease(&m_pProcessor);
+    SafeRelease(&m_pProcessorOutputBuffer);
+    SafeRelease(&m_pNativeMediaType);
     SafeRelease(&m_pSourceReader);
 
     SafeRelease(&m_pMediaSource);
 
-    m_bIsAvailable = false;
+    // Callers' destinations must not be written after closing
+    m_pendingReads.Clear();
+
+    if (m_pCounters) { m_pCounters->ResetQueueDepth(); }
 
-    LeaveCriticalSection(&m_criticalSection);
+    // Release the workers' threads
+    m_pWorkerPool.reset();
 
-    _RPT1(_CRT_WARN, "Left critical section in %s.\n", STRINGIZE(FreeResources));
+    ReleaseSRWLockExclusive(&m_srwLock);
 }
 
 // --------------------------------------------------------------------
-// CaptureDeviceChangeNotificationHandler
+// TransitionState
 //
-// On changes to the attached capture device, we will set the reader
-//  as unavailable so the consumer should initialize a new reader
-//  for a new device.
+// Returns false if the reader isn't in the expected state,
+//  such as a reader closed while being reconnected.
 // --------------------------------------------------------------------
 
-void CSourceReader::CaptureDeviceChangeNotificationHandler()
+bool CSourceReader::TransitionState(READER_STATE from, READER_STATE to)
 {
-    _RPT1(_CRT_WARN, "Waiting to enter critical section from %s.\n", STRINGIZE(CaptureDeviceChangeNotificationHandler));
-
-    EnterCriticalSection(&m_criticalSection);
-
-    _RPT1(_CRT_WARN, "Entered critical section in %s.\n", STRINGIZE(CaptureDeviceChangeNotificationHandler));
-
-    // Set the reader as unavailable
-    m_bIsAvailable = false;
-
-    LeaveCriticalSection(&m_criticalSection);
-
-    _RPT1(_CRT_WARN, "Left critical section in %s.\n", STRINGIZE(CaptureDeviceChangeNotificationHandler));
+    return InterlockedCompareExchange(&m_lState, static_cast<LONG>(to), static_cast<LONG>(from)) == static_cast<LONG>(from);
 }
 
 // --------------------------------------------------------------------
-// ProcessorProcessOutput
+// EnterCallback
+//
+// Samples are handled under the shared lock, which only waits
+//  for initializing, reconfiguring, reconnecting or closing.
+// The shared lock doesn't keep the callbacks apart, the source reader
+//  does, as the state of a sample isn't guarded for two at once. This
+//  is enforced by the callback lock, a sample arriving while another
+//  is handled waits for it, which is reported as it isn't expected.
 // --------------------------------------------------------------------
 
-void CSourceReader::ProcessorProcessOutput(
-    DWORD dwOutputStreamID,
-    IMFSample **ppOutputSample,
-    bool bDrain
-    )
+void CSourceReader::EnterCallback()
 {
-    assert(m_pProcessor != nullptr);
-    assert(!bDrain || ppOutputSample == nullptr); // You can't set ppOutputSample for drain.
-
-    HRESULT hr{ S_OK };
-    std::string exWhatString{ };
-
-    IMFMediaBuffer *pOutputBuffer{ nullptr };
-    IMFSample *pOutputSample{ nullptr };
-
-    // NOTE: why did we use `bDrain`?
-    //      I don't encourage exceptions as a part of the normal control flow,
-    //  so, catching an exception for a normal `Drain` operation is not favorable.
-    //  This lead me to add a flag which if set the function just drains the processor.
-    //  I added this flag to the function instead of creating a new one because of the shared logic.
-
-    if (bDrain)
     {
-        hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_NOTIFY_END_OF_STREAM, 0);
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransform::ProcessMessage().");
-
-        hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_COMMAND_DRAIN, 0);
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransform::ProcessMessage().");
+        CTraceSpan waitSpan{ "SharedLockWait", this };
+        AcquireSRWLockShared(&m_srwLock);
     }
 
-    do {
-        DWORD dwProcessOutputStatus{ 0 };
-        MFT_OUTPUT_STREAM_INFO outputStreamInfo{ 0 };
-        MFT_OUTPUT_DATA_BUFFER outputDataBuffer{ 0 };
+    if (!TryAcquireSRWLockExclusive(&m_srwCallbackLock))
+    {
+        _RPTFW1(_CRT_WARN, L"OnReadSample was called while another sample is handled on '%s'.\n", m_wstrDeviceSymbolicLink.c_str());
 
-        hr = m_pProcessor->GetOutputStreamInfo(dwOutputStreamID, &outputStreamInfo);
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransform::GetOutputStreamInfo().");
+        CTraceSpan waitSpan{ "CallbackLockWait", this };
+        AcquireSRWLockExclusive(&m_srwCallbackLock);
+    }
 
-        // Check if the sample should be allocated by us
-        if ((outputStreamInfo.dwFlags & (MFT_OUTPUT_STREAM_PROVIDES_SAMPLES | MFT_OUTPUT_STREAM_CAN_PROVIDE_SAMPLES))
-            != (MFT_OUTPUT_STREAM_PROVIDES_SAMPLES | MFT_OUTPUT_STREAM_CAN_PROVIDE_SAMPLES))
-        {
-            // TODO: This part needs optimization, we should reuse previous buffers instead of creating a new buffer each time,
-            //  this is an overhead we should optimize, and handle cases where the processor can provide the sample for us.
-            // NOTE: As this library is intended for quick preview and take a still shot, this isn't particularly painful,
-            //  but this note is here for next iterations and versions -if so :)-
+    m_dwCallbackThreadId = GetCurrentThreadId();
+}
 
-            // Create buffer
-            hr = MFCreateAlignedMemoryBuffer(outputStreamInfo.cbSize, outputStreamInfo.cbAlignment, &pOutputBuffer);
-            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateAlignedMemoryBuffer().");
+// --------------------------------------------------------------------
+// LeaveCallback
+//
+// A close deferred by the callbacks frees the resources here, with a
+//  reference held, as releasing the source reader may release the last
+//  reference to this reader. Nothing may be touched after the call.
+// --------------------------------------------------------------------
 
-            // Create the output sample
-            hr = MFCreateSample(&pOutputSample);
-            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateSample().");
+void CSourceReader::LeaveCallback()
+{
+    m_dwCallbackThreadId = 0;
 
-            // Add buffer to the sample
-            hr = pOutputSample->AddBuffer(pOutputBuffer);
-            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFSample::AddBuffer().");
-        }
+    ReleaseSRWLockExclusive(&m_srwCallbackLock);
+    ReleaseSRWLockShared(&m_srwLock);
 
-        // Get the output
-        outputDataBuffer.dwStreamID = dwOutputStreamID;
-        outputDataBuffer.pSample = pOutputSample;
-        outputDataBuffer.dwStatus = 0;
-        outputDataBuffer.pEvents = nullptr;
-        hr = m_pProcessor->ProcessOutput(0, 1, &outputDataBuffer, &dwProcessOutputStatus);
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransfer::ProcessOutput().");
+    if (InterlockedCompareExchange(&m_lIsCloseDeferred, FALSE, TRUE) == TRUE)
+    {
+        AddRef();
+        FreeResources();
+        Release();
+    }
+}
 
-        // set the output pointer if the caller is willing to receive the sample, and is available to begin with!
-        // Note that we assert on if bDrain is true, ppOutputSample has to be nullptr
-        if (ppOutputSample
-            && ((outputDataBuffer.dwStatus & MFT_OUTPUT_DATA_BUFFER_NO_SAMPLE) != MFT_OUTPUT_DATA_BUFFER_NO_SAMPLE))
-        {
-            *ppOutputSample = pOutputSample;
-            (*ppOutputSample)->AddRef();
+// --------------------------------------------------------------------
+// LeaveReadFrame
+// --------------------------------------------------------------------
 
-            // Here we break out of the loop as ppOutputSample won't be set in case of a drain process,
-            //  so we break out otherwise to not release it twice.
-            break;
-        }
+void CSourceReader::LeaveReadFrame(bool bIsCallbackThread)
+{
+    ReleaseSRWLockExclusive(&m_srwIssueLock);
 
-        // Release for next iteration in case of drain
-        SafeRelease(&pOutputSample);
-        SafeRelease(&pOutputBuffer);
-    } while (bDrain); // If we are in drain mode, loop till we get exception with `MF_E_TRANSFORM_NEED_MORE_INPUT` or others.
+    if (!bIsCallbackThread)
+    {
+        ReleaseSRWLockShared(&m_srwLock);
+    }
+}
 
+// --------------------------------------------------------------------
+// ResolveOrientation
+//
+// A vertical flip is a mirror followed by a 180 rotation, so the
+//  orientation comes down to an optional mirror and quarter turns.
+// Without a transpose (0 and 180), rows are mirrored, and for 180
+//  the destination rows are reversed as well.
+// With a transpose (90 and 270), the mirror is absorbed by reversing
+//  the rows of the source or the destination.
+// --------------------------------------------------------------------
 
+void CSourceReader::ResolveOrientation()
+{
+    const bool bMirror{ m_bMirror != m_bFlipVertical };
+    const UINT32 quarterTurns{ (static_cast<UINT32>(m_rotation) + (m_bFlipVertical ? 2 : 0)) % 4 };
 
-done:
-    SafeRelease(&pOutputSample);
-    SafeRelease(&pOutputBuffer);
+    m_bTranspose = (quarterTurns % 2) != 0;
 
-    if (FAILED(hr))
+    if (!m_bTranspose)
     {
-        if (hr == MF_E_TRANSFORM_NEED_MORE_INPUT && bDrain) { return; }
-
-        throw std::system_error{ hr, std::system_category(), exWhatString };
+        m_bMirrorRows = (quarterTurns == 2) ? !bMirror : bMirror;
+        m_bReverseSourceRows = false;
+        m_bReverseDestinationRows = (quarterTurns == 2);
+    }
+    else
+    {
+        m_bMirrorRows = false;
+        m_bReverseSourceRows = (quarterTurns == 1);
+        m_bReverseDestinationRows = (quarterTurns == 1) ? bMirror : !bMirror;
     }
 }
 
 // --------------------------------------------------------------------
-// ProcessorProcessSample
+// ConfigureFrames
+//
+// Configures the frames for the native type read from the device and
+//  the output type of the processor, null for GRAY8. The dimensions,
+//  resampling, buffers, tensor and write tasks all follow the types,
+//  so this is done on initialization and again when the type changes.
+// Must be called with the lock held exclusively.
 // --------------------------------------------------------------------
 
-void CSourceReader::ProcessorProcessSample(
-    DWORD dwStreamID,
-    IMFSample *pInputSample,
-    IMFSample **ppOutputSample
-)
+void CSourceReader::ConfigureFrames(
+    IMFMediaType *pSourceOutputMediaType,
+    IMFMediaType *pProcessorOutputMediaType
+    ) noexcept(false)
 {
-    assert(m_pProcessor != nullptr);
-    assert(pInputSample != nullptr);
-    assert(ppOutputSample != nullptr);
+    assert(pSourceOutputMediaType != nullptr);
 
     HRESULT hr{ S_OK };
-    std::string exWhatString{ };
+    std::string exWhatString{};
 
-    IMFSample *pOutputSample{ nullptr };
+    UINT32 frameRateNumerator{ 0 };
+    UINT32 frameRateDenominator{ 0 };
+    UINT64 frameDuration{ 0 };
 
-    hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_NOTIFY_BEGIN_STREAMING, 0);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransform::ProcessMessage().");
+    UINT32 outputWidth{ 0 };
+    UINT32 outputHeight{ 0 };
+
+    UINT32 frameWidth{ 0 };
+    UINT32 frameHeight{ 0 };
 
-    hr = m_pProcessor->ProcessInput(dwStreamID, pInputSample, 0);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, finalizeAndDrain, exWhatString, "Error occurred during IMFTransform::ProcessInput().");
+    GUID nativeSubtype{ GUID_NULL };
+    UINT32 nativeWidth{ 0 };
+    UINT32 tensorFrameWidth{ 0 };
+    UINT32 tensorFrameHeight{ 0 };
 
+    _RPTFW1(_CRT_WARN, L"Get frame width and height for '%s'.\n", m_wstrDeviceSymbolicLink.c_str());
+
+    // Get the DefaultStride, Width, Height for the frames
     try
     {
-        ProcessorProcessOutput(dwStreamID, &pOutputSample);
+        // The luma is read from the native type with no processor
+        GetWidthHeightDefaultStrideForMediaType(
+            pProcessorOutputMediaType ? pProcessorOutputMediaType : pSourceOutputMediaType,
+            &m_lSrcDefaultStride,
+            &m_sourceWidth,
+            &m_sourceHeight
+            );
+
+        _RPTFW4(_CRT_WARN, L"Dimensions are w(%d) x h(%d) with stride(%d) on '%s'.\n", m_sourceWidth, m_sourceHeight, m_lSrcDefaultStride, m_wstrDeviceSymbolicLink.c_str());
+
+        GetWidthHeightDefaultStrideForMediaType(pSourceOutputMediaType, &m_lNativeDefaultStride, &nativeWidth, &m_nativeHeight);
     }
     catch (const std::system_error &ex)
     {
         hr = ex.code().value();
 
-        exWhatString = std::string{ MAKE_EX_STR("Error occurred while processing output.") }
+        exWhatString = std::string{ MAKE_EX_STR("Error occurred during retrieving Width, Height, and DefualtStride for media type.") }
         + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
 
-        goto finalizeAndDrain;
+        goto done;
     }
 
-    if (ppOutputSample)
+    // The frame duration is used only to tell the frames missed between samples, so it isn't required
+    m_llFrameDuration = 0;
+    if (SUCCEEDED(MFGetAttributeRatio(pSourceOutputMediaType, MF_MT_FRAME_RATE, &frameRateNumerator, &frameRateDenominator))
+        && SUCCEEDED(MFFrameRateToAverageTimePerFrame(frameRateNumerator, frameRateDenominator, &frameDuration)))
     {
-        *ppOutputSample = pOutputSample;
-        (*ppOutputSample)->AddRef();
+        m_llFrameDuration = static_cast<LONGLONG>(frameDuration);
     }
 
-finalizeAndDrain:
-    try
+    if (m_llRequestedMaxFrameAge > 0)
     {
-        ProcessorProcessOutput(dwStreamID, nullptr, true);
+        m_llMaxFrameAge = m_llRequestedMaxFrameAge;
     }
-    catch (const std::system_error &ex)
+    else
     {
-        hr = ex.code().value();
-        if (exWhatString.empty())
-        {
-            exWhatString = std::string{ MAKE_EX_STR("Error occurred while draining processor.") }
-                + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
-        }
-        else
-        {
-            exWhatString = std::string{ MAKE_EX_STR("Error occurred while draining processor.") }
-                + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")"
-                + "\nWith Error: " + exWhatString;
-        }
-
-        goto done;
+        m_llMaxFrameAge = (m_llFrameDuration > 0) ? m_llFrameDuration : DEFAULT_MAX_FRAME_AGE;
     }
 
-done:
-    SafeRelease(&pOutputSample);
+    ResolveOrientation();
 
-    if (FAILED(hr))
-    {
-        throw std::system_error{ hr, std::system_category(), exWhatString };
-    }
-}
+    // Resampling for a previous type doesn't apply to this one
+    m_resampler.Reset();
+    m_lumaBuffer.reset();
 
-// ==============================
-// ====== Public Functions ======
-// ==============================
+    // Prepare resampling if the requested output size, or the size for the tensor, differs from the source
+    m_scaledWidth = m_sourceWidth;
+    m_scaledHeight = m_sourceHeight;
 
-// --------------------------------------------------------------------
-// SetReadFrameSuccessCallback
-// --------------------------------------------------------------------
+    outputWidth = m_requestedOutputWidth;
+    outputHeight = m_requestedOutputHeight;
 
-void CSourceReader::SetReadFrameSuccessCallback(READ_SAMPLE_SUCCESS_HANDLER pCallback)
+    if (m_bWriteTensor)
+    {
+        CTensorWriter::GetFrameSizeForTensor(m_tensorFormat, m_sourceWidth, m_sourceHeight, &outputWidth, &outputHeight);
+    }
+
+    if (outputWidth != 0
+        && (outputWidth != m_sourceWidth || outputHeight != m_sourceHeight))
+    {
+        try
+        {
+            m_resampler.Configure(
+                m_outputFormat,
+                m_sourceWidth,
+                m_sourceHeight,
+                outputWidth,
+                outputHeight,
+                m_resampleFilter,
+                m_bMirrorRows
+                );
+        }
+        catch (const std::invalid_argument &ex)
+        {
+            hr = E_INVALIDARG;
+
+            exWhatString = std::string{ MAKE_EX_STR("The requested output size isn't supported for the device size.") }
+                + "\nWith Error: " + ex.what();
+
+            goto done;
+        }
+        catch (const std::bad_alloc &/*ex*/)
+        {
+            exWhatString = MAKE_EX_STR("Error occurred while allocating memory for resampling.");
+            hr = E_OUTOFMEMORY;
+            goto done;
+        }
+
+        m_scaledWidth = outputWidth;
+        m_scaledHeight = outputHeight;
+
+        // The luma of YUY2 is taken out of the samples before resampling
+        if (m_nativeSubtype == MFVideoFormat_YUY2)
+        {
+            try
+            {
+                m_lumaBuffer = AllocateFrameMemory(static_cast<size_t>(m_sourceWidth) * static_cast<size_t>(m_sourceHeight));
+            }
+            catch (const std::bad_alloc &/*ex*/)
+            {
+                exWhatString = MAKE_EX_STR("Error occurred while allocating memory for the luma buffer.");
+                hr = E_OUTOFMEMORY;
+                goto done;
+            }
+        }
+
+        _RPTFW3(_CRT_WARN, L"Frames are resampled to w(%d) x h(%d) on '%s'.\n", m_scaledWidth, m_scaledHeight, m_wstrDeviceSymbolicLink.c_str());
+    }
+
+    frameWidth = m_bTranspose ? m_scaledHeight : m_scaledWidth;
+    frameHeight = m_bTranspose ? m_scaledWidth : m_scaledHeight;
+
+    // The consumer may hold a taken latest frame and reads it at the frame size,
+    //  so once the buffers are published into, the frame size can't change.
+    if (m_bPublishLatestFrame && m_latestFrames.GetIsAllocated()
+        && (frameWidth != m_frameWidth || frameHeight != m_frameHeight))
+    {
+        hr = MF_E_INVALIDMEDIATYPE;
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "The frame size can't change in latest frame mode, the reader has to be reopened.");
+    }
+
+    m_frameWidth = frameWidth;
+    m_frameHeight = frameHeight;
+
+    _RPTFW1(_CRT_WARN, L"Create frame buffer for '%s'.\n", m_wstrDeviceSymbolicLink.c_str());
+
+    // Create the buffer for the frames
+    try
+    {
+        m_frameBuffer = AllocateFrameMemory(static_cast<size_t>(GetFrameStride()) * static_cast<size_t>(m_frameHeight));
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        exWhatString = MAKE_EX_STR("Error occurred while allocating memory for the frame buffer.");
+        hr = E_OUTOFMEMORY;
+        goto done;
+    }
+
+    // Create the buffers the frames are published into
+    if (m_bPublishLatestFrame && !m_latestFrames.GetIsAllocated())
+    {
+        try
+        {
+            m_latestFrames.Allocate(static_cast<size_t>(GetFrameStride()) * static_cast<size_t>(m_frameHeight));
+        }
+        catch (const std::bad_alloc &/*ex*/)
+        {
+            exWhatString = MAKE_EX_STR("Error occurred while allocating memory for the latest frame buffers.");
+            hr = E_OUTOFMEMORY;
+            goto done;
+        }
+    }
+
+    // Create the tensor, read from the native samples if they are YUV, or else written from the frames
+    if (m_bWriteTensor)
+    {
+        try
+        {
+            if (SUCCEEDED(pSourceOutputMediaType->GetGUID(MF_MT_SUBTYPE, &nativeSubtype))
+                && GetIsLumaReadableSubtype(nativeSubtype)
+                && (nativeWidth % 2) == 0 && (m_nativeHeight % 2) == 0)
+            {
+                CTensorWriter::GetFrameSizeForTensor(m_tensorFormat, nativeWidth, m_nativeHeight, &tensorFrameWidth, &tensorFrameHeight);
+
+                m_tensorWriter.Configure(m_tensorFormat, tensorFrameWidth, tensorFrameHeight);
+                m_tensorWriter.ConfigureYuvSource(
+                    nativeSubtype,
+                    nativeWidth,
+                    m_nativeHeight,
+                    static_cast<MFVideoTransferMatrix>(MFGetAttributeUINT32(pSourceOutputMediaType, MF_MT_YUV_MATRIX, MFVideoTransferMatrix_BT601)),
+                    static_cast<MFNominalRange>(MFGetAttributeUINT32(pSourceOutputMediaType, MF_MT_VIDEO_NOMINAL_RANGE, MFNominalRange_16_235)),
+                    m_bMirrorRows,
+                    m_bReverseDestinationRows
+                    );
+
+                _RPTFW1(_CRT_WARN, L"Tensor is read from the native samples on '%s'.\n", m_wstrDeviceSymbolicLink.c_str());
+            }
+            else
+            {
+                m_tensorWriter.Configure(m_tensorFormat, m_frameWidth, m_frameHeight);
+            }
+        }
+        catch (const std::invalid_argument &ex)
+        {
+            hr = E_INVALIDARG;
+
+            exWhatString = std::string{ MAKE_EX_STR("The tensor format isn't valid.") }
+                + "\nWith Error: " + ex.what();
+
+            goto done;
+        }
+        catch (const std::bad_alloc &/*ex*/)
+        {
+            exWhatString = MAKE_EX_STR("Error occurred while allocating memory for the tensor.");
+            hr = E_OUTOFMEMORY;
+            goto done;
+        }
+    }
+
+    // Split the frame for writing in parallel, the workers for a previous type are released first
+    m_pWorkerPool.reset();
+
+    try
+    {
+        PrepareWriteTasks();
+
+        _RPTFW2(_CRT_WARN, L"Frames are written by %d tasks on '%s'.\n", m_writeTasksCount, m_wstrDeviceSymbolicLink.c_str());
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        exWhatString = MAKE_EX_STR("Error occurred while allocating memory for the write tasks.");
+        hr = E_OUTOFMEMORY;
+        goto done;
+    }
+    catch (const std::system_error &ex)
+    {
+        hr = ex.code().value();
+
+        exWhatString = std::string{ MAKE_EX_STR("Error occurred while creating the worker pool.") }
+            + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+
+        goto done;
+    }
+
+done:
+    if (FAILED(hr))
+    {
+        throw std::system_error{ hr, std::system_category(), exWhatString };
+    }
+}
+
+// --------------------------------------------------------------------
+// ReconfigureForCurrentMediaType
+//
+// Reconfigures the processor and the frames in place for the current
+//  type of the source reader, after the device changed its type while
+//  streaming, e.g. a resolution switch after a USB bandwidth
+//  renegotiation. The new type is kept as the native type, so that
+//  reconnecting requests the type the frames are configured for.
+// Must be called with the lock held exclusively.
+// --------------------------------------------------------------------
+
+void CSourceReader::ReconfigureForCurrentMediaType(LONGLONG *pllReconfigurationTime) noexcept(false)
+{
+    assert(m_pSourceReader != nullptr);
+    assert(pllReconfigurationTime != nullptr);
+
+    HRESULT hr{ S_OK };
+    std::string exWhatString{};
+
+    IMFMediaType *pSourceOutputMediaType{ nullptr };
+    IMFMediaType *pProcessorOutputMediaType{ nullptr };
+
+    GUID sourceOutputSubtype{ GUID_NULL };
+
+    LARGE_INTEGER startTime{};
+    LARGE_INTEGER endTime{};
+    LARGE_INTEGER frequency{};
+
+    CTraceSpan span{ "Reconfigure", this };
+
+    QueryPerformanceCounter(&startTime);
+
+    hr = m_pSourceReader->GetCurrentMediaType(static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM), &pSourceOutputMediaType);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFSourceReader::GetCurrentMediaType().");
+
+    hr = pSourceOutputMediaType->GetGUID(MF_MT_SUBTYPE, &sourceOutputSubtype);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFMediaType::GetGUID().");
+
+    if (m_pProcessor)
+    {
+        // Drop what the processor holds of the previous type before changing its types
+        hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_COMMAND_FLUSH, 0);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransform::ProcessMessage().");
+
+        try
+        {
+            SetVideoProcessorOutputForInputMediaType(m_pProcessor, pSourceOutputMediaType, OUTPUT_VIDEO_SUBTYPE, /*OUT*/ pProcessorOutputMediaType);
+        }
+        catch (const std::system_error &ex)
+        {
+            hr = ex.code().value();
+
+            exWhatString = std::string{ MAKE_EX_STR("Error occurred while preparing the video processor for the new media type.") }
+                + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+
+            goto done;
+        }
+
+        // The output buffer is sized for the new type on the next sample
+        SafeRelease(&m_pProcessorOutputBuffer);
+    }
+    else
+    {
+        // The luma is read from the new type as is
+        if (!GetIsLumaReadableSubtype(sourceOutputSubtype))
+        {
+            hr = MF_E_INVALIDMEDIATYPE;
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "The luma can't be read from the new media type of the device.");
+        }
+
+        m_nativeSubtype = sourceOutputSubtype;
+    }
+
+    SafeRelease(&m_pNativeMediaType);
+    m_pNativeMediaType = pSourceOutputMediaType;
+    m_pNativeMediaType->AddRef();
+
+    try
+    {
+        ConfigureFrames(pSourceOutputMediaType, pProcessorOutputMediaType);
+    }
+    catch (const std::system_error &ex)
+    {
+        hr = ex.code().value();
+
+        exWhatString = std::string{ MAKE_EX_STR("Error occurred while configuring the frames for the new media type.") }
+            + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+
+        goto done;
+    }
+
+    // The change isn't a gap in the stream, and the latency is measured again for the new type
+    m_llLastSampleTime = -1;
+    m_llMinLatency = -1;
+    m_staleSamplesCount = 0;
+
+    if (m_pCounters) { m_pCounters->AddFormatChange(); }
+
+    QueryPerformanceCounter(&endTime);
+    QueryPerformanceFrequency(&frequency);
+    *pllReconfigurationTime = static_cast<LONGLONG>(
+        static_cast<double>(endTime.QuadPart - startTime.QuadPart) * 10000000.0 / static_cast<double>(frequency.QuadPart)
+        );
+
+    _RPTW4(_CRT_WARN, L"Reconfigured '%s' for w(%d) x h(%d) in %lld (100ns).\n", m_wstrDeviceSymbolicLink.c_str(), m_frameWidth, m_frameHeight, *pllReconfigurationTime);
+
+done:
+    SafeRelease(&pSourceOutputMediaType);
+    SafeRelease(&pProcessorOutputMediaType);
+
+    if (FAILED(hr))
+    {
+        throw std::system_error{ hr, std::system_category(), exWhatString };
+    }
+}
+
+// --------------------------------------------------------------------
+// WriteOutputFrame
+//
+// Writes the locked RGB32 frame, or the luma plane for GRAY8, into the frame, the reader's buffer or
+//  a caller destination, starting at `pbFrameScanline0`. Resampled if
+//  an output size is set, and oriented as requested in the same pass.
+// The frame is split into the write tasks, each writing its own rows
+//  in parallel, and all of them complete before returning so the frame
+//  is whole before it is passed to the consumer.
+// If statistics are requested, each task accumulates them right after
+//  writing each band while its rows are still in cache, instead of
+//  doing a second pass over the frame, and they are merged at the end.
+//  Statistics are computed only for BGRA32 frames. The tensor is
+//  written the same way, from each band of the frame, unless it is
+//  read from the native sample.
+// --------------------------------------------------------------------
+
+HRESULT CSourceReader::WriteOutputFrame(
+    const BYTE *pbScanline0,
+    LONG lStride,
+    BYTE *pbFrameScanline0,
+    LONG lFrameStride,
+    FRAME_METADATA *pMetadata
+    )
+{
+    assert(pbScanline0 != nullptr);
+    assert(pbFrameScanline0 != nullptr);
+    assert(pMetadata != nullptr);
+    assert(m_writeTasksCount > 0);
+
+    CTraceSpan span{ "WriteFrame", this };
+
+    HRESULT hr{ S_OK };
+
+    const bool bResample{ m_resampler.GetIsConfigured() };
+    const bool bComputeStatistics{ GetComputeFrameStatistics() && m_outputFormat == PIXEL_FORMAT::BGRA32 };
+    const bool bWriteTensor{ m_tensorWriter.GetIsConfigured() && !m_tensorWriter.GetIsYuvSource() };
+
+    // The frame is visited from its last row up when the destination rows are reversed
+    BYTE *pbDestinationScanline0{ pbFrameScanline0 };
+    LONG lDestinationStride{ lFrameStride };
+
+    if (m_bReverseDestinationRows)
+    {
+        pbDestinationScanline0 += static_cast<LONG_PTR>(lFrameStride) * (m_frameHeight - 1);
+        lDestinationStride = -lFrameStride;
+    }
+
+    pMetadata->pStatistics = nullptr;
+    pMetadata->pbTensor = nullptr;
+    pMetadata->cbTensor = 0;
+
+    // The rows are read back for the statistics and the tensor, and the reader's own buffers
+    //  are read back right away to be copied for the consumer, so only caller destinations are streamed
+    const DWORD cbScaledRow{ m_scaledWidth * GetBytesPerPixel(m_outputFormat) };
+    const bool bStreamCopy{
+        pMetadata->pDestination != nullptr
+        && !bComputeStatistics && !bWriteTensor
+        && static_cast<UINT64>(cbScaledRow) * m_scaledHeight >= MIN_BYTES_FOR_STREAM_COPY
+    };
+
+    if (m_writeTasksCount == 1 && !bResample && !bComputeStatistics && !bWriteTensor && !m_bTranspose && !m_bMirrorRows)
+    {
+        CopyImage(pbDestinationScanline0, lDestinationStride, pbScanline0, lStride, cbScaledRow, m_scaledHeight, bStreamCopy);
+        return S_OK;
+    }
+
+    if (bComputeStatistics)
+    {
+        try
+        {
+            for (UINT32 i = 0; i < m_writeTasksCount; i++)
+            {
+                m_writeTasks[i].statisticsAccumulator.Reset(m_scaledWidth);
+            }
+        }
+        catch (const std::bad_alloc &/*ex*/)
+        {
+            return E_OUTOFMEMORY;
+        }
+    }
+
+    m_writeFrame.pbSourceScanline0 = pbScanline0;
+    m_writeFrame.lSourceStride = lStride;
+    m_writeFrame.pbDestinationScanline0 = pbDestinationScanline0;
+    m_writeFrame.lDestinationStride = lDestinationStride;
+    m_writeFrame.bComputeStatistics = bComputeStatistics;
+    m_writeFrame.bWriteTensor = bWriteTensor;
+    m_writeFrame.bStreamCopy = bStreamCopy;
+
+    if (bResample)
+    {
+        // The vertical pass of a band needs rows of the horizontal pass from the neighbouring bands,
+        //  so the horizontal pass completes for the whole frame first.
+        RunWriteTasks(ResampleSourceRowsTask);
+    }
+
+    RunWriteTasks(WriteFrameRowsTask);
+
+    for (UINT32 i = 0; i < m_writeTasksCount; i++)
+    {
+        if (FAILED(m_writeTasks[i].hr)) { return m_writeTasks[i].hr; }
+    }
+
+    if (bComputeStatistics)
+    {
+        CFrameStatisticsAccumulator &accumulator{ m_writeTasks[0].statisticsAccumulator };
+
+        for (UINT32 i = 1; i < m_writeTasksCount; i++)
+        {
+            accumulator.Merge(m_writeTasks[i].statisticsAccumulator);
+        }
+
+        accumulator.Finalize(&m_frameStatistics);
+        pMetadata->pStatistics = &m_frameStatistics;
+    }
+
+    if (bWriteTensor)
+    {
+        pMetadata->pbTensor = m_tensorWriter.GetBuffer();
+        pMetadata->cbTensor = m_tensorWriter.GetBufferSize();
+    }
+
+    return hr;
+}
+
+// --------------------------------------------------------------------
+// WriteTensorFromSample
+//
+// Reads the tensor from the native YUV sample in a single pass, the
+//  tasks split the rows of the tensor.
+// --------------------------------------------------------------------
+
+HRESULT CSourceReader::WriteTensorFromSample(IMFSample *pSample, FRAME_METADATA *pMetadata)
+{
+    assert(pSample != nullptr);
+    assert(pMetadata != nullptr);
+    assert(m_tensorWriter.GetIsYuvSource());
+
+    CTraceSpan span{ "WriteTensor", this };
+
+    HRESULT hr{ S_OK };
+
+    IMFMediaBuffer *pBuffer{ nullptr };
+
+    BYTE *pbScanline0{ nullptr };
+    LONG lStride{ 0 };
+
+    hr = pSample->GetBufferByIndex(0, &pBuffer);
+    if (FAILED(hr)) { return hr; }
+
+    {
+        CBufferLock buffer{ pBuffer };
+        hr = buffer.LockBuffer(m_lNativeDefaultStride, m_nativeHeight, &pbScanline0, &lStride);
+
+        // The YUV types are top-down, the planes follow each other from the first row
+        if (SUCCEEDED(hr) && lStride <= 0)
+        {
+            hr = MF_E_INVALIDMEDIATYPE;
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            m_writeFrame.pbNativeScanline0 = pbScanline0;
+            m_writeFrame.lNativeStride = lStride;
+
+            RunWriteTasks(WriteTensorRowsTask);
+
+            pMetadata->pbTensor = m_tensorWriter.GetBuffer();
+            pMetadata->cbTensor = m_tensorWriter.GetBufferSize();
+        }
+    }
+
+    SafeRelease(&pBuffer);
+
+    return hr;
+}
+
+// --------------------------------------------------------------------
+// WriteLumaFrame
+//
+// Writes the luma of the locked native sample into the frame. The Y
+//  plane of NV12 and I420 is written as is, the luma of YUY2 is taken
+//  from every other byte straight into the frame, or into the luma
+//  buffer first if it is resampled.
+// --------------------------------------------------------------------
+
+HRESULT CSourceReader::WriteLumaFrame(
+    const BYTE *pbScanline0,
+    LONG lStride,
+    BYTE *pbFrameScanline0,
+    LONG lFrameStride,
+    FRAME_METADATA *pMetadata
+    )
+{
+    assert(pbScanline0 != nullptr);
+    assert(pbFrameScanline0 != nullptr);
+    assert(pMetadata != nullptr);
+
+    CTraceSpan span{ "WriteLumaFrame", this };
+
+    if (m_nativeSubtype != MFVideoFormat_YUY2)
+    {
+        return WriteOutputFrame(pbScanline0, lStride, pbFrameScanline0, lFrameStride, pMetadata);
+    }
+
+    if (m_resampler.GetIsConfigured())
+    {
+        ExtractLumaFromYuy2(pbScanline0, lStride, m_lumaBuffer.get(), static_cast<LONG>(m_sourceWidth), m_sourceWidth, m_sourceHeight);
+
+        return WriteOutputFrame(m_lumaBuffer.get(), static_cast<LONG>(m_sourceWidth), pbFrameScanline0, lFrameStride, pMetadata);
+    }
+
+    pMetadata->pStatistics = nullptr;
+
+    if (m_bReverseDestinationRows)
+    {
+        pbFrameScanline0 += static_cast<LONG_PTR>(lFrameStride) * (m_frameHeight - 1);
+        lFrameStride = -lFrameStride;
+    }
+
+    ExtractLumaFromYuy2(pbScanline0, lStride, pbFrameScanline0, lFrameStride, m_sourceWidth, m_sourceHeight);
+
+    return S_OK;
+}
+
+// --------------------------------------------------------------------
+// PrepareWriteTasks
+//
+// Splits the frame into bands of rows for the write tasks, a task for
+//  each `MIN_PIXELS_PER_WRITE_TASK` pixels up to the processors count,
+//  so small frames are written by a single task on the calling thread.
+//  The bands are multiples of `OUTPUT_BAND_ROWS`, which keeps the
+//  columns written by each task apart by whole cache lines when
+//  transposing.
+// --------------------------------------------------------------------
+
+void CSourceReader::PrepareWriteTasks() noexcept(false)
+{
+    const UINT64 sourcePixels{ static_cast<UINT64>(m_sourceWidth) * m_sourceHeight };
+    const UINT64 scaledPixels{ static_cast<UINT64>(m_scaledWidth) * m_scaledHeight };
+    const UINT32 bandsCount{ (m_scaledHeight + OUTPUT_BAND_ROWS - 1) / OUTPUT_BAND_ROWS };
+
+    UINT64 tasksCount{ (std::max)(sourcePixels, scaledPixels) / MIN_PIXELS_PER_WRITE_TASK };
+    tasksCount = (std::min)(tasksCount, static_cast<UINT64>(CWorkerPool::GetProcessorCount()));
+    tasksCount = (std::min)(tasksCount, static_cast<UINT64>(bandsCount));
+    tasksCount = (std::max)(tasksCount, static_cast<UINT64>(1));
+
+    m_writeTasksCount = static_cast<UINT32>(tasksCount);
+    m_writeTasks = std::make_unique<WRITE_TASK[]>(m_writeTasksCount);
+
+    for (UINT32 i = 0; i < m_writeTasksCount; i++)
+    {
+        WRITE_TASK &task{ m_writeTasks[i] };
+
+        task.rowBegin = (std::min)(static_cast<UINT32>(static_cast<UINT64>(bandsCount) * i / m_writeTasksCount) * OUTPUT_BAND_ROWS, m_scaledHeight);
+        task.rowEnd = (std::min)(static_cast<UINT32>(static_cast<UINT64>(bandsCount) * (i + 1) / m_writeTasksCount) * OUTPUT_BAND_ROWS, m_scaledHeight);
+        task.hr = S_OK;
+
+        // A resampled band is transposed from its own buffer
+        if (m_bTranspose && m_resampler.GetIsConfigured())
+        {
+            task.bandBuffer = std::make_unique<BYTE[]>(static_cast<size_t>(m_scaledWidth) * OUTPUT_BAND_ROWS * GetBytesPerPixel(m_outputFormat));
+        }
+    }
+
+    // The calling thread runs tasks too
+    if (m_writeTasksCount > 1)
+    {
+        m_pWorkerPool = std::make_unique<CWorkerPool>();
+        m_pWorkerPool->Initialize(m_writeTasksCount - 1);
+    }
+}
+
+// --------------------------------------------------------------------
+// RunWriteTasks
+// --------------------------------------------------------------------
+
+void CSourceReader::RunWriteTasks(FP_WORKER_POOL_TASK pTask)
+{
+    if (m_pWorkerPool)
+    {
+        m_pWorkerPool->Run(pTask, this, m_writeTasksCount);
+        return;
+    }
+
+    for (UINT32 i = 0; i < m_writeTasksCount; i++)
+    {
+        pTask(this, i);
+    }
+}
+
+// --------------------------------------------------------------------
+// ResampleSourceRows
+//
+// Horizontal pass of the resampler over the task's share of the
+//  source rows, which differ from its rows of the scaled frame.
+// --------------------------------------------------------------------
+
+void CSourceReader::ResampleSourceRows(UINT32 taskIndex)
+{
+    const UINT32 rowBegin{ static_cast<UINT32>(static_cast<UINT64>(m_sourceHeight) * taskIndex / m_writeTasksCount) };
+    const UINT32 rowEnd{ static_cast<UINT32>(static_cast<UINT64>(m_sourceHeight) * (taskIndex + 1) / m_writeTasksCount) };
+
+    if (rowBegin == rowEnd) { return; }
+
+    m_resampler.ResampleHorizontal(
+        m_writeFrame.pbSourceScanline0 + static_cast<LONG_PTR>(m_writeFrame.lSourceStride) * rowBegin,
+        m_writeFrame.lSourceStride,
+        0,
+        rowBegin,
+        rowEnd
+        );
+}
+
+// --------------------------------------------------------------------
+// WriteFrameRows
+//
+// Writes the task's rows of the scaled frame in bands. Statistics
+//  don't depend on the orientation, so they are accumulated over the
+//  band before transposing.
+// --------------------------------------------------------------------
+
+void CSourceReader::WriteFrameRows(UINT32 taskIndex)
+{
+    WRITE_TASK &task{ m_writeTasks[taskIndex] };
+
+    const bool bResample{ m_resampler.GetIsConfigured() };
+
+    const DWORD cbScaledRow{ m_scaledWidth * GetBytesPerPixel(m_outputFormat) };
+
+    const BYTE *pbScanline0{ m_writeFrame.pbSourceScanline0 };
+    const LONG lStride{ m_writeFrame.lSourceStride };
+    BYTE *pbDestinationScanline0{ m_writeFrame.pbDestinationScanline0 };
+    const LONG lDestinationStride{ m_writeFrame.lDestinationStride };
+
+    task.hr = S_OK;
+
+    for (UINT32 y = task.rowBegin; y < task.rowEnd; y += OUTPUT_BAND_ROWS)
+    {
+        const UINT32 rows{ (std::min)(static_cast<UINT32>(OUTPUT_BAND_ROWS), task.rowEnd - y) };
+
+        // The band of the scaled, not yet rotated frame
+        const BYTE *pbBand{ nullptr };
+        LONG lBandStride{ 0 };
+
+        if (!m_bTranspose)
+        {
+            BYTE *pbDestinationBand{ pbDestinationScanline0 + static_cast<LONG_PTR>(lDestinationStride) * y };
+
+            if (bResample)
+            {
+                m_resampler.ResampleVertical(pbDestinationBand, lDestinationStride, 0, y, y + rows);
+            }
+            else if (m_bMirrorRows)
+            {
+                MirrorRows32(pbScanline0 + static_cast<LONG_PTR>(lStride) * y, lStride, pbDestinationBand, lDestinationStride, m_scaledWidth, rows);
+            }
+            else
+            {
+                CopyImage(pbDestinationBand, lDestinationStride, pbScanline0 + static_cast<LONG_PTR>(lStride) * y, lStride, cbScaledRow, rows, m_writeFrame.bStreamCopy);
+            }
+
+            pbBand = pbDestinationBand;
+            lBandStride = lDestinationStride;
+        }
+        else
+        {
+            if (bResample)
+            {
+                m_resampler.ResampleVertical(task.bandBuffer.get(), static_cast<LONG>(cbScaledRow), 0, y, y + rows);
+
+                pbBand = task.bandBuffer.get();
+                lBandStride = static_cast<LONG>(cbScaledRow);
+            }
+            else
+            {
+                pbBand = pbScanline0 + static_cast<LONG_PTR>(lStride) * y;
+                lBandStride = lStride;
+            }
+
+            // The rows of the band become the destination columns [y, y + rows),
+            //  or the columns counted from the end in reverse order if the source rows are reversed.
+            if (m_bReverseSourceRows)
+            {
+                TransposeImage32(
+                    pbBand + static_cast<LONG_PTR>(lBandStride) * (rows - 1),
+                    -lBandStride,
+                    m_scaledWidth,
+                    rows,
+                    pbDestinationScanline0 + static_cast<size_t>(m_scaledHeight - y - rows) * GetBytesPerPixel(m_outputFormat),
+                    lDestinationStride
+                    );
+            }
+            else
+            {
+                TransposeImage32(
+                    pbBand,
+                    lBandStride,
+                    m_scaledWidth,
+                    rows,
+                    pbDestinationScanline0 + static_cast<size_t>(y) * GetBytesPerPixel(m_outputFormat),
+                    lDestinationStride
+                    );
+            }
+        }
+
+        if (m_writeFrame.bComputeStatistics)
+        {
+            task.statisticsAccumulator.AccumulateRows(pbBand, lBandStride, rows);
+        }
+
+        // The tensor isn't written with a transpose, so the band is rows of the frame,
+        //  from the bottom up if the destination rows are reversed.
+        if (m_writeFrame.bWriteTensor)
+        {
+            if (m_bReverseDestinationRows)
+            {
+                m_tensorWriter.WriteRows(pbBand + static_cast<LONG_PTR>(lBandStride) * (rows - 1), -lBandStride, m_frameHeight - y - rows, rows);
+            }
+            else
+            {
+                m_tensorWriter.WriteRows(pbBand, lBandStride, y, rows);
+            }
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// WriteTensorRows
+//
+// The task's share of the rows of the tensor.
+// --------------------------------------------------------------------
+
+void CSourceReader::WriteTensorRows(UINT32 taskIndex)
+{
+    const UINT32 rowBegin{ static_cast<UINT32>(static_cast<UINT64>(m_tensorFormat.height) * taskIndex / m_writeTasksCount) };
+    const UINT32 rowEnd{ static_cast<UINT32>(static_cast<UINT64>(m_tensorFormat.height) * (taskIndex + 1) / m_writeTasksCount) };
+
+    if (rowBegin == rowEnd) { return; }
+
+    m_tensorWriter.WriteYuvSourceRows(m_writeFrame.pbNativeScanline0, m_writeFrame.lNativeStride, rowBegin, rowEnd);
+}
+
+// --------------------------------------------------------------------
+// CaptureDeviceChangeNotificationHandler
+//
+// On losing the attached capture device, we will set the reader
+//  as unavailable so the consumer should initialize a new reader
+//  for a new device, unless auto reconnect is set, then once the
+//  device arrives again, the reader reconnects to it on the thread
+//  pool, away from the notification thread.
+// --------------------------------------------------------------------
+
+void CSourceReader::CaptureDeviceChangeNotificationHandler(bool bIsArrival)
+{
+    LARGE_INTEGER now{};
+
+    CTraceSpan span{ "CaptureDeviceChangeNotificationHandler", this };
+
+    // No lock is taken, so a removal isn't held back by a sample being handled
+    if (!bIsArrival)
+    {
+        QueryPerformanceCounter(&now);
+
+        // Set the reader as unavailable, the downtime counts from the first removal
+        if (TransitionState(READER_STATE::AVAILABLE, READER_STATE::LOST))
+        {
+            InterlockedExchange64(&m_llDeviceLostTime, now.QuadPart);
+        }
+    }
+    else if (GetAutoReconnect() && GetState() == READER_STATE::LOST
+        && InterlockedCompareExchange(&m_lIsReconnectScheduled, TRUE, FALSE) == FALSE)
+    {
+        // The callback holds a reference until it completes
+        AddRef();
+
+        if (!TrySubmitThreadpoolCallback(ReconnectCallback, this, nullptr))
+        {
+            InterlockedExchange(&m_lIsReconnectScheduled, FALSE);
+            Release();
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// CreateSourceReader
+//
+// Creates the media source for the device, and the source reader
+//  calling back this instance.
+// --------------------------------------------------------------------
+
+void CSourceReader::CreateSourceReader(const WCHAR *pwszDeviceSymbolicLink)
+{
+    assert(pwszDeviceSymbolicLink != nullptr);
+    assert(m_pMediaSource == nullptr);
+    assert(m_pSourceReader == nullptr);
+
+    HRESULT hr{ S_OK };
+    std::string exWhatString{};
+
+    IMFAttributes *pAttributes{ nullptr };
+
+    // ---
+    // --- Create media source for the symbolic link
+    // ---
+
+    // Create attributes to pass to `MFCreateDeviceSource` with two slots
+    hr = MFCreateAttributes(&pAttributes, 2);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateAttributes().");
+
+    hr = pAttributes->SetGUID(MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE, MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE_VIDCAP_GUID);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetGUID().");
+
+    hr = pAttributes->SetString(MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE_VIDCAP_SYMBOLIC_LINK, pwszDeviceSymbolicLink);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetString().");
+
+    // Create the media source for the device
+    hr = MFCreateDeviceSource(pAttributes, &m_pMediaSource);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateDeviceSource().");
+
+    // Release the attributes for the next use
+    SafeRelease(&pAttributes);
+
+    _RPTFW1(_CRT_WARN, L"Device source created for '%s'.\n", pwszDeviceSymbolicLink);
+
+    // ---
+    // --- Create the source reader
+    // ---
+    
+    // Create attributes to hold settings with 3 settings' slots
+    hr = MFCreateAttributes(&pAttributes, 3);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateAttributes().");
+
+    hr = pAttributes->SetUINT32(MF_READWRITE_DISABLE_CONVERTERS, true);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetUINT32().");
+
+    // Ask the source and the reader to favor latency over buffering
+    if (m_bLowLatency)
+    {
+        hr = pAttributes->SetUINT32(MF_LOW_LATENCY, true);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetUINT32().");
+    }
+
+    // Set the an attribute slot for this class instance as callback for events e.g. OnReadSample
+    hr = pAttributes->SetUnknown(
+        MF_SOURCE_READER_ASYNC_CALLBACK,
+        this
+        );
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetUnknown().");
+
+    // Create source reader for the media source using the attributes
+    hr = MFCreateSourceReaderFromMediaSource(
+        m_pMediaSource,
+        pAttributes,
+        &m_pSourceReader
+        );
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateSourceReaderFromMediaSource().");
+
+    // Release the attributes for the next use
+    SafeRelease(&pAttributes);
+
+    _RPTFW1(_CRT_WARN, L"Source reader created for '%s'.\n", pwszDeviceSymbolicLink);
+
+done:
+    SafeRelease(&pAttributes);
+
+    if (FAILED(hr))
+    {
+        if (m_pMediaSource)
+        {
+            m_pMediaSource->Shutdown();
+        }
+
+        SafeRelease(&m_pSourceReader);
+        SafeRelease(&m_pMediaSource);
+
+        throw std::system_error{ hr, std::system_category(), exWhatString };
+    }
+}
+
+// --------------------------------------------------------------------
+// NegotiateFromCacheEntry
+//
+// Sets the processor for the native type kept in the cache entry,
+//  skipping the search for the native type and the processor. Returns
+//  false if the device doesn't offer the same type at the index
+//  anymore or the processor can't be set for it, then nothing is kept.
+// --------------------------------------------------------------------
+
+bool CSourceReader::NegotiateFromCacheEntry(
+    const NEGOTIATION_CACHE_ENTRY &entry,
+    IMFMediaType *&pSourceOutputMediaType,
+    IMFMediaType *&pProcessorOutputMediaType
+    )
+{
+    assert(m_pSourceReader != nullptr);
+    assert(m_pProcessor == nullptr);
+
+    HRESULT hr{ S_OK };
+
+    hr = m_pSourceReader->GetNativeMediaType(
+        static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM),
+        entry.nativeTypeIndex,
+        &pSourceOutputMediaType
+        );
+
+    if (SUCCEEDED(hr) && !GetIsMediaTypeMatchingNegotiationCacheEntry(pSourceOutputMediaType, entry))
+    {
+        hr = MF_E_INVALIDMEDIATYPE;
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = CoCreateInstance(entry.processorClsid, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&m_pProcessor));
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        try
+        {
+            SetVideoProcessorOutputForInputMediaType(m_pProcessor, pSourceOutputMediaType, OUTPUT_VIDEO_SUBTYPE, /*OUT*/ pProcessorOutputMediaType);
+        }
+        catch (const std::system_error &ex)
+        {
+            hr = ex.code().value();
+        }
+    }
+
+    if (FAILED(hr))
+    {
+        _RPTF1(_CRT_WARN, "Negotiation cache entry doesn't match the device (0x%08X).\n", hr);
+
+        SafeRelease(&pProcessorOutputMediaType);
+        SafeRelease(&m_pProcessor);
+        SafeRelease(&pSourceOutputMediaType);
+
+        return false;
+    }
+
+    return true;
+}
+
+// --------------------------------------------------------------------
+// IssueLatestFrameRead
+//
+// Issues the read kept in flight in latest frame mode, has to be
+//  called from the callback or with the lock held exclusively.
+// --------------------------------------------------------------------
+
+HRESULT CSourceReader::IssueLatestFrameRead()
+{
+    HRESULT hr{ S_OK };
+
+    if (!m_pendingReads.TryPush(IMAGE_VIEW{}))
+    {
+        return MF_E_NOTACCEPTING;
+    }
+
+    hr = m_pSourceReader->ReadSample(
+            static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM),
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr
+            );
+
+    // No callback will come for a failed read
+    if (FAILED(hr))
+    {
+        m_pendingReads.PopBack();
+    }
+    else if (m_pCounters)
+    {
+        m_pCounters->IncrementQueueDepth();
+    }
+
+    return hr;
+}
+
+// --------------------------------------------------------------------
+// InjectSampleFaults
+//
+// Rewrites the status and the flags of the sample as passed by the
+//  source, so the injected faults take every path a fault of the
+//  source takes. Called before taking the lock.
+// --------------------------------------------------------------------
+
+void CSourceReader::InjectSampleFaults(HRESULT *phrStatus, DWORD *pdwStreamFlags)
+{
+    const LONG64 llSamplesCount{ InterlockedIncrement64(&m_llFaultSamplesCount) };
+    const LONG lFailEveryNthSample{ m_lFailEveryNthSample };
+    const LONG lChangeFormatEveryNthSample{ m_lChangeFormatEveryNthSample };
+    const LONG lSampleDelayMs{ m_lSampleDelayMs };
+
+    if (lFailEveryNthSample > 0
+        && llSamplesCount % lFailEveryNthSample == 0
+        && SUCCEEDED(*phrStatus))
+    {
+        *phrStatus = m_lFaultHResult;
+    }
+
+    // The type is read again from the source reader, so the frames are reconfigured for the same type
+    if (lChangeFormatEveryNthSample > 0
+        && llSamplesCount % lChangeFormatEveryNthSample == 0)
+    {
+        *pdwStreamFlags |= MF_SOURCE_READERF_CURRENTMEDIATYPECHANGED;
+    }
+
+    if (lSampleDelayMs > 0)
+    {
+        Sleep(static_cast<DWORD>(lSampleDelayMs));
+    }
+}
+
+// --------------------------------------------------------------------
+// GetIsZeroCopySample
+//
+// The locked sample is the frame as is when nothing converts it on the
+//  way: no caller destination to write, no resampling, and for GRAY8
+//  a native Y plane, as the luma of YUY2 has to be extracted.
+// --------------------------------------------------------------------
+
+bool CSourceReader::GetIsZeroCopySample(const FRAME_METADATA &metadata) const
+{
+    return m_bZeroCopy
+        && !metadata.pDestination
+        && !m_resampler.GetIsConfigured()
+        && !(m_outputFormat == PIXEL_FORMAT::GRAY8 && m_nativeSubtype == MFVideoFormat_YUY2);
+}
+
+// --------------------------------------------------------------------
+// GetIsSampleDecimated
+//
+// Decides if the sample is dropped for decimation. For the target
+//  rate, the delivery times advance by the min frame interval, so the
+//  average rate holds even if it doesn't divide the device rate, with
+//  half a frame of tolerance for jitter in the timestamps.
+// --------------------------------------------------------------------
+
+bool CSourceReader::GetIsSampleDecimated(LONGLONG llTimestamp)
+{
+    // Every Nth sample
+    if (m_frameDecimation > 1)
+    {
+        const bool bIsDecimated{ (m_decimationCounter % m_frameDecimation) != 0 };
+        m_decimationCounter++;
+
+        if (bIsDecimated) { return true; }
+    }
+
+    // Target rate
+    if (m_llMinFrameInterval > 0)
+    {
+        const LONGLONG llTolerance{ m_llFrameDuration / 2 };
+
+        if (m_llNextDeliveryTime >= 0 && llTimestamp < m_llNextDeliveryTime - llTolerance)
+        {
+            return true;
+        }
+
+        // Restart the schedule from this sample if it fell behind, e.g. after a gap in the stream
+        m_llNextDeliveryTime = (m_llNextDeliveryTime >= 0 && llTimestamp - m_llNextDeliveryTime < m_llMinFrameInterval)
+            ? m_llNextDeliveryTime + m_llMinFrameInterval
+            : llTimestamp + m_llMinFrameInterval;
+    }
+
+    return false;
+}
+
+// --------------------------------------------------------------------
+// Reconnect
+//
+// Recreates the media source and the source reader for the device
+//  that arrived again, and resumes with the kept native type, the
+//  processor and the buffers, skipping the negotiation done on
+//  initialization. Pending reads of the lost device are dropped, the
+//  consumer issues new reads once notified.
+// --------------------------------------------------------------------
+
+void CSourceReader::Reconnect()
+{
+    HRESULT hr{ S_OK };
+    std::string exWhatString{};
+
+    LARGE_INTEGER now{};
+    LARGE_INTEGER frequency{};
+    LONGLONG llDowntime{ 0 };
+
+    CTraceSpan span{ "Reconnect", this };
+
+    {
+        CTraceSpan waitSpan{ "ExclusiveLockWait", this };
+        AcquireSRWLockExclusive(&m_srwLock);
+    }
+
+    InterlockedExchange(&m_lIsReconnectScheduled, FALSE);
+
+    // Closed or already available
+    if (GetState() != READER_STATE::LOST || !m_pNativeMediaType)
+    {
+        ReleaseSRWLockExclusive(&m_srwLock);
+        return;
+    }
+
+    // Release the lost source
+    if (m_pMediaSource)
+    {
+        m_pMediaSource->Shutdown();
+    }
+
+    SafeRelease(&m_pSourceReader);
+    SafeRelease(&m_pMediaSource);
+
+    m_pendingReads.Clear();
+    if (m_pCounters) { m_pCounters->ResetQueueDepth(); }
+
+    try
+    {
+        CreateSourceReader(m_wstrDeviceSymbolicLink.c_str());
+    }
+    catch (const std::system_error &ex)
+    {
+        hr = ex.code().value();
+
+        exWhatString = std::string{ MAKE_EX_STR("Error occurred while recreating the source reader for the device.") }
+            + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+
+        goto done;
+    }
+
+    hr = m_pSourceReader->SetCurrentMediaType(static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM), nullptr, m_pNativeMediaType);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFSourceReader::SetCurrentMediaType().");
+
+    // Drop what the processor holds from the lost stream
+    if (m_pProcessor)
+    {
+        hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_COMMAND_FLUSH, 0);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFTransform::ProcessMessage().");
+    }
+
+    m_llLastSampleTime = -1;
+    m_llMinLatency = -1;
+    m_staleSamplesCount = 0;
+    m_latestReadFailuresCount = 0;
+    m_decimationCounter = 0;
+    m_llNextDeliveryTime = -1;
+
+    // Closing doesn't wait for the lock to close the reader
+    if (!TransitionState(READER_STATE::LOST, READER_STATE::AVAILABLE))
+    {
+        hr = MF_E_SHUTDOWN;
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "The reader was closed while reconnecting.");
+    }
+
+    if (m_pCounters) { m_pCounters->AddOpen(); }
+
+    if (m_bPublishLatestFrame)
+    {
+        hr = IssueLatestFrameRead();
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred while issuing the read for the latest frame.");
+    }
+
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    llDowntime = static_cast<LONGLONG>(
+        static_cast<double>(now.QuadPart - InterlockedCompareExchange64(&m_llDeviceLostTime, 0, 0)) * 10000000.0 / static_cast<double>(frequency.QuadPart)
+        );
+
+    _RPTW2(_CRT_WARN, L"Reconnected to '%s' after %lld (100ns).\n", m_wstrDeviceSymbolicLink.c_str(), llDowntime);
+
+done:
+    if (FAILED(hr))
+    {
+        // Stay unavailable and wait for the next arrival
+        TransitionState(READER_STATE::AVAILABLE, READER_STATE::LOST);
+
+        if (m_pMediaSource)
+        {
+            m_pMediaSource->Shutdown();
+        }
+
+        SafeRelease(&m_pSourceReader);
+        SafeRelease(&m_pMediaSource);
+
+        _RPT1(_CRT_WARN, "Reconnect failed: %s\n", exWhatString.c_str());
+    }
+
+    ReleaseSRWLockExclusive(&m_srwLock);
+
+    // Outside the lock, so the consumer can issue reads from the callback
+    if (SUCCEEDED(hr) && m_pDeviceReconnectedCallback)
+    {
+        m_pDeviceReconnectedCallback(llDowntime);
+    }
+}
+
+// --------------------------------------------------------------------
+// ProcessorProcessOutput
+//
+// Runs on every sample, so failures are returned instead of thrown,
+//  with `*ppszExWhat` set to where the failure occurred. The string
+//  of the error is built by the caller only if it is passed on.
+// --------------------------------------------------------------------
+
+HRESULT CSourceReader::ProcessorProcessOutput(
+    DWORD dwOutputStreamID,
+    IMFSample **ppOutputSample,
+    const char **ppszExWhat,
+    bool bDrain
+    )
+{
+    assert(m_pProcessor != nullptr);
+    assert(ppszExWhat != nullptr);
+    assert(!bDrain || ppOutputSample == nullptr); // You can't set ppOutputSample for drain.
+
+    CTraceSpan span{ "ProcessOutput", this };
+
+    HRESULT hr{ S_OK };
+    const char *pszExWhat{ nullptr };
+
+    IMFMediaBuffer *pOutputBuffer{ nullptr };
+    IMFSample *pOutputSample{ nullptr };
+
+    // NOTE: why did we use `bDrain`?
+    //      I don't encourage exceptions as a part of the normal control flow,
+    //  so, catching an exception for a normal `Drain` operation is not favorable.
+    //  This lead me to add a flag which if set the function just drains the processor.
+    //  I added this flag to the function instead of creating a new one because of the shared logic.
+    //  The drain ends with `MF_E_TRANSFORM_NEED_MORE_INPUT` on every sample, so it is a success here.
+
+    if (bDrain)
+    {
+        hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_NOTIFY_END_OF_STREAM, 0);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFTransform::ProcessMessage().");
+
+        hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_COMMAND_DRAIN, 0);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFTransform::ProcessMessage().");
+    }
+
+    do {
+        DWORD dwProcessOutputStatus{ 0 };
+        MFT_OUTPUT_STREAM_INFO outputStreamInfo{ 0 };
+        MFT_OUTPUT_DATA_BUFFER outputDataBuffer{ 0 };
+
+        hr = m_pProcessor->GetOutputStreamInfo(dwOutputStreamID, &outputStreamInfo);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFTransform::GetOutputStreamInfo().");
+
+        // Check if the sample should be allocated by us
+        if ((outputStreamInfo.dwFlags & (MFT_OUTPUT_STREAM_PROVIDES_SAMPLES | MFT_OUTPUT_STREAM_CAN_PROVIDE_SAMPLES))
+            != (MFT_OUTPUT_STREAM_PROVIDES_SAMPLES | MFT_OUTPUT_STREAM_CAN_PROVIDE_SAMPLES))
+        {
+            // The buffer is created once and reused for every sample, as the output sample is released
+            //  before the next one is processed, and drained samples are released right away.
+            DWORD cbMaxLength{ 0 };
+            if (m_pProcessorOutputBuffer
+                && (FAILED(m_pProcessorOutputBuffer->GetMaxLength(&cbMaxLength)) || cbMaxLength < outputStreamInfo.cbSize))
+            {
+                SafeRelease(&m_pProcessorOutputBuffer);
+            }
+
+            if (!m_pProcessorOutputBuffer)
+            {
+                hr = MFCreateAlignedMemoryBuffer(outputStreamInfo.cbSize, outputStreamInfo.cbAlignment, &m_pProcessorOutputBuffer);
+                CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during MFCreateAlignedMemoryBuffer().");
+            }
+
+            pOutputBuffer = m_pProcessorOutputBuffer;
+            pOutputBuffer->AddRef();
+
+            hr = pOutputBuffer->SetCurrentLength(0);
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFMediaBuffer::SetCurrentLength().");
+
+            // Create the output sample
+            hr = MFCreateSample(&pOutputSample);
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during MFCreateSample().");
+
+            // Add buffer to the sample
+            hr = pOutputSample->AddBuffer(pOutputBuffer);
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFSample::AddBuffer().");
+        }
+
+        // Get the output
+        outputDataBuffer.dwStreamID = dwOutputStreamID;
+        outputDataBuffer.pSample = pOutputSample;
+        outputDataBuffer.dwStatus = 0;
+        outputDataBuffer.pEvents = nullptr;
+        hr = m_pProcessor->ProcessOutput(0, 1, &outputDataBuffer, &dwProcessOutputStatus);
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFTransfer::ProcessOutput().");
+
+        // set the output pointer if the caller is willing to receive the sample, and is available to begin with!
+        // Note that we assert on if bDrain is true, ppOutputSample has to be nullptr
+        if (ppOutputSample
+            && ((outputDataBuffer.dwStatus & MFT_OUTPUT_DATA_BUFFER_NO_SAMPLE) != MFT_OUTPUT_DATA_BUFFER_NO_SAMPLE))
+        {
+            *ppOutputSample = pOutputSample;
+            (*ppOutputSample)->AddRef();
+
+            // Here we break out of the loop as ppOutputSample won't be set in case of a drain process,
+            //  so we break out otherwise to not release it twice.
+            break;
+        }
+
+        // Release for next iteration in case of drain
+        SafeRelease(&pOutputSample);
+        SafeRelease(&pOutputBuffer);
+    } while (bDrain); // If we are in drain mode, loop till we get `MF_E_TRANSFORM_NEED_MORE_INPUT` or others.
+
+
+
+done:
+    SafeRelease(&pOutputSample);
+    SafeRelease(&pOutputBuffer);
+
+    if (hr == MF_E_TRANSFORM_NEED_MORE_INPUT && bDrain) { return S_OK; }
+
+    if (FAILED(hr)) { *ppszExWhat = pszExWhat; }
+
+    return hr;
+}
+
+// --------------------------------------------------------------------
+// ProcessorProcessSample
+//
+// Returns failures like `ProcessorProcessOutput`. The processor is
+//  drained even after a failure, and the first failure is returned.
+// --------------------------------------------------------------------
+
+HRESULT CSourceReader::ProcessorProcessSample(
+    DWORD dwStreamID,
+    IMFSample *pInputSample,
+    IMFSample **ppOutputSample,
+    const char **ppszExWhat
+)
+{
+    assert(m_pProcessor != nullptr);
+    assert(pInputSample != nullptr);
+    assert(ppOutputSample != nullptr);
+    assert(ppszExWhat != nullptr);
+
+    HRESULT hr{ S_OK };
+    HRESULT hrDrain{ S_OK };
+    const char *pszExWhat{ nullptr };
+    const char *pszDrainExWhat{ nullptr };
+
+    IMFSample *pOutputSample{ nullptr };
+
+    hr = m_pProcessor->ProcessMessage(MFT_MESSAGE_NOTIFY_BEGIN_STREAMING, 0);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, pszExWhat, "Error occurred during IMFTransform::ProcessMessage().");
+
+    {
+        CTraceSpan inputSpan{ "ProcessInput", this };
+        hr = m_pProcessor->ProcessInput(dwStreamID, pInputSample, 0);
+    }
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, finalizeAndDrain, pszExWhat, "Error occurred during IMFTransform::ProcessInput().");
+
+    hr = ProcessorProcessOutput(dwStreamID, &pOutputSample, &pszExWhat);
+    if (FAILED(hr)) { goto finalizeAndDrain; }
+
+    if (ppOutputSample)
+    {
+        *ppOutputSample = pOutputSample;
+        (*ppOutputSample)->AddRef();
+    }
+
+finalizeAndDrain:
+    hrDrain = ProcessorProcessOutput(dwStreamID, nullptr, &pszDrainExWhat, true);
+    if (FAILED(hrDrain) && SUCCEEDED(hr))
+    {
+        hr = hrDrain;
+        pszExWhat = pszDrainExWhat;
+    }
+
+done:
+    SafeRelease(&pOutputSample);
+
+    if (FAILED(hr)) { *ppszExWhat = pszExWhat; }
+
+    return hr;
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// SetReadFrameSuccessCallback
+// --------------------------------------------------------------------
+
+void CSourceReader::SetReadFrameSuccessCallback(READ_SAMPLE_SUCCESS_HANDLER pCallback)
+{
+    m_pReadSampleSuccessCallback = pCallback;
+}
+
+// --------------------------------------------------------------------
+// SetReadFrameFailCallback
+// --------------------------------------------------------------------
+
+void CSourceReader::SetReadFrameFailCallback(READ_SAMPLE_FAIL_HANDLER pCallback)
+{
+    m_pReadSampleFailCallback = pCallback;
+}
+
+// --------------------------------------------------------------------
+// SetDeviceReconnectedCallback
+// --------------------------------------------------------------------
+
+void CSourceReader::SetDeviceReconnectedCallback(DEVICE_RECONNECTED_HANDLER pCallback)
+{
+    m_pDeviceReconnectedCallback = pCallback;
+}
+
+// --------------------------------------------------------------------
+// SetFormatChangedCallback
+// --------------------------------------------------------------------
+
+void CSourceReader::SetFormatChangedCallback(FORMAT_CHANGED_HANDLER pCallback)
+{
+    m_pFormatChangedCallback = pCallback;
+}
+
+// --------------------------------------------------------------------
+// TryGetLatestFrame
+//
+// The buffers are freed only with the reader, so the frame can be
+//  taken without the lock, even while the reader is being closed.
+// --------------------------------------------------------------------
+
+bool CSourceReader::TryGetLatestFrame(TRIPLE_BUFFER_FRAME *pFrame)
+{
+    // The triple buffer gives back the frame of the previous take, so it has a single consumer
+    if (InterlockedCompareExchange(&m_lIsTakingLatestFrame, TRUE, FALSE) != FALSE)
+    {
+        throw std::logic_error{ "The latest frame is being taken on another thread." };
+    }
+
+    const bool bIsTaken{ m_latestFrames.TryTakeLatest(pFrame) };
+
+    InterlockedExchange(&m_lIsTakingLatestFrame, FALSE);
+
+    return bIsTaken;
+}
+
+// --------------------------------------------------------------------
+// SetCounters
+//
+// Sets the health counters updated by the reader, a reference is held
+//  until the reader is destroyed. Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetCounters(CReaderCounters *pCounters)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Counters can't be set after the source reader has been initialized." };
+    }
+
+    if (pCounters) { pCounters->AddRef(); }
+
+    SafeRelease(&m_pCounters);
+    m_pCounters = pCounters;
+}
+
+// --------------------------------------------------------------------
+// GetFrameStride
+//
+// Stride of the frames written into the reader's own buffers, the rows
+//  are padded to a cache line. The buffers start at a page, so every
+//  row starts at a cache line.
+// --------------------------------------------------------------------
+
+LONG CSourceReader::GetFrameStride() const
+{
+    const UINT32 cbRow{ m_frameWidth * GetBytesPerPixel(m_outputFormat) };
+
+    return static_cast<LONG>((cbRow + (FRAME_STRIDE_ALIGNMENT - 1)) & ~static_cast<UINT32>(FRAME_STRIDE_ALIGNMENT - 1));
+}
+
+// --------------------------------------------------------------------
+// SetFrameDecimation
+//
+// Sets the decimation of the samples, keeping every Nth sample, and a
+//  sample per min frame interval in 100-nanosecond units. Zeros keep
+//  every sample. Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetFrameDecimation(UINT32 everyNthFrame, LONGLONG llMinFrameInterval)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Frame decimation can't be set after the source reader has been initialized." };
+    }
+
+    if (llMinFrameInterval < 0)
+    {
+        throw std::invalid_argument{ "Min frame interval can't be negative." };
+    }
+
+    m_frameDecimation = everyNthFrame;
+    m_llMinFrameInterval = llMinFrameInterval;
+}
+
+// --------------------------------------------------------------------
+// SetPublishLatestFrame
+//
+// Sets the latest frame mode, where the reader reads continuously and
+//  publishes each frame for `TryGetLatestFrame`, instead of reading on
+//  request. Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetPublishLatestFrame(bool bPublishLatestFrame)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Latest frame mode can't be set after the source reader has been initialized." };
+    }
+
+    m_bPublishLatestFrame = bPublishLatestFrame;
+}
+
+// --------------------------------------------------------------------
+// SetFaultInjection
+//
+// Sets the faults injected into the next samples, can be set at any
+//  time from any thread, including the callbacks, as no lock is taken.
+//  A sample handled meanwhile may see some of the new faults before
+//  the others. A failure that isn't a failing HRESULT is replaced with
+//  `E_FAIL`, so the injected sample always fails.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetFaultInjection(const FAULT_INJECTION &faults)
+{
+    // Counts above the range of the interlocked fields are as good as never
+    const LONG lFailEveryNthSample{ static_cast<LONG>((std::min)(faults.failEveryNthSample, static_cast<UINT32>(MAXLONG))) };
+    const LONG lChangeFormatEveryNthSample{ static_cast<LONG>((std::min)(faults.changeFormatEveryNthSample, static_cast<UINT32>(MAXLONG))) };
+    const LONG lSampleDelayMs{ static_cast<LONG>((std::min)(faults.dwSampleDelayMs, static_cast<DWORD>(MAXLONG))) };
+
+    InterlockedExchange(&m_lFaultHResult, (lFailEveryNthSample > 0 && SUCCEEDED(faults.hrFailure)) ? E_FAIL : faults.hrFailure);
+    InterlockedExchange(&m_lSampleDelayMs, lSampleDelayMs);
+    InterlockedExchange64(&m_llFaultSamplesCount, 0);
+    InterlockedExchange(&m_lChangeFormatEveryNthSample, lChangeFormatEveryNthSample);
+    InterlockedExchange(&m_lFailEveryNthSample, lFailEveryNthSample);
+}
+
+// --------------------------------------------------------------------
+// SetUseNegotiationCache
+//
+// Sets if the negotiated media type is read from and saved into the
+//  negotiation cache. Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetUseNegotiationCache(bool bUseNegotiationCache)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Negotiation cache can't be set after the source reader has been initialized." };
+    }
+
+    m_bUseNegotiationCache = bUseNegotiationCache;
+}
+
+// --------------------------------------------------------------------
+// SetZeroCopy
+//
+// Sets the zero copy mode, where a frame that needs no conversion is
+//  passed to the success callback as the locked buffer of the sample.
+//  Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetZeroCopy(bool bZeroCopy)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Zero copy mode can't be set after the source reader has been initialized." };
+    }
+
+    m_bZeroCopy = bZeroCopy;
+}
+
+// --------------------------------------------------------------------
+// SetLowLatency
+//
+// Sets the low latency mode, where only fresh samples are delivered.
+//  A sample older than the max frame age is dropped, zero max frame age
+//  is a frame duration of the device. Has to be set before
+//  initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetLowLatency(bool bLowLatency, LONGLONG llMaxFrameAge)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Low latency mode can't be set after the source reader has been initialized." };
+    }
+
+    if (llMaxFrameAge < 0)
+    {
+        throw std::invalid_argument{ "Max frame age can't be negative." };
+    }
+
+    m_bLowLatency = bLowLatency;
+    m_llRequestedMaxFrameAge = llMaxFrameAge;
+}
+
+// --------------------------------------------------------------------
+// SetOutputSize
+//
+// Sets the size of the frames passed to the consumer, the frames are
+//  resampled from the device size using the filter. Zeros keep the
+//  device size. Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetOutputSize(UINT32 width, UINT32 height, RESAMPLE_FILTER filter)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Output size can't be set after the source reader has been initialized." };
+    }
+
+    if ((width == 0) != (height == 0))
+    {
+        throw std::logic_error{ "Output width and height have to be both set or both zero." };
+    }
+
+    m_requestedOutputWidth = width;
+    m_requestedOutputHeight = height;
+    m_resampleFilter = filter;
+}
+
+// --------------------------------------------------------------------
+// SetOrientation
+//
+// Sets the orientation of the frames passed to the consumer, applied
+//  while writing the frame with no extra pass. The mirror and the
+//  vertical flip are applied before the clockwise rotation.
+//  Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetOrientation(ROTATION rotation, bool bMirror, bool bFlipVertical)
 {
-    m_pReadSampleSuccessCallback = pCallback;
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Orientation can't be set after the source reader has been initialized." };
+    }
+
+    m_rotation = rotation;
+    m_bMirror = bMirror;
+    m_bFlipVertical = bFlipVertical;
 }
 
 // --------------------------------------------------------------------
-// SetReadFrameFailCallback
+// SetOutputPixelFormat
+//
+// Sets the pixel format of the frames passed to the consumer, BGRA32
+//  converted by the processor, or GRAY8 read from the luma of a native
+//  YUV type. Has to be set before initialization.
 // --------------------------------------------------------------------
 
-void CSourceReader::SetReadFrameFailCallback(READ_SAMPLE_FAIL_HANDLER pCallback)
+void CSourceReader::SetOutputPixelFormat(PIXEL_FORMAT format)
 {
-    m_pReadSampleFailCallback = pCallback;
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Output pixel format can't be set after the source reader has been initialized." };
+    }
+
+    if (format != PIXEL_FORMAT::BGRA32 && format != PIXEL_FORMAT::GRAY8)
+    {
+        throw std::invalid_argument{ "Output pixel format has to be BGRA32 or GRAY8." };
+    }
+
+    m_outputFormat = format;
+}
+
+// --------------------------------------------------------------------
+// SetTensorFormat
+//
+// Sets the tensor written from each frame, nullptr for none. The frame
+//  is resampled for the tensor, so it can't be set with an output size.
+//  The tensor is read from the native samples if they are YUV, or else
+//  from the frame. Has to be set before initialization.
+// --------------------------------------------------------------------
+
+void CSourceReader::SetTensorFormat(const TENSOR_FORMAT *pFormat)
+{
+    if (GetIsInitialized())
+    {
+        throw std::logic_error{ "Tensor format can't be set after the source reader has been initialized." };
+    }
+
+    m_bWriteTensor = (pFormat != nullptr);
+    m_tensorFormat = pFormat ? *pFormat : TENSOR_FORMAT{};
 }
 
 // --------------------------------------------------------------------
 // ReadFrame
+//
+// Issues a read for the next frame. If a destination is passed, the
+//  frame is written directly into it instead of the reader's buffer.
+//  The destination has to stay valid until its callback is called
+//  or the reader is closed.
 // --------------------------------------------------------------------
 
-void CSourceReader::ReadFrame()
+void CSourceReader::ReadFrame(const IMAGE_VIEW *pDestination)
 {
-    _RPT1(_CRT_WARN, "Waiting to enter critical section from %s.\n", STRINGIZE(ReadFrame));
+    CTraceSpan span{ "ReadFrame", this };
 
-    EnterCriticalSection(&m_criticalSection);
+    // On the callback thread, the lock is already held for the sample being handled
+    const bool bIsCallbackThread{ GetIsCallbackThread() };
 
-    _RPT1(_CRT_WARN, "Entered critical section in %s.\n", STRINGIZE(ReadFrame));
+    if (!bIsCallbackThread)
+    {
+        CTraceSpan waitSpan{ "SharedLockWait", this };
+        AcquireSRWLockShared(&m_srwLock);
+    }
+
+    // Reads are issued from one thread at a time, as the single producer of the pending reads.
+    //  The issuers only wait for each other to push and issue, which doesn't wait for anything.
+    {
+        CTraceSpan waitSpan{ "IssueLockWait", this };
+        AcquireSRWLockExclusive(&m_srwIssueLock);
+    }
 
-    if (!m_bIsInitialized)
+    if (GetState() == READER_STATE::UNINITIALIZED)
     {
-        LeaveCriticalSection(&m_criticalSection);
+        LeaveReadFrame(bIsCallbackThread);
         throw std::logic_error{ "Source reader hasn't been initialized." };
     }
 
     if (!m_pSourceReader)
     {
-        LeaveCriticalSection(&m_criticalSection);
+        LeaveReadFrame(bIsCallbackThread);
         throw std::logic_error{ "Instance's source reader is null." };
     }
 
+    if (GetState() == READER_STATE::CLOSED)
+    {
+        LeaveReadFrame(bIsCallbackThread);
+        throw std::logic_error{ "Source reader has been closed." };
+    }
+
     if (!GetIsMediaFoundationStarted())
     {
-        LeaveCriticalSection(&m_criticalSection);
+        LeaveReadFrame(bIsCallbackThread);
         throw std::logic_error{ "Media Foundation hasn't started." };
     }
 
-    if (!m_bIsAvailable)
+    if (GetState() != READER_STATE::AVAILABLE)
     {
-        LeaveCriticalSection(&m_criticalSection);
+        LeaveReadFrame(bIsCallbackThread);
         throw std::system_error{ static_cast<int>(LEANCAMERACAPTURE_E_DEVICELOST), std::system_category(), "Capture device isn't available." };
     }
 
+    if (m_bPublishLatestFrame)
+    {
+        LeaveReadFrame(bIsCallbackThread);
+        throw std::logic_error{ "Reads are issued by the source reader in latest frame mode." };
+    }
+
+    if (pDestination)
+    {
+        if (!pDestination->pbScanline0)
+        {
+            LeaveReadFrame(bIsCallbackThread);
+            throw std::invalid_argument{ "Destination buffer is null." };
+        }
+
+        if (pDestination->format != m_outputFormat)
+        {
+            LeaveReadFrame(bIsCallbackThread);
+            throw std::invalid_argument{ "Destination pixel format doesn't match the output pixel format." };
+        }
+
+        if (pDestination->widthInPixels != m_frameWidth || pDestination->heightInPixels != m_frameHeight)
+        {
+            LeaveReadFrame(bIsCallbackThread);
+            throw std::invalid_argument{ "Destination dimensions don't match the frame dimensions." };
+        }
+
+        if (static_cast<UINT32>(std::abs(pDestination->lStride)) < m_frameWidth * GetBytesPerPixel(m_outputFormat))
+        {
+            LeaveReadFrame(bIsCallbackThread);
+            throw std::invalid_argument{ "Destination stride is smaller than a row of the frame." };
+        }
+    }
+
+    if (!m_pendingReads.TryPush(pDestination ? *pDestination : IMAGE_VIEW{}))
+    {
+        LeaveReadFrame(bIsCallbackThread);
+        throw std::system_error{ MF_E_NOTACCEPTING, std::system_category(), "Too many reads are pending." };
+    }
+
     HRESULT hr{ S_OK };
 
     hr = m_pSourceReader->ReadSample(
@@ -509,9 +2629,17 @@ void CSourceReader::ReadFrame()
             nullptr
             );
 
-    LeaveCriticalSection(&m_criticalSection);
+    // No callback will come for a failed read
+    if (FAILED(hr))
+    {
+        m_pendingReads.PopBack();
+    }
+    else if (m_pCounters)
+    {
+        m_pCounters->IncrementQueueDepth();
+    }
 
-    _RPT1(_CRT_WARN, "Left critical section in %s.\n", STRINGIZE(ReadFrame));
+    LeaveReadFrame(bIsCallbackThread);
 
     if (FAILED(hr))
     {
@@ -542,15 +2670,54 @@ void CSourceReader::InitializeForDevice(WCHAR *pwszDeviceSymbolicLink) noexcept(
     }
 
     // This method should be called only once
-    if (m_bIsInitialized)
+    if (GetIsInitialized())
     {
         throw std::logic_error{ "This instance of CSourceReader is already initialized for a device." };
     }
 
+    // Luma is written with no rotation or mirroring, only a vertical flip reverses the rows
+    if (m_outputFormat == PIXEL_FORMAT::GRAY8 && (m_rotation != ROTATION::NONE || m_bMirror))
+    {
+        throw std::logic_error{ "Rotation and mirroring aren't supported for GRAY8 output." };
+    }
+
+    // The locked sample is passed as is, so nothing may change the frame, and the triple buffer needs copies
+    if (m_bZeroCopy)
+    {
+        if (m_requestedOutputWidth != 0 || m_rotation != ROTATION::NONE || m_bMirror || m_bFlipVertical || m_bWriteTensor)
+        {
+            throw std::logic_error{ "Zero copy mode isn't supported with an output size, orientation, or tensor output." };
+        }
+
+        if (m_bPublishLatestFrame)
+        {
+            throw std::logic_error{ "Zero copy mode isn't supported in latest frame mode." };
+        }
+    }
+
+    // The tensor follows the rows of the frame, which are columns of the source for 90 and 270,
+    //  and it is written from the bands of BGRA rows unless it is read from the native samples
+    if (m_bWriteTensor)
+    {
+        if (m_outputFormat != PIXEL_FORMAT::BGRA32)
+        {
+            throw std::logic_error{ "Tensor output needs BGRA32 frames." };
+        }
+
+        if (m_rotation == ROTATION::CLOCKWISE_90 || m_rotation == ROTATION::CLOCKWISE_270)
+        {
+            throw std::logic_error{ "Tensor output isn't supported with 90 and 270 rotations." };
+        }
+
+        if (m_requestedOutputWidth != 0)
+        {
+            throw std::logic_error{ "Tensor output can't be set with an output size." };
+        }
+    }
+
     HRESULT hr{ S_OK };
     std::string exWhatString{};
 
-    IMFAttributes   *pAttributes{ nullptr };
     IMFMediaType    *pSourceOutputMediaType{ nullptr };
     IMFMediaType    *pProcessorOutputMediaType{ nullptr };
 
@@ -562,205 +2729,336 @@ void CSourceReader::InitializeForDevice(WCHAR *pwszDeviceSymbolicLink) noexcept(
 
     GUID sourceOutputSubtype{ GUID_NULL };
 
-    _RPTF1(_CRT_WARN, "Waiting to enter critical section from %s.\n", STRINGIZE(InitializeForDevice));
+    NEGOTIATION_CACHE_ENTRY negotiationCacheEntry{};
+    bool bIsNegotiationCached{ false };
+    bool bStoreNegotiationCacheEntry{ false };
+    DWORD nativeTypeIndex{ 0 };
 
-    EnterCriticalSection(&m_criticalSection);
+    LARGE_INTEGER openStartTime{};
+    QueryPerformanceCounter(&openStartTime);
 
-    _RPTF1(_CRT_WARN, "Entered critical section in %s.\n", STRINGIZE(InitializeForDevice));
+    {
+        CTraceSpan waitSpan{ "ExclusiveLockWait", this };
+        AcquireSRWLockExclusive(&m_srwLock);
+    }
 
     // ---
-    // --- Create media source for the symbolic link
+    // --- Create the media source and the source reader
     // ---
 
-    // Create attributes to pass to `MFCreateDeviceSource` with two slots
-    hr = MFCreateAttributes(&pAttributes, 2);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateAttributes().");
-
-    hr = pAttributes->SetGUID(MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE, MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE_VIDCAP_GUID);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetGUID().");
-
-    hr = pAttributes->SetString(MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE_VIDCAP_SYMBOLIC_LINK, pwszDeviceSymbolicLink);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetString().");
-
-    // Create the media source for the device
-    hr = MFCreateDeviceSource(pAttributes, &m_pMediaSource);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateDeviceSource().");
+    try
+    {
+        CreateSourceReader(pwszDeviceSymbolicLink);
+    }
+    catch (const std::system_error &ex)
+    {
+        hr = ex.code().value();
 
-    // Release the attributes for the next use
-    SafeRelease(&pAttributes);
+        exWhatString = std::string{ MAKE_EX_STR("Error occurred while creating the source reader for the device.") }
+            + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
 
-    _RPTFW1(_CRT_WARN, L"Device source created for '%s'.\n", pwszDeviceSymbolicLink);
+        goto done;
+    }
 
     // ---
-    // --- Create the source reader
+    // --- Find a native YUV type to read the luma from for GRAY8
     // ---
-    
-    // Create attributes to hold settings with 2 settings' slots
-    hr = MFCreateAttributes(&pAttributes, 2);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateAttributes().");
-
-    hr = pAttributes->SetUINT32(MF_READWRITE_DISABLE_CONVERTERS, true);
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetUINT32().");
 
-    // Set the an attribute slot for this class instance as callback for events e.g. OnReadSample
-    hr = pAttributes->SetUnknown(
-        MF_SOURCE_READER_ASYNC_CALLBACK,
-        this
-        );
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFAttributes::SetUnknown().");
+    if (m_outputFormat == PIXEL_FORMAT::GRAY8)
+    {
+        for (DWORD i = 0; ; i++)
+        {
+            hr = m_pSourceReader->GetNativeMediaType(
+                static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM),
+                i,
+                &pSourceOutputMediaType
+                );
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Could not find a native YUV type to read the luma from. IMFSourceReader::GetNativeMediaType().");
+
+            hr = pSourceOutputMediaType->GetGUID(MF_MT_SUBTYPE, &sourceOutputSubtype);
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFMediaType::GetGUID().");
+
+            if (GetIsLumaReadableSubtype(sourceOutputSubtype))
+            {
+                m_nativeSubtype = sourceOutputSubtype;
+
+                _RPTFW2(_CRT_WARN, L"Luma is read from media type '%d' on '%s'.\n", i, pwszDeviceSymbolicLink);
+                break;
+            }
+
+            // Free for the next iteration, in case of jump to `done`, a free will be performed there too
+            SafeRelease(&pSourceOutputMediaType);
+        }
+    }
 
-    // Create source reader for the media source using the attributes
-    hr = MFCreateSourceReaderFromMediaSource(
-        m_pMediaSource,
-        pAttributes,
-        &m_pSourceReader
-        );
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFCreateSourceReaderFromMediaSource().");
+    // ---
+    // --- Use the negotiation kept for the device if it still matches
+    // ---
 
-    // Release the attributes for the next use
-    SafeRelease(&pAttributes);
+    if (m_bUseNegotiationCache && m_outputFormat == PIXEL_FORMAT::BGRA32
+        && LookupNegotiationCacheEntry(pwszDeviceSymbolicLink, &negotiationCacheEntry)
+        && NegotiateFromCacheEntry(negotiationCacheEntry, pSourceOutputMediaType, pProcessorOutputMediaType))
+    {
+        bIsNegotiationCached = true;
 
-    _RPTFW1(_CRT_WARN, L"Source reader created for '%s'.\n", pwszDeviceSymbolicLink);
+        _RPTFW2(_CRT_WARN, L"Negotiation cache used for media type '%d' on '%s'.\n", negotiationCacheEntry.nativeTypeIndex, pwszDeviceSymbolicLink);
+    }
 
     // ---
     // --- Find the suitable codec for the video to RGB32
     // ---
 
-    processorInputInfo.guidMajorType = MFMediaType_Video;
-    
-    processorOutputInfo.guidMajorType = MFMediaType_Video;
-    processorOutputInfo.guidSubtype = OUTPUT_VIDEO_SUBTYPE; // Our output type is RGB32
-
-    // Loop through the available output types in the source reader and check
-    for (DWORD i = 0; ; i++)
+    if (!bIsNegotiationCached && m_outputFormat == PIXEL_FORMAT::BGRA32)
     {
-        hr = m_pSourceReader->GetNativeMediaType(
-            static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM),
-            i,
-            &pSourceOutputMediaType
-            );
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Could not find suitable codec converting into RGB32. IMFSourceReader::GetNativeMediaType().");
+        processorInputInfo.guidMajorType = MFMediaType_Video;
 
-        hr = pSourceOutputMediaType->GetGUID(MF_MT_SUBTYPE, &sourceOutputSubtype);
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFMediaType::GetGUID().");
+        processorOutputInfo.guidMajorType = MFMediaType_Video;
+        processorOutputInfo.guidSubtype = OUTPUT_VIDEO_SUBTYPE; // Our output type is RGB32
+
+        // Loop through the available output types in the source reader and check
+        for (DWORD i = 0; ; i++)
+        {
+            hr = m_pSourceReader->GetNativeMediaType(
+                static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM),
+                i,
+                &pSourceOutputMediaType
+                );
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Could not find suitable codec converting into RGB32. IMFSourceReader::GetNativeMediaType().");
+
+            hr = pSourceOutputMediaType->GetGUID(MF_MT_SUBTYPE, &sourceOutputSubtype);
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFMediaType::GetGUID().");
+
+            processorInputInfo.guidSubtype = sourceOutputSubtype;
+
+            _RPTFW2(_CRT_WARN, L"Checking transformer for media type '%d' on '%s'.\n", i, pwszDeviceSymbolicLink);
+
+            hr = MFTEnum(
+                MFT_CATEGORY_VIDEO_PROCESSOR, // Process from input to output type
+                0,              // Reserved
+                &processorInputInfo,     // Input type
+                &processorOutputInfo,    // Output type
+                nullptr,        // Reserved
+                &pMFTCLSIDs,
+                &MFTCLSIDsCount
+                );
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFTEnum().");
+
+            // We found a processor
+            if (MFTCLSIDsCount > 0)
+            {
+                nativeTypeIndex = i;
+
+                _RPTFW2(_CRT_WARN, L"Found transformer for media type '%d' on '%s'.\n", i, pwszDeviceSymbolicLink);
+                break;
+            }
+
+            // Free for the next iteration, in case of jump to `done`, a free will be performed there too
+            SafeRelease(&pSourceOutputMediaType);
+        }
 
-        processorInputInfo.guidSubtype = sourceOutputSubtype;
+        if (MFTCLSIDsCount == 0)
+        {
+            hr = E_UNEXPECTED;
+            CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Could not find proper video processor.");
+        }
 
-        _RPTFW2(_CRT_WARN, L"Checking transformer for media type '%d' on '%s'.\n", i, pwszDeviceSymbolicLink);
+        // Create the processor
+        hr = CoCreateInstance(pMFTCLSIDs[0], nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&m_pProcessor));
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred while creating video processor using CoCreateInstance().");
 
-        hr = MFTEnum(
-            MFT_CATEGORY_VIDEO_PROCESSOR, // Process from input to output type
-            0,              // Reserved
-            &processorInputInfo,     // Input type
-            &processorOutputInfo,    // Output type
-            nullptr,        // Reserved
-            &pMFTCLSIDs,
-            &MFTCLSIDsCount
-            );
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during MFTEnum().");
+        _RPTFW1(_CRT_WARN, L"MFT (Processor) created for '%s'.\n", pwszDeviceSymbolicLink);
 
-        // We found a processor
-        if (MFTCLSIDsCount > 0)
+        // Set the media type for the processor
+        try
         {
-            _RPTFW2(_CRT_WARN, L"Found transformer for media type '%d' on '%s'.\n", i, pwszDeviceSymbolicLink);
-            break;
+            SetVideoProcessorOutputForInputMediaType(m_pProcessor, pSourceOutputMediaType, OUTPUT_VIDEO_SUBTYPE, /*OUT*/ pProcessorOutputMediaType);
+        }
+        catch (const std::system_error &ex)
+        {
+            hr = ex.code().value();
+
+            exWhatString = std::string{ MAKE_EX_STR("Error occurred while preparing the video processor for the media types.") }
+                + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+
+            goto done;
         }
 
-        // Free for the next iteration, in case of jump to `done`, a free will be performed there too
-        SafeRelease(&pSourceOutputMediaType);
+        // Keep the negotiation for the next initialization
+        if (m_bUseNegotiationCache && DescribeMediaTypeForNegotiationCache(pSourceOutputMediaType, &negotiationCacheEntry))
+        {
+            negotiationCacheEntry.nativeTypeIndex = nativeTypeIndex;
+            negotiationCacheEntry.processorClsid = pMFTCLSIDs[0];
+            bStoreNegotiationCacheEntry = true;
+        }
     }
 
-    if (MFTCLSIDsCount == 0)
-    {
-        hr = E_UNEXPECTED;
-        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Could not find proper video processor.");
-    }
+    // Read the device in the native type the processor has been set for, or the luma is read from
+    hr = m_pSourceReader->SetCurrentMediaType(static_cast<DWORD>(MF_SOURCE_READER_FIRST_VIDEO_STREAM), nullptr, pSourceOutputMediaType);
+    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during IMFSourceReader::SetCurrentMediaType().");
 
-    // Create the processor
-    hr = CoCreateInstance(pMFTCLSIDs[0], nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&m_pProcessor));
-    CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred while creating video processor using CoCreateInstance().");
+    // Keep the native type for reconnecting to the device
+    m_pNativeMediaType = pSourceOutputMediaType;
+    m_pNativeMediaType->AddRef();
 
-    _RPTFW1(_CRT_WARN, L"MFT (Processor) created for '%s'.\n", pwszDeviceSymbolicLink);
+    // Save the symbolic link
+    m_wstrDeviceSymbolicLink = std::wstring{ pwszDeviceSymbolicLink };
 
-    // Set the media type for the processor
+    // Configure the frames for the types
     try
     {
-        SetVideoProcessorOutputForInputMediaType(m_pProcessor, pSourceOutputMediaType, OUTPUT_VIDEO_SUBTYPE, /*OUT*/ pProcessorOutputMediaType);
+        ConfigureFrames(pSourceOutputMediaType, pProcessorOutputMediaType);
     }
     catch (const std::system_error &ex)
     {
         hr = ex.code().value();
 
-        exWhatString = std::string{ MAKE_EX_STR("Error occurred while preparing the video processor for the media types.") }
+        exWhatString = std::string{ MAKE_EX_STR("Error occurred while configuring the frames for the media type.") }
             + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
 
         goto done;
     }
 
-    _RPTFW1(_CRT_WARN, L"Get frame width and height for '%s'.\n", pwszDeviceSymbolicLink);
+    // Available before the first read is issued, its callback waits for the lock
+    SetState(READER_STATE::AVAILABLE);
 
-    // Get the DefaultStride, Width, Height for the frames
-    try
+    // Start reading continuously
+    if (m_bPublishLatestFrame)
     {
-        GetWidthHeightDefaultStrideForMediaType(pProcessorOutputMediaType, &m_lSrcDefaultStride, &m_frameWidth, &m_frameHeight);
-
-        _RPTFW4(_CRT_WARN, L"Dimensions are w(%d) x h(%d) with stride(%d) on '%s'.\n", m_frameWidth, m_frameHeight, m_lSrcDefaultStride, pwszDeviceSymbolicLink);
+        hr = IssueLatestFrameRead();
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred while issuing the read for the latest frame.");
     }
-    catch (const std::system_error &ex)
-    {
-        hr = ex.code().value();
 
-        exWhatString = std::string{ MAKE_EX_STR("Error occurred during retrieving Width, Height, and DefualtStride for media type.") }
-        + "\nWith Error: " + ex.what() + " (" + std::to_string(ex.code().value()) + ")";
+    // The time to the first frame is measured from entering the initialization
+    if (m_pCounters) { m_pCounters->SetOpenStart(openStartTime.QuadPart, bIsNegotiationCached); }
 
-        goto done;
+    _RPTFW1(_CRT_WARN, L"Initialization completed for '%s'.\n", pwszDeviceSymbolicLink);
+
+done:
+    CoTaskMemFree(pMFTCLSIDs);
+    SafeRelease(&pSourceOutputMediaType);
+    SafeRelease(&pProcessorOutputMediaType);
+
+    // A reader that failed to initialize stays uninitialized
+    if (FAILED(hr)) { SetState(READER_STATE::UNINITIALIZED); }
+
+    ReleaseSRWLockExclusive(&m_srwLock);
+
+    // Freed outside the lock, as freeing takes it
+    if (FAILED(hr))
+    {
+        FreeResources();
+        throw std::system_error{ hr, std::system_category(), exWhatString };
     }
 
-    _RPTFW1(_CRT_WARN, L"Create frame buffer for '%s'.\n", pwszDeviceSymbolicLink);
+    // Write the cache file outside the lock
+    if (bStoreNegotiationCacheEntry)
+    {
+        StoreNegotiationCacheEntry(pwszDeviceSymbolicLink, negotiationCacheEntry);
+    }
 
-    // Create the buffer for the frames
+    // Set the capture device change notification handler outside the lock,
+    //  as the handlers are called under the notification lock.
     try
     {
-        m_frameBuffer = std::make_unique<BYTE[]>(static_cast<size_t>(m_frameWidth) * static_cast<size_t>(m_frameHeight) * OUTPUT_BYTES_PER_PIXEL);
+        AddCaptureDeviceChangeNotificationHandler(m_wstrDeviceSymbolicLink, &m_pDeviceChangeNotifHandler);
     }
     catch (const std::bad_alloc &/*ex*/)
     {
-        exWhatString = MAKE_EX_STR("Error occurred while allocating memory for the frame buffer.");
-        hr = E_OUTOFMEMORY;
-        goto done;
+        FreeResources();
+        throw std::system_error{ E_OUTOFMEMORY, std::system_category(), "Error occurred while adding the device change notification handler." };
     }
+}
 
-    // Save the symbolic link
-    m_wstrDeviceSymbolicLink = std::wstring{ pwszDeviceSymbolicLink };
+// ==============================
+// ====== Static Functions ======
+// ==============================
 
-    // Set the capture device change notification handler
-    AddCaptureDeviceChangeNotificationHandler(m_wstrDeviceSymbolicLink, &m_pDeviceChangeNotifHandler);
+// --------------------------------------------------------------------
+// ReconnectCallback [static]
+// --------------------------------------------------------------------
 
-    m_bIsInitialized = true;
-    m_bIsAvailable = true;
+VOID CALLBACK CSourceReader::ReconnectCallback(PTP_CALLBACK_INSTANCE /*pInstance*/, PVOID pContext)
+{
+    CSourceReader *pThis{ static_cast<CSourceReader *>(pContext) };
 
-    _RPTFW1(_CRT_WARN, L"Initialization completed for '%s'.\n", pwszDeviceSymbolicLink);
+    // Media Foundation objects are created on this thread
+    HRESULT hrCoInitialize{ CoInitializeEx(nullptr, COINIT_MULTITHREADED) };
 
-done:
-    CoTaskMemFree(pMFTCLSIDs);
-    SafeRelease(&pSourceOutputMediaType);
-    SafeRelease(&pProcessorOutputMediaType);
-    SafeRelease(&pAttributes);
-    if (FAILED(hr)) { FreeResources(); }
+    pThis->Reconnect();
 
-    LeaveCriticalSection(&m_criticalSection);
+    if (SUCCEEDED(hrCoInitialize)) { CoUninitialize(); }
 
-    _RPTF1(_CRT_WARN, "Left critical section in %s.\n", STRINGIZE(InitializeForDevice));
+    // Release the reference added on scheduling
+    pThis->Release();
+}
 
-    if (FAILED(hr))
+// --------------------------------------------------------------------
+// GetSampleLatency [static]
+//
+// The device reports the capture time in the system time of the QPC,
+//  the same clock as `MFGetSystemTime`. Returns -1 if not reported.
+// --------------------------------------------------------------------
+
+LONGLONG CSourceReader::GetSampleLatency(IMFSample *pSample)
+{
+    assert(pSample != nullptr);
+
+    UINT64 captureTime{ 0 };
+
+    if (FAILED(pSample->GetUINT64(MFSampleExtension_DeviceReferenceSystemTime, &captureTime)))
     {
-        throw std::system_error{ hr, std::system_category(), exWhatString };
+        return -1;
     }
+
+    const LONGLONG llLatency{ MFGetSystemTime() - static_cast<LONGLONG>(captureTime) };
+
+    return (std::max)(llLatency, 0LL);
 }
 
-// ==============================
-// ====== Static Functions ======
-// ==============================
+// --------------------------------------------------------------------
+// GetIsLumaReadableSubtype [static]
+//
+// The luma of these types is 8-bit and comes first, the whole Y plane
+//  for the planar types, and every other byte for YUY2.
+// --------------------------------------------------------------------
+
+bool CSourceReader::GetIsLumaReadableSubtype(const GUID &subtype)
+{
+    return subtype == MFVideoFormat_NV12
+        || subtype == MFVideoFormat_I420
+        || subtype == MFVideoFormat_IYUV
+        || subtype == MFVideoFormat_YUY2;
+}
+
+// --------------------------------------------------------------------
+// ResampleSourceRowsTask [static]
+// --------------------------------------------------------------------
+
+void CSourceReader::ResampleSourceRowsTask(void *pContext, UINT32 taskIndex)
+{
+    CTraceSpan span{ "ResampleSourceRows", pContext };
+    static_cast<CSourceReader *>(pContext)->ResampleSourceRows(taskIndex);
+}
+
+// --------------------------------------------------------------------
+// WriteFrameRowsTask [static]
+// --------------------------------------------------------------------
+
+void CSourceReader::WriteFrameRowsTask(void *pContext, UINT32 taskIndex)
+{
+    CTraceSpan span{ "WriteFrameRows", pContext };
+    static_cast<CSourceReader *>(pContext)->WriteFrameRows(taskIndex);
+}
+
+// --------------------------------------------------------------------
+// WriteTensorRowsTask [static]
+// --------------------------------------------------------------------
+
+void CSourceReader::WriteTensorRowsTask(void *pContext, UINT32 taskIndex)
+{
+    CTraceSpan span{ "WriteTensorRows", pContext };
+    static_cast<CSourceReader *>(pContext)->WriteTensorRows(taskIndex);
+}
 
 // --------------------------------------------------------------------
 // SetVideoProcessorInputAndOuputMediaTypes [static]
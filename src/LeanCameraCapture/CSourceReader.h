@@ -21,21 +21,70 @@ namespace LeanCameraCapture
 {
     namespace Native
     {
+        // ======================================
+        // ====== FRAME_METADATA Structure ======
+        // ======================================
+
+        /// <summary>
+        /// Metadata passed along with each frame.
+        /// </summary>
+        struct FRAME_METADATA
+        {
+            LONGLONG                llTimestamp;    // Sample time in 100-nanosecond units.
+            const FRAME_STATISTICS  *pStatistics;   // nullptr if the statistics aren't computed.
+            const IMAGE_VIEW        *pDestination;  // Caller destination the read was issued with, nullptr if none.
+            bool                    bIsWritten;     // True if a frame was written, false if the device delivered no sample.
+            LONGLONG                llLatency;      // From the capture to the callback in 100-nanosecond units,
+                                                    //  -1 if the device doesn't report the capture time.
+            const BYTE              *pbTensor;      // Tensor written from the frame, nullptr if no tensor format is set.
+            size_t                  cbTensor;
+            const IMAGE_VIEW        *pView;         // The frame passed to the callback with its signed stride, nullptr if none.
+            bool                    bIsZeroCopy;    // True if the view is the locked sample, valid only during the call.
+        };
+
+        // =======================================
+        // ====== FAULT_INJECTION Structure ======
+        // =======================================
+
+        /// <summary>
+        /// Faults injected into the samples of a reader, for reproducing the recovery paths. All zeros inject nothing.
+        /// </summary>
+        struct FAULT_INJECTION
+        {
+            UINT32      failEveryNthSample;     // The status of every Nth sample is replaced with `hrFailure`, zero for none.
+            HRESULT     hrFailure;
+            UINT32      changeFormatEveryNthSample; // Every Nth sample is flagged as if the device changed its type, zero for none.
+            DWORD       dwSampleDelayMs;        // Delay of each sample before it is handled, as a slow source.
+        };
+
+        /// <summary>
+        /// Lifecycle of a reader, checked without the lock on every callback.
+        /// </summary>
+        enum class READER_STATE : LONG
+        {
+            UNINITIALIZED,
+            AVAILABLE,      // Initialized, or reconnected.
+            LOST,           // The device was removed, or the reader failed, until reconnected.
+            CLOSED          // Resources are freed, or about to be.
+        };
+
         // ========================================
         // ====== Function Pointers typedefs ======
         // ========================================
 
         /// Handler definition for OnReadSample success callback
         ///
-        /// pbBuffer        => BYTE* points to the buffer
+        /// pbBuffer        => BYTE* points to the buffer, rows are `pMetadata->pView->lStride` bytes apart
         /// widthInPixels   => UINT32 tells the buffer width in pixels
         /// heightInPixels  => UINT32 tells the buffer height in pixels
         /// bytesPerPixel   => UINT32 tells how many bytes per pixel
+        /// pMetadata       => const FRAME_METADATA* for the frame, valid only during the call
         typedef void (*FP_READ_SAMPLE_SUCCESS_HANDLER)(
             const BYTE *pbBuffer,
             UINT32 widthInPixels,
             UINT32 heightInPixels,
-            UINT32 bytesPerPixel
+            UINT32 bytesPerPixel,
+            const FRAME_METADATA *pMetadata
             );
 
         typedef std::function<std::remove_pointer_t<FP_READ_SAMPLE_SUCCESS_HANDLER>> READ_SAMPLE_SUCCESS_HANDLER;
@@ -51,6 +100,28 @@ namespace LeanCameraCapture
 
         typedef std::function<std::remove_pointer_t<FP_READ_SAMPLE_FAIL_HANDLER>> READ_SAMPLE_FAIL_HANDLER;
 
+        /// Handler definition for reconnecting to the device after it was lost
+        ///
+        /// llDowntime  => LONGLONG time from losing the device to resuming, in 100-nanosecond units
+        typedef void (*FP_DEVICE_RECONNECTED_HANDLER)(
+            LONGLONG llDowntime
+            );
+
+        typedef std::function<std::remove_pointer_t<FP_DEVICE_RECONNECTED_HANDLER>> DEVICE_RECONNECTED_HANDLER;
+
+        /// Handler definition for reconfiguring the frames after the media type of the device changed
+        ///
+        /// widthInPixels           => UINT32 tells the new frame width in pixels
+        /// heightInPixels          => UINT32 tells the new frame height in pixels
+        /// llReconfigurationTime   => LONGLONG time taken to reconfigure, in 100-nanosecond units
+        typedef void (*FP_FORMAT_CHANGED_HANDLER)(
+            UINT32 widthInPixels,
+            UINT32 heightInPixels,
+            LONGLONG llReconfigurationTime
+            );
+
+        typedef std::function<std::remove_pointer_t<FP_FORMAT_CHANGED_HANDLER>> FORMAT_CHANGED_HANDLER;
+
         // ============================================
         // ====== CSourceReader Class Definition ======
         // ============================================
@@ -94,15 +165,61 @@ namespace LeanCameraCapture
             // ---
 
             void InitializeForDevice(WCHAR *pwszDeviceSymbolicLink) noexcept(false);
-            void ReadFrame() noexcept(false);
+            void ReadFrame(const IMAGE_VIEW *pDestination = nullptr) noexcept(false);
 
             void SetReadFrameSuccessCallback(READ_SAMPLE_SUCCESS_HANDLER pCallback);
             void SetReadFrameFailCallback(READ_SAMPLE_FAIL_HANDLER pCallback);
+            void SetDeviceReconnectedCallback(DEVICE_RECONNECTED_HANDLER pCallback);
+            void SetFormatChangedCallback(FORMAT_CHANGED_HANDLER pCallback);
+
+            void SetOutputSize(UINT32 width, UINT32 height, RESAMPLE_FILTER filter) noexcept(false);
+            void SetOrientation(ROTATION rotation, bool bMirror, bool bFlipVertical) noexcept(false);
+
+            void SetOutputPixelFormat(PIXEL_FORMAT format) noexcept(false);
+            PIXEL_FORMAT GetOutputPixelFormat() const { return m_outputFormat; }
+
+            void SetTensorFormat(const TENSOR_FORMAT *pFormat) noexcept(false);
+
+            void SetCounters(CReaderCounters *pCounters) noexcept(false);
+
+            void SetLowLatency(bool bLowLatency, LONGLONG llMaxFrameAge) noexcept(false);
+
+            void SetFrameDecimation(UINT32 everyNthFrame, LONGLONG llMinFrameInterval) noexcept(false);
+
+            void SetPublishLatestFrame(bool bPublishLatestFrame) noexcept(false);
+            bool GetPublishLatestFrame() const { return m_bPublishLatestFrame; }
+
+            void SetZeroCopy(bool bZeroCopy) noexcept(false);
+            bool GetZeroCopy() const { return m_bZeroCopy; }
+
+            /// <summary>
+            /// Take the latest published frame without waiting, from a single consumer thread at a time,
+            ///  throws `std::logic_error` if another thread is taking it meanwhile. The frame stays valid
+            ///  until the next call or until the reader is destroyed, closing doesn't free it.
+            /// </summary>
+            bool TryGetLatestFrame(TRIPLE_BUFFER_FRAME *pFrame) noexcept(false);
+
+            void SetUseNegotiationCache(bool bUseNegotiationCache) noexcept(false);
+            bool GetUseNegotiationCache() const { return m_bUseNegotiationCache; }
+
+            void SetAutoReconnect(bool bAutoReconnect) { InterlockedExchange(&m_lAutoReconnect, bAutoReconnect ? TRUE : FALSE); }
+            bool GetAutoReconnect() const { return m_lAutoReconnect != FALSE; }
+
+            void SetFaultInjection(const FAULT_INJECTION &faults);
+
+            /// <summary>
+            /// Handle a removal or an arrival of the device as if it were notified, for testing the recovery.
+            /// </summary>
+            void SimulateDeviceChange(bool bIsArrival) { CaptureDeviceChangeNotificationHandler(bIsArrival); }
+
+            void SetComputeFrameStatistics(bool bCompute) { InterlockedExchange(&m_lComputeFrameStatistics, bCompute ? TRUE : FALSE); }
+            bool GetComputeFrameStatistics() const { return m_lComputeFrameStatistics != FALSE; }
 
             UINT32 GetFrameWidth() const { return m_frameWidth; }
             UINT32 GetFrameHeight() const { return m_frameHeight; }
-            bool GetIsInitialized() const { return m_bIsInitialized; }
-            bool GetIsAvailable() const { return m_bIsAvailable; }
+            LONG GetFrameStride() const;
+            bool GetIsInitialized() const { return GetState() != READER_STATE::UNINITIALIZED; }
+            bool GetIsAvailable() const { return GetState() == READER_STATE::AVAILABLE; }
 
             void Close() { FreeResources(); }
 
@@ -115,24 +232,95 @@ namespace LeanCameraCapture
         private:
             void FreeResources();
 
-            void ProcessorProcessOutput(
+            void ResolveOrientation();
+
+            void ConfigureFrames(
+                IMFMediaType *pSourceOutputMediaType,
+                IMFMediaType *pProcessorOutputMediaType
+                ) noexcept(false);
+
+            void ReconfigureForCurrentMediaType(LONGLONG *pllReconfigurationTime) noexcept(false);
+
+            HRESULT WriteOutputFrame(
+                const BYTE *pbScanline0,
+                LONG lStride,
+                BYTE *pbFrameScanline0,
+                LONG lFrameStride,
+                FRAME_METADATA *pMetadata
+                );
+
+            HRESULT WriteLumaFrame(
+                const BYTE *pbScanline0,
+                LONG lStride,
+                BYTE *pbFrameScanline0,
+                LONG lFrameStride,
+                FRAME_METADATA *pMetadata
+                );
+
+            HRESULT WriteTensorFromSample(IMFSample *pSample, FRAME_METADATA *pMetadata);
+
+            void PrepareWriteTasks() noexcept(false);
+            void RunWriteTasks(FP_WORKER_POOL_TASK pTask);
+
+            void ResampleSourceRows(UINT32 taskIndex);
+            void WriteFrameRows(UINT32 taskIndex);
+            void WriteTensorRows(UINT32 taskIndex);
+
+            HRESULT ProcessorProcessOutput(
                 DWORD dwOutputStreamID,
                 IMFSample **ppOutputSample,
+                const char **ppszExWhat,
                 bool bDrain = false
-                ) noexcept(false);
+                );
 
-            void ProcessorProcessSample(
+            HRESULT ProcessorProcessSample(
                 DWORD dwStreamID,
                 IMFSample *pInputSample,
-                IMFSample **ppOutputSample
-                ) noexcept(false);
+                IMFSample **ppOutputSample,
+                const char **ppszExWhat
+                );
+
+            void CaptureDeviceChangeNotificationHandler(bool bIsArrival);
 
-            void CaptureDeviceChangeNotificationHandler();
+            void CreateSourceReader(const WCHAR *pwszDeviceSymbolicLink) noexcept(false);
+
+            HRESULT IssueLatestFrameRead();
+
+            READER_STATE GetState() const { return static_cast<READER_STATE>(m_lState); }
+            void SetState(READER_STATE state) { InterlockedExchange(&m_lState, static_cast<LONG>(state)); }
+            bool TransitionState(READER_STATE from, READER_STATE to);
+
+            bool GetIsCallbackThread() const { return m_dwCallbackThreadId == GetCurrentThreadId(); }
+            void EnterCallback();
+            void LeaveCallback();
+            void LeaveReadFrame(bool bIsCallbackThread);
+
+            bool GetIsSampleDecimated(LONGLONG llTimestamp);
+            bool GetIsZeroCopySample(const FRAME_METADATA &metadata) const;
+            void InjectSampleFaults(HRESULT *phrStatus, DWORD *pdwStreamFlags);
+
+            bool NegotiateFromCacheEntry(
+                const NEGOTIATION_CACHE_ENTRY &entry,
+                IMFMediaType *&pSourceOutputMediaType,
+                IMFMediaType *&pProcessorOutputMediaType
+                );
+
+            void Reconnect();
 
             // ---
             // --- Static Methods
             // ---
 
+            static VOID CALLBACK ReconnectCallback(PTP_CALLBACK_INSTANCE pInstance, PVOID pContext);
+
+            static LONGLONG GetSampleLatency(IMFSample *pSample);
+
+            static bool GetIsLumaReadableSubtype(const GUID &subtype);
+
+            static void ResampleSourceRowsTask(void *pContext, UINT32 taskIndex);
+            static void WriteFrameRowsTask(void *pContext, UINT32 taskIndex);
+            static void WriteTensorRowsTask(void *pContext, UINT32 taskIndex);
+
             static void GetWidthHeightDefaultStrideForMediaType(
                 IMFMediaType *pMediaType,
                 LONG *plDefaultStride,
@@ -147,34 +335,195 @@ namespace LeanCameraCapture
                 IMFMediaType *&pOutputMediaType
                 ) noexcept(false);
 
+            /// <summary>
+            /// A band of rows of the frame written by one task, tasks write their bands in parallel.
+            /// </summary>
+            struct WRITE_TASK
+            {
+                UINT32                      rowBegin;               // Rows [rowBegin, rowEnd) of the scaled frame.
+                UINT32                      rowEnd;
+                HRESULT                     hr;
+                CFrameStatisticsAccumulator statisticsAccumulator;
+                std::unique_ptr<BYTE[]>     bandBuffer;             // Resampled band before transposing.
+            };
+
+            /// <summary>
+            /// The frame being written, shared by the tasks.
+            /// </summary>
+            struct WRITE_FRAME
+            {
+                const BYTE  *pbSourceScanline0;
+                LONG        lSourceStride;
+                BYTE        *pbDestinationScanline0;    // Already reversed if the destination rows are reversed.
+                LONG        lDestinationStride;
+                bool        bComputeStatistics;
+                bool        bWriteTensor;
+                bool        bStreamCopy;                // Copied rows bypass the cache, nothing reads them back while writing.
+                const BYTE  *pbNativeScanline0;         // Locked native sample the tensor is read from.
+                LONG        lNativeStride;
+            };
+
             /* === Data Members === */
         private:
             long                    m_nRefCount;            // Reference count for this COM object.
-            CRITICAL_SECTION        m_criticalSection;      // For thread safety.
-                                                            //  We should've used std::mutex
+            SRWLOCK                 m_srwLock;              // Shared while handling a sample or issuing a read,
+                                                            //  exclusive while initializing, reconfiguring, reconnecting or closing.
+                                                            //  We should've used std::shared_mutex
                                                             //  but its not supported under C++/CLI
                                                             //  and no need to hop into mental gymnastics to enable it.
 
-            bool                    m_bIsInitialized;       // True after the first initialization.
-            bool                    m_bIsAvailable;         // True after the first initialization
-                                                            //  and is set to false in case of error or device loss.
+            // `READER_STATE` changed with interlocked operations, the callbacks return early
+            //  without the lock unless the reader is available.
+            volatile LONG           m_lState;
+
+            // Thread handling a sample under the shared lock, zero if none. The lock isn't reentrant,
+            //  so reads issued from the callbacks don't take it again, and closing from the callbacks
+            //  is deferred until the sample is handled. A single thread, as the source reader calls
+            //  `OnReadSample` once at a time for the one stream read, which the single consumer
+            //  of `m_pendingReads`, the processor, the resampler and the frame buffer rely on too.
+            //  Enforced by the callback lock, held exclusively while handling a sample after `m_srwLock`.
+            volatile DWORD          m_dwCallbackThreadId;
+            SRWLOCK                 m_srwCallbackLock;
+            volatile LONG           m_lIsCloseDeferred;
 
             IMFMediaSource          *m_pMediaSource;        // Reference for the used capture device
             IMFSourceReader         *m_pSourceReader;       // Reader for samples from the capture device
-            IMFTransform            *m_pProcessor;          // Processing the input type into RGB32 output type
+            IMFTransform            *m_pProcessor;          // Processing the input type into RGB32 output type, null for GRAY8 output
+            IMFMediaBuffer          *m_pProcessorOutputBuffer;  // Reused for the output samples of the processor.
+            IMFMediaType            *m_pNativeMediaType;    // Native type read from the device, replaced when the device changes it
 
-            LONG                    m_lSrcDefaultStride;
-
-            UINT32                  m_frameWidth;
-            UINT32                  m_frameHeight;
+            // BGRA32 frames are converted by the processor, GRAY8 frames are read from the luma of the native
+            //  YUV samples with no processor. The Y plane of a planar type is already a GRAY8 frame.
+            PIXEL_FORMAT            m_outputFormat;
+            GUID                    m_nativeSubtype;        // Set on initialization for GRAY8 output.
 
-            std::unique_ptr<BYTE[]> m_frameBuffer;
+            LONG                    m_lSrcDefaultStride;
+            LONG                    m_lNativeDefaultStride; // Of the native type, for reading the tensor from the native samples.
+            UINT32                  m_nativeHeight;
+
+            LONGLONG                m_llFrameDuration;      // Nominal duration of a frame of the device, zero if unknown.
+            LONGLONG                m_llLastSampleTime;     // Timestamp of the last sample, -1 after a gap or before the first sample.
+
+            UINT32                  m_sourceWidth;          // Dimensions of the processor output, or the native type for GRAY8.
+            UINT32                  m_sourceHeight;
+
+            UINT32                  m_scaledWidth;          // Dimensions after resampling and before rotation,
+            UINT32                  m_scaledHeight;         //  same as the source unless an output size is set.
+
+            UINT32                  m_frameWidth;           // Dimensions of the frames passed to the consumer,
+            UINT32                  m_frameHeight;          //  the scaled dimensions swapped for 90 and 270 rotations.
+
+            FRAME_MEMORY            m_frameBuffer;
+            FRAME_MEMORY            m_lumaBuffer;           // Luma of YUY2 samples before resampling.
+
+            // Destinations of the issued reads in order, as each read gets exactly one `OnReadSample`.
+            //  Reads without a caller destination are queued with a null `pbScanline0`
+            //  and are written into `m_frameBuffer`. Reads are issued from one thread at a time,
+            //  which is the single producer of the queue, and the callback is its single consumer,
+            //  as the callbacks don't overlap, see `m_dwCallbackThreadId`.
+            CReadQueue              m_pendingReads;
+            SRWLOCK                 m_srwIssueLock;         // Exclusive while issuing a read, taken after `m_srwLock`,
+                                                            //  so an issuer never waits for `m_srwLock` while holding it.
+
+            // Requested output size, zeros for the source size. Resampling is configured on initialization.
+            UINT32                  m_requestedOutputWidth;
+            UINT32                  m_requestedOutputHeight;
+            RESAMPLE_FILTER         m_resampleFilter;
+            CResampler              m_resampler;
+
+            // Requested orientation, set before initialization.
+            ROTATION                m_rotation;
+            bool                    m_bMirror;
+            bool                    m_bFlipVertical;
+
+            // Orientation resolved on initialization into the operations done while writing the frame,
+            //  every orientation is a mirror of the rows or a transpose, with the rows of the source
+            //  or the destination visited in reverse through a negative stride.
+            bool                    m_bTranspose;
+            bool                    m_bMirrorRows;
+            bool                    m_bReverseSourceRows;
+            bool                    m_bReverseDestinationRows;
+
+            // Large frames are split into bands of rows written in parallel on the worker pool,
+            //  the number of tasks is set on initialization from the frame size and the processors count.
+            //  The pool is created only if there is more than one task.
+            std::unique_ptr<WRITE_TASK[]>   m_writeTasks;
+            UINT32                          m_writeTasksCount;
+            WRITE_FRAME                     m_writeFrame;
+            std::unique_ptr<CWorkerPool>    m_pWorkerPool;
+
+            // Statistics are computed while copying the frame, the flag is sampled once per frame
+            //  and set with an interlocked exchange, so it can be toggled from any thread.
+            //  Each task accumulates its own band.
+            volatile LONG               m_lComputeFrameStatistics;
+            FRAME_STATISTICS            m_frameStatistics;
+
+            // The tensor is read from the native samples in a single pass if they are YUV, or else it is
+            //  written from each band of the frame while it is still in cache, like the statistics.
+            //  Either way, the frame is resampled to the size the fit of the tensor needs instead of the output size.
+            bool                        m_bWriteTensor;
+            TENSOR_FORMAT               m_tensorFormat;
+            CTensorWriter               m_tensorWriter;
+
+            // Decimation drops samples before they are processed, keeping every Nth sample, then
+            //  keeping a sample per min frame interval from the timestamps, both are off by default.
+            UINT32                      m_frameDecimation;          // Zero or one for every sample.
+            LONGLONG                    m_llMinFrameInterval;       // Zero for no target rate.
+            UINT64                      m_decimationCounter;
+            LONGLONG                    m_llNextDeliveryTime;       // -1 before the first delivered sample.
+
+            // In latest frame mode, the reader keeps a read in flight by itself and publishes every frame
+            //  into the triple buffer, where the consumer takes the latest frame at its own rate.
+            bool                        m_bPublishLatestFrame;
+            CTripleBuffer               m_latestFrames;
+            volatile LONG               m_lIsTakingLatestFrame; // Keeps a single consumer of `m_latestFrames`.
+            UINT32                      m_latestReadFailuresCount;  // Failed samples in a row.
+
+            // In zero copy mode, a frame that needs no conversion is passed to the callback as the locked
+            //  buffer of the sample, top-down or bottom-up as the buffer is, instead of being copied.
+            bool                        m_bZeroCopy;
+
+            // In low latency mode, the source reader is created with `MF_LOW_LATENCY` and a sample that waited
+            //  in the queue of the source longer than the max frame age is dropped for a newer one. The age is the
+            //  latency of the sample over the lowest latency seen, which is the latency of a sample read right away.
+            bool                        m_bLowLatency;
+            LONGLONG                    m_llRequestedMaxFrameAge;   // Zero for a frame duration.
+            LONGLONG                    m_llMaxFrameAge;            // Resolved on initialization.
+            LONGLONG                    m_llMinLatency;             // -1 before the first sample with a capture time.
+            UINT32                      m_staleSamplesCount;        // Stale samples dropped in a row.
+
+            // The negotiation of the native type and the processor is kept on disk per device and driver
+            //  version, and validated against the device on initialization before being used.
+            bool                        m_bUseNegotiationCache;
+
+            // Reconnecting to the same device once it arrives again after being lost. The processor,
+            //  the native type and the buffers are kept, so only the source and the reader are recreated.
+            //  The flag is set with an interlocked exchange from the consumer's thread.
+            volatile LONG               m_lAutoReconnect;
+            volatile LONG               m_lIsReconnectScheduled;
+            volatile LONG64             m_llDeviceLostTime;     // Performance counter on losing the device, set from the
+                                                                //  notification thread and the callbacks with interlocked operations.
+
+            // Faults injected into the samples, none by default. Set with interlocked exchanges
+            //  instead of under the lock, so setting them never waits for a sample being handled.
+            volatile LONG               m_lFailEveryNthSample;
+            volatile LONG               m_lFaultHResult;
+            volatile LONG               m_lChangeFormatEveryNthSample;
+            volatile LONG               m_lSampleDelayMs;
+            volatile LONG64             m_llFaultSamplesCount;
+
+            // Health counters, shared with the consumer and kept across reopening.
+            //  A reference is held until the reader is destroyed, so a close deferred
+            //  by the callbacks still updates them after the consumer released its own.
+            CReaderCounters             *m_pCounters;
 
             // Here we store the symbolic link of the device we are using.
             std::wstring                m_wstrDeviceSymbolicLink;
 
             READ_SAMPLE_SUCCESS_HANDLER m_pReadSampleSuccessCallback;
             READ_SAMPLE_FAIL_HANDLER    m_pReadSampleFailCallback;
+            DEVICE_RECONNECTED_HANDLER  m_pDeviceReconnectedCallback;
+            FORMAT_CHANGED_HANDLER      m_pFormatChangedCallback;
 
             // Here we are keeping a lambda function that calls `CaptureDeviceChangeNotificationHandler`
             //  when invoked from the devincechnagenotif map. This is used to be able to pass a member function
@@ -0,0 +1,744 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CTensorWriter.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:10 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CTensorWriter.h"
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// FloatToHalf
+//
+// Rounds to the nearest even like F16C, values out of range become
+//  infinity and NaN stays NaN.
+// --------------------------------------------------------------------
+
+static UINT16 FloatToHalf(float value)
+{
+    UINT32 bits{ 0 };
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const UINT32 sign{ (bits >> 16) & 0x8000 };
+    bits &= 0x7FFFFFFF;
+
+    // 65536 and above, infinity, and NaN
+    if (bits >= 0x47800000)
+    {
+        return static_cast<UINT16>(sign | ((bits > 0x7F800000) ? 0x7E00 : 0x7C00));
+    }
+
+    // Below the smallest normal half, adding 0.5 leaves the subnormal mantissa rounded in the low bits
+    if (bits < 0x38800000)
+    {
+        float subnormal{ 0.0f };
+        std::memcpy(&subnormal, &bits, sizeof(subnormal));
+        subnormal += 0.5f;
+
+        std::memcpy(&bits, &subnormal, sizeof(bits));
+        return static_cast<UINT16>(sign | (bits - 0x3F000000));
+    }
+
+    // Rebias the exponent and round the mantissa to nearest even
+    bits += 0xC8000FFF + ((bits >> 13) & 1);
+    return static_cast<UINT16>(sign | (bits >> 13));
+}
+
+// --------------------------------------------------------------------
+// NormalizePixelsAvx2
+//
+// Normalized channel of 8 BGRA pixels.
+// --------------------------------------------------------------------
+
+static __m256 NormalizePixelsAvx2(__m256i pixels, UINT32 shift, float scale, float bias)
+{
+    const __m256i channel{ _mm256_and_si256(_mm256_srl_epi32(pixels, _mm_cvtsi32_si128(static_cast<int>(shift))), _mm256_set1_epi32(0xFF)) };
+
+    return _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(channel), _mm256_set1_ps(scale)), _mm256_set1_ps(bias));
+}
+
+// --------------------------------------------------------------------
+// WriteRowFloat32Avx2
+//
+// Returns the pixels done, the rest is left for the SSE2 loop.
+// --------------------------------------------------------------------
+
+static UINT32 WriteRowFloat32Avx2(
+    const BYTE      *pbSource,
+    UINT32          pixels,
+    const UINT32    *pShifts,
+    const float     *pScales,
+    const float     *pBiases,
+    float           **ppPlanes
+    )
+{
+    UINT32 x{ 0 };
+    for (; x + 8 <= pixels; x += 8)
+    {
+        __m256i bgra{ _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pbSource + static_cast<size_t>(x) * 4)) };
+
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            _mm256_storeu_ps(ppPlanes[c] + x, NormalizePixelsAvx2(bgra, pShifts[c], pScales[c], pBiases[c]));
+        }
+    }
+
+    return x;
+}
+
+// --------------------------------------------------------------------
+// WriteRowFloat16Avx2
+//
+// Needs F16C too. Returns the pixels done, the rest is converted one
+//  pixel at a time.
+// --------------------------------------------------------------------
+
+static UINT32 WriteRowFloat16Avx2(
+    const BYTE      *pbSource,
+    UINT32          pixels,
+    const UINT32    *pShifts,
+    const float     *pScales,
+    const float     *pBiases,
+    UINT16          **ppPlanes
+    )
+{
+    UINT32 x{ 0 };
+    for (; x + 8 <= pixels; x += 8)
+    {
+        __m256i bgra{ _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pbSource + static_cast<size_t>(x) * 4)) };
+
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            __m128i halfs{ _mm256_cvtps_ph(NormalizePixelsAvx2(bgra, pShifts[c], pScales[c], pBiases[c]), _MM_FROUND_TO_NEAREST_INT) };
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(ppPlanes[c] + x), halfs);
+        }
+    }
+
+    return x;
+}
+
+// --------------------------------------------------------------------
+// GetLinearTaps
+//
+// The two samples a coordinate is interpolated from, clamped to the
+//  edges, and the weight of the second one.
+// --------------------------------------------------------------------
+
+static void GetLinearTaps(double coordinate, UINT32 size, UINT32 *pIndex0, UINT32 *pIndex1, float *pWeight)
+{
+    coordinate = (std::min)((std::max)(coordinate, 0.0), static_cast<double>(size - 1));
+
+    const UINT32 index0{ static_cast<UINT32>(coordinate) };
+
+    *pIndex0 = index0;
+    *pIndex1 = (std::min)(index0 + 1, size - 1);
+    *pWeight = static_cast<float>(coordinate - index0);
+}
+
+// --------------------------------------------------------------------
+// InterpolateSample
+//
+// Bilinear sample from the bytes at the two offsets in the two rows.
+// --------------------------------------------------------------------
+
+static float InterpolateSample(const BYTE *pbRow0, const BYTE *pbRow1, const UINT32 *pOffsets, float weightX, float weightY)
+{
+    const float top{ pbRow0[pOffsets[0]] + (static_cast<float>(pbRow0[pOffsets[1]]) - pbRow0[pOffsets[0]]) * weightX };
+    const float bottom{ pbRow1[pOffsets[0]] + (static_cast<float>(pbRow1[pOffsets[1]]) - pbRow1[pOffsets[0]]) * weightX };
+
+    return top + (bottom - top) * weightY;
+}
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CTensorWriter::CTensorWriter() :
+    m_bIsConfigured{ false },
+    m_format{},
+    m_frameWidth{ 0 },
+    m_frameHeight{ 0 },
+    m_offsetX{ 0 },
+    m_offsetY{ 0 },
+    m_channelShifts{},
+    m_scales{},
+    m_biases{},
+    m_buffer{ nullptr },
+    m_cbPlane{ 0 },
+    m_bIsYuvSource{ false },
+    m_yuvSubtype{ GUID_NULL },
+    m_yuvSourceHeight{ 0 },
+    m_yuvColumnTaps{ nullptr },
+    m_yuvRowTaps{ nullptr },
+    m_lumaOffset{ 0.0f },
+    m_lumaScale{ 0.0f },
+    m_uCoefficients{},
+    m_vCoefficients{}
+{
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// Configure
+// --------------------------------------------------------------------
+
+void CTensorWriter::Configure(const TENSOR_FORMAT &format, UINT32 frameWidth, UINT32 frameHeight)
+{
+    m_bIsConfigured = false;
+
+    // The source is configured again for the new frame
+    m_bIsYuvSource = false;
+    m_yuvColumnTaps.reset();
+    m_yuvRowTaps.reset();
+
+    if (format.width == 0 || format.height == 0 || frameWidth == 0 || frameHeight == 0)
+    {
+        throw std::invalid_argument{ "Tensor dimensions can't be zero." };
+    }
+
+    if (format.dataType != TENSOR_DATA_TYPE::UINT8)
+    {
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            if (!(format.std[c] > 0.0f) || !std::isfinite(format.std[c]) || !std::isfinite(format.mean[c]))
+            {
+                throw std::invalid_argument{ "Tensor standard deviations have to be finite and positive, and means finite." };
+            }
+        }
+    }
+
+    const size_t elementSize{ (format.dataType == TENSOR_DATA_TYPE::FLOAT32) ? sizeof(float)
+        : (format.dataType == TENSOR_DATA_TYPE::FLOAT16) ? sizeof(UINT16) : sizeof(BYTE) };
+
+    m_cbPlane = static_cast<size_t>(format.width) * format.height * elementSize;
+
+    // Zeros are the padding of the letterbox, and the mean of the channel after normalization
+    m_buffer = std::make_unique<BYTE[]>(m_cbPlane * 3);
+    std::memset(m_buffer.get(), 0, m_cbPlane * 3);
+
+    m_format = format;
+    m_frameWidth = frameWidth;
+    m_frameHeight = frameHeight;
+
+    // Centered, the frame is smaller than the tensor for the letterbox and larger for the crop
+    m_offsetX = (static_cast<LONG>(format.width) - static_cast<LONG>(frameWidth)) / 2;
+    m_offsetY = (static_cast<LONG>(format.height) - static_cast<LONG>(frameHeight)) / 2;
+
+    for (UINT32 c = 0; c < 3; c++)
+    {
+        // Blue, green, and red are the bytes 0, 1, and 2 of the pixel
+        const UINT32 byteIndex{ (format.channelOrder == TENSOR_CHANNEL_ORDER::RGB) ? 2 - c : c };
+        m_channelShifts[c] = byteIndex * 8;
+
+        if (format.dataType != TENSOR_DATA_TYPE::UINT8)
+        {
+            m_scales[c] = 1.0f / (255.0f * format.std[c]);
+            m_biases[c] = -format.mean[c] / format.std[c];
+        }
+    }
+
+    m_bIsConfigured = true;
+}
+
+// --------------------------------------------------------------------
+// WriteRows
+// --------------------------------------------------------------------
+
+void CTensorWriter::WriteRows(const BYTE *pbScanline0, LONG lStride, UINT32 frameRowBegin, UINT32 rows)
+{
+    assert(m_bIsConfigured);
+    assert(pbScanline0 != nullptr);
+
+    // Columns of the frame inside the tensor
+    const UINT32 columnBegin{ static_cast<UINT32>((std::max)(-m_offsetX, 0L)) };
+    const UINT32 columnEnd{ static_cast<UINT32>((std::min)(static_cast<LONG>(m_frameWidth), static_cast<LONG>(m_format.width) - m_offsetX)) };
+
+    for (UINT32 i = 0; i < rows; i++)
+    {
+        const LONG tensorRow{ static_cast<LONG>(frameRowBegin + i) + m_offsetY };
+
+        // Cropped rows
+        if (tensorRow < 0 || tensorRow >= static_cast<LONG>(m_format.height)) { continue; }
+
+        const BYTE *pbSource{ pbScanline0 + static_cast<LONG_PTR>(lStride) * i + static_cast<size_t>(columnBegin) * 4 };
+        const size_t tensorOffset{ static_cast<size_t>(tensorRow) * m_format.width + static_cast<size_t>(static_cast<LONG>(columnBegin) + m_offsetX) };
+
+        switch (m_format.dataType)
+        {
+        case TENSOR_DATA_TYPE::FLOAT32:
+            WriteRowFloat32(pbSource, columnEnd - columnBegin, tensorOffset);
+            break;
+
+        case TENSOR_DATA_TYPE::FLOAT16:
+            WriteRowFloat16(pbSource, columnEnd - columnBegin, tensorOffset);
+            break;
+
+        case TENSOR_DATA_TYPE::UINT8:
+            WriteRowUInt8(pbSource, columnEnd - columnBegin, tensorOffset);
+            break;
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// ConfigureYuvSource
+//
+// The chroma samples are taken as centered between their luma samples.
+// --------------------------------------------------------------------
+
+void CTensorWriter::ConfigureYuvSource(
+    const GUID              &subtype,
+    UINT32                  sourceWidth,
+    UINT32                  sourceHeight,
+    MFVideoTransferMatrix   matrix,
+    MFNominalRange          nominalRange,
+    bool                    bMirrorColumns,
+    bool                    bReverseRows
+    )
+{
+    assert(m_bIsConfigured);
+
+    m_bIsYuvSource = false;
+
+    const bool bIsNv12{ subtype == MFVideoFormat_NV12 };
+    const bool bIsYuy2{ subtype == MFVideoFormat_YUY2 };
+
+    if (!bIsNv12 && !bIsYuy2 && subtype != MFVideoFormat_I420 && subtype != MFVideoFormat_IYUV)
+    {
+        throw std::invalid_argument{ "The tensor can be read only from NV12, I420, IYUV, or YUY2 samples." };
+    }
+
+    if (sourceWidth < 2 || sourceHeight < 2 || (sourceWidth % 2) != 0 || (sourceHeight % 2) != 0)
+    {
+        throw std::invalid_argument{ "The YUV source dimensions have to be even." };
+    }
+
+    // Columns of the frame inside the tensor
+    const UINT32 columnBegin{ static_cast<UINT32>((std::max)(-m_offsetX, 0L)) };
+    const UINT32 columnEnd{ static_cast<UINT32>((std::min)(static_cast<LONG>(m_frameWidth), static_cast<LONG>(m_format.width) - m_offsetX)) };
+
+    auto columnTaps{ std::make_unique<YUV_COLUMN_TAP[]>(columnEnd - columnBegin) };
+    auto rowTaps{ std::make_unique<YUV_ROW_TAP[]>(m_frameHeight) };
+
+    const double scaleX{ static_cast<double>(sourceWidth) / m_frameWidth };
+    const double scaleY{ static_cast<double>(sourceHeight) / m_frameHeight };
+
+    for (UINT32 x = columnBegin; x < columnEnd; x++)
+    {
+        YUV_COLUMN_TAP &tap{ columnTaps[x - columnBegin] };
+
+        const UINT32 frameColumn{ bMirrorColumns ? m_frameWidth - 1 - x : x };
+        const double lumaX{ (frameColumn + 0.5) * scaleX - 0.5 };
+
+        UINT32 lumaColumns[2]{};
+        UINT32 chromaColumns[2]{};
+        GetLinearTaps(lumaX, sourceWidth, &lumaColumns[0], &lumaColumns[1], &tap.lumaWeight);
+        GetLinearTaps(lumaX / 2 - 0.25, sourceWidth / 2, &chromaColumns[0], &chromaColumns[1], &tap.chromaWeight);
+
+        for (UINT32 i = 0; i < 2; i++)
+        {
+            if (bIsYuy2)
+            {
+                // Y0 U Y1 V for each pair of pixels
+                tap.lumaOffsets[i] = lumaColumns[i] * 2;
+                tap.uOffsets[i] = chromaColumns[i] * 4 + 1;
+                tap.vOffsets[i] = chromaColumns[i] * 4 + 3;
+            }
+            else
+            {
+                // U and V interleaved in a plane for NV12, each in its own plane for I420 and IYUV
+                tap.lumaOffsets[i] = lumaColumns[i];
+                tap.uOffsets[i] = bIsNv12 ? chromaColumns[i] * 2 : chromaColumns[i];
+                tap.vOffsets[i] = bIsNv12 ? chromaColumns[i] * 2 + 1 : chromaColumns[i];
+            }
+        }
+    }
+
+    for (UINT32 y = 0; y < m_frameHeight; y++)
+    {
+        YUV_ROW_TAP &tap{ rowTaps[y] };
+
+        const UINT32 frameRow{ bReverseRows ? m_frameHeight - 1 - y : y };
+        const double lumaY{ (frameRow + 0.5) * scaleY - 0.5 };
+
+        GetLinearTaps(lumaY, sourceHeight, &tap.lumaRows[0], &tap.lumaRows[1], &tap.lumaWeight);
+
+        // The chroma of YUY2 is on every row
+        if (bIsYuy2)
+        {
+            tap.chromaRows[0] = tap.lumaRows[0];
+            tap.chromaRows[1] = tap.lumaRows[1];
+            tap.chromaWeight = tap.lumaWeight;
+        }
+        else
+        {
+            GetLinearTaps(lumaY / 2 - 0.25, sourceHeight / 2, &tap.chromaRows[0], &tap.chromaRows[1], &tap.chromaWeight);
+        }
+    }
+
+    // BT.601 unless the type is BT.709, in the nominal range of 16-235 unless it is 0-255
+    const bool bIsBt709{ matrix == MFVideoTransferMatrix_BT709 };
+    const bool bIsFullRange{ nominalRange == MFNominalRange_0_255 };
+
+    const float kr{ bIsBt709 ? 0.2126f : 0.299f };
+    const float kb{ bIsBt709 ? 0.0722f : 0.114f };
+    const float kg{ 1.0f - kr - kb };
+    const float chromaScale{ bIsFullRange ? 1.0f : 255.0f / 224.0f };
+
+    m_lumaOffset = bIsFullRange ? 0.0f : 16.0f;
+    m_lumaScale = bIsFullRange ? 1.0f : 255.0f / 219.0f;
+
+    // Red, green, and blue
+    const float uCoefficients[3]{ 0.0f, -2.0f * kb * (1.0f - kb) / kg * chromaScale, 2.0f * (1.0f - kb) * chromaScale };
+    const float vCoefficients[3]{ 2.0f * (1.0f - kr) * chromaScale, -2.0f * kr * (1.0f - kr) / kg * chromaScale, 0.0f };
+
+    for (UINT32 c = 0; c < 3; c++)
+    {
+        const UINT32 channel{ (m_format.channelOrder == TENSOR_CHANNEL_ORDER::RGB) ? c : 2 - c };
+
+        m_uCoefficients[c] = uCoefficients[channel];
+        m_vCoefficients[c] = vCoefficients[channel];
+    }
+
+    m_yuvSubtype = subtype;
+    m_yuvSourceHeight = sourceHeight;
+    m_yuvColumnTaps = std::move(columnTaps);
+    m_yuvRowTaps = std::move(rowTaps);
+
+    m_bIsYuvSource = true;
+}
+
+// --------------------------------------------------------------------
+// WriteYuvSourceRows
+//
+// Each pixel is sampled from the source, then the pixels are converted
+//  and normalized 4 at a time.
+// --------------------------------------------------------------------
+
+void CTensorWriter::WriteYuvSourceRows(const BYTE *pbScanline0, LONG lStride, UINT32 tensorRowBegin, UINT32 tensorRowEnd)
+{
+    assert(m_bIsYuvSource);
+    assert(pbScanline0 != nullptr);
+    assert(lStride > 0);
+
+    const UINT32 columnBegin{ static_cast<UINT32>((std::max)(-m_offsetX, 0L)) };
+    const UINT32 columnEnd{ static_cast<UINT32>((std::min)(static_cast<LONG>(m_frameWidth), static_cast<LONG>(m_format.width) - m_offsetX)) };
+    const UINT32 pixels{ columnEnd - columnBegin };
+
+    // The chroma planes follow the Y plane, a plane of interleaved U and V at the same stride for NV12,
+    //  and a U plane then a V plane at half the stride for I420 and IYUV
+    const BYTE *pbUPlane{ pbScanline0 };
+    const BYTE *pbVPlane{ pbScanline0 };
+    size_t cbChromaStride{ static_cast<size_t>(lStride) };
+
+    if (m_yuvSubtype == MFVideoFormat_NV12)
+    {
+        pbUPlane = pbScanline0 + static_cast<size_t>(lStride) * m_yuvSourceHeight;
+        pbVPlane = pbUPlane;
+    }
+    else if (m_yuvSubtype != MFVideoFormat_YUY2)
+    {
+        cbChromaStride = static_cast<size_t>(lStride) / 2;
+        pbUPlane = pbScanline0 + static_cast<size_t>(lStride) * m_yuvSourceHeight;
+        pbVPlane = pbUPlane + cbChromaStride * (m_yuvSourceHeight / 2);
+    }
+
+    float lumas[4]{};
+    float us[4]{};
+    float vs[4]{};
+
+    for (UINT32 tensorRow = tensorRowBegin; tensorRow < tensorRowEnd; tensorRow++)
+    {
+        const LONG frameRow{ static_cast<LONG>(tensorRow) - m_offsetY };
+
+        // Padding of the letterbox
+        if (frameRow < 0 || frameRow >= static_cast<LONG>(m_frameHeight)) { continue; }
+
+        const YUV_ROW_TAP &rowTap{ m_yuvRowTaps[frameRow] };
+
+        const BYTE *pbLuma0{ pbScanline0 + static_cast<size_t>(lStride) * rowTap.lumaRows[0] };
+        const BYTE *pbLuma1{ pbScanline0 + static_cast<size_t>(lStride) * rowTap.lumaRows[1] };
+        const BYTE *pbU0{ pbUPlane + cbChromaStride * rowTap.chromaRows[0] };
+        const BYTE *pbU1{ pbUPlane + cbChromaStride * rowTap.chromaRows[1] };
+        const BYTE *pbV0{ pbVPlane + cbChromaStride * rowTap.chromaRows[0] };
+        const BYTE *pbV1{ pbVPlane + cbChromaStride * rowTap.chromaRows[1] };
+
+        const size_t tensorOffset{ static_cast<size_t>(tensorRow) * m_format.width + static_cast<size_t>(static_cast<LONG>(columnBegin) + m_offsetX) };
+
+        for (UINT32 x = 0; x < pixels; x += 4)
+        {
+            const UINT32 blockPixels{ (std::min)(pixels - x, 4u) };
+
+            for (UINT32 i = 0; i < blockPixels; i++)
+            {
+                const YUV_COLUMN_TAP &tap{ m_yuvColumnTaps[x + i] };
+
+                lumas[i] = InterpolateSample(pbLuma0, pbLuma1, tap.lumaOffsets, tap.lumaWeight, rowTap.lumaWeight);
+                us[i] = InterpolateSample(pbU0, pbU1, tap.uOffsets, tap.chromaWeight, rowTap.chromaWeight);
+                vs[i] = InterpolateSample(pbV0, pbV1, tap.vOffsets, tap.chromaWeight, rowTap.chromaWeight);
+            }
+
+            WriteYuvPixels(lumas, us, vs, blockPixels, tensorOffset + x);
+        }
+    }
+}
+
+// ===============================
+// ====== Private Functions ======
+// ===============================
+
+// --------------------------------------------------------------------
+// WriteRowFloat32
+// --------------------------------------------------------------------
+
+void CTensorWriter::WriteRowFloat32(const BYTE *pbSource, UINT32 pixels, size_t tensorOffset)
+{
+    float *pPlanes[3]{};
+    for (UINT32 c = 0; c < 3; c++)
+    {
+        pPlanes[c] = reinterpret_cast<float *>(m_buffer.get() + m_cbPlane * c) + tensorOffset;
+    }
+
+    UINT32 x{ GetIsAvx2Supported() ? WriteRowFloat32Avx2(pbSource, pixels, m_channelShifts, m_scales, m_biases, pPlanes) : 0 };
+
+    const __m128i byteMask{ _mm_set1_epi32(0xFF) };
+    for (; x + 4 <= pixels; x += 4)
+    {
+        __m128i bgra{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSource + static_cast<size_t>(x) * 4)) };
+
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            __m128i channel{ _mm_and_si128(_mm_srl_epi32(bgra, _mm_cvtsi32_si128(static_cast<int>(m_channelShifts[c]))), byteMask) };
+            _mm_storeu_ps(pPlanes[c] + x, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(channel), _mm_set1_ps(m_scales[c])), _mm_set1_ps(m_biases[c])));
+        }
+    }
+
+    for (; x < pixels; x++)
+    {
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            pPlanes[c][x] = static_cast<float>(pbSource[static_cast<size_t>(x) * 4 + m_channelShifts[c] / 8]) * m_scales[c] + m_biases[c];
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// WriteRowFloat16
+// --------------------------------------------------------------------
+
+void CTensorWriter::WriteRowFloat16(const BYTE *pbSource, UINT32 pixels, size_t tensorOffset)
+{
+    UINT16 *pPlanes[3]{};
+    for (UINT32 c = 0; c < 3; c++)
+    {
+        pPlanes[c] = reinterpret_cast<UINT16 *>(m_buffer.get() + m_cbPlane * c) + tensorOffset;
+    }
+
+    UINT32 x{ (GetIsAvx2Supported() && GetIsF16cSupported())
+        ? WriteRowFloat16Avx2(pbSource, pixels, m_channelShifts, m_scales, m_biases, pPlanes)
+        : 0 };
+
+    for (; x < pixels; x++)
+    {
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            pPlanes[c][x] = FloatToHalf(static_cast<float>(pbSource[static_cast<size_t>(x) * 4 + m_channelShifts[c] / 8]) * m_scales[c] + m_biases[c]);
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// WriteRowUInt8
+//
+// The channel of 16 pixels is masked out of 4 registers, then packed
+//  down to bytes.
+// --------------------------------------------------------------------
+
+void CTensorWriter::WriteRowUInt8(const BYTE *pbSource, UINT32 pixels, size_t tensorOffset)
+{
+    BYTE *pbPlanes[3]{};
+    for (UINT32 c = 0; c < 3; c++)
+    {
+        pbPlanes[c] = m_buffer.get() + m_cbPlane * c + tensorOffset;
+    }
+
+    const __m128i byteMask{ _mm_set1_epi32(0xFF) };
+
+    UINT32 x{ 0 };
+    for (; x + 16 <= pixels; x += 16)
+    {
+        const __m128i *pSource{ reinterpret_cast<const __m128i *>(pbSource + static_cast<size_t>(x) * 4) };
+
+        __m128i bgra0{ _mm_loadu_si128(pSource) };
+        __m128i bgra1{ _mm_loadu_si128(pSource + 1) };
+        __m128i bgra2{ _mm_loadu_si128(pSource + 2) };
+        __m128i bgra3{ _mm_loadu_si128(pSource + 3) };
+
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            const __m128i shift{ _mm_cvtsi32_si128(static_cast<int>(m_channelShifts[c])) };
+
+            __m128i low{ _mm_packs_epi32(
+                _mm_and_si128(_mm_srl_epi32(bgra0, shift), byteMask),
+                _mm_and_si128(_mm_srl_epi32(bgra1, shift), byteMask)) };
+            __m128i high{ _mm_packs_epi32(
+                _mm_and_si128(_mm_srl_epi32(bgra2, shift), byteMask),
+                _mm_and_si128(_mm_srl_epi32(bgra3, shift), byteMask)) };
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pbPlanes[c] + x), _mm_packus_epi16(low, high));
+        }
+    }
+
+    for (; x < pixels; x++)
+    {
+        for (UINT32 c = 0; c < 3; c++)
+        {
+            pbPlanes[c][x] = pbSource[static_cast<size_t>(x) * 4 + m_channelShifts[c] / 8];
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// WriteYuvPixels
+//
+// Converts up to 4 pixels to RGB, clamped like the video processor,
+//  and stores them normalized. The last pixels of a row are stored
+//  from a block on the stack.
+// --------------------------------------------------------------------
+
+void CTensorWriter::WriteYuvPixels(const float *pY, const float *pU, const float *pV, UINT32 pixels, size_t tensorOffset)
+{
+    assert(pixels > 0 && pixels <= 4);
+
+    const __m128 luma{ _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pY), _mm_set1_ps(m_lumaOffset)), _mm_set1_ps(m_lumaScale)) };
+    const __m128 u{ _mm_sub_ps(_mm_loadu_ps(pU), _mm_set1_ps(128.0f)) };
+    const __m128 v{ _mm_sub_ps(_mm_loadu_ps(pV), _mm_set1_ps(128.0f)) };
+
+    const bool bIsF16cSupported{ m_format.dataType == TENSOR_DATA_TYPE::FLOAT16 && GetIsF16cSupported() };
+
+    for (UINT32 c = 0; c < 3; c++)
+    {
+        __m128 channel{ _mm_add_ps(luma, _mm_add_ps(_mm_mul_ps(u, _mm_set1_ps(m_uCoefficients[c])), _mm_mul_ps(v, _mm_set1_ps(m_vCoefficients[c])))) };
+        channel = _mm_min_ps(_mm_max_ps(channel, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+
+        BYTE *pbPlane{ m_buffer.get() + m_cbPlane * c };
+
+        switch (m_format.dataType)
+        {
+        case TENSOR_DATA_TYPE::FLOAT32:
+        {
+            alignas(16) float values[4];
+            _mm_store_ps(values, _mm_add_ps(_mm_mul_ps(channel, _mm_set1_ps(m_scales[c])), _mm_set1_ps(m_biases[c])));
+
+            std::memcpy(reinterpret_cast<float *>(pbPlane) + tensorOffset, values, pixels * sizeof(float));
+            break;
+        }
+
+        case TENSOR_DATA_TYPE::FLOAT16:
+        {
+            const __m128 normalized{ _mm_add_ps(_mm_mul_ps(channel, _mm_set1_ps(m_scales[c])), _mm_set1_ps(m_biases[c])) };
+
+            alignas(16) UINT16 halfs[8];
+            if (bIsF16cSupported)
+            {
+                _mm_store_si128(reinterpret_cast<__m128i *>(halfs), _mm_cvtps_ph(normalized, _MM_FROUND_TO_NEAREST_INT));
+            }
+            else
+            {
+                alignas(16) float values[4];
+                _mm_store_ps(values, normalized);
+
+                for (UINT32 i = 0; i < pixels; i++)
+                {
+                    halfs[i] = FloatToHalf(values[i]);
+                }
+            }
+
+            std::memcpy(reinterpret_cast<UINT16 *>(pbPlane) + tensorOffset, halfs, pixels * sizeof(UINT16));
+            break;
+        }
+
+        case TENSOR_DATA_TYPE::UINT8:
+        {
+            // Rounded to the nearest, then packed down to bytes
+            const __m128i words{ _mm_packs_epi32(_mm_cvtps_epi32(channel), _mm_setzero_si128()) };
+            const UINT32 bytes{ static_cast<UINT32>(_mm_cvtsi128_si32(_mm_packus_epi16(words, words))) };
+
+            std::memcpy(pbPlane + tensorOffset, &bytes, pixels);
+            break;
+        }
+        }
+    }
+}
+
+// ==============================
+// ====== Static Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// GetFrameSizeForTensor [static]
+// --------------------------------------------------------------------
+
+void CTensorWriter::GetFrameSizeForTensor(
+    const TENSOR_FORMAT &format,
+    UINT32              sourceWidth,
+    UINT32              sourceHeight,
+    UINT32              *pFrameWidth,
+    UINT32              *pFrameHeight
+    )
+{
+    assert(pFrameWidth != nullptr);
+    assert(pFrameHeight != nullptr);
+    assert(sourceWidth > 0 && sourceHeight > 0);
+
+    if (format.fit == TENSOR_FIT::STRETCH)
+    {
+        *pFrameWidth = format.width;
+        *pFrameHeight = format.height;
+        return;
+    }
+
+    const double scaleX{ static_cast<double>(format.width) / sourceWidth };
+    const double scaleY{ static_cast<double>(format.height) / sourceHeight };
+
+    // The letterbox fits the whole frame in, the crop covers the whole tensor
+    const double scale{ (format.fit == TENSOR_FIT::LETTERBOX) ? (std::min)(scaleX, scaleY) : (std::max)(scaleX, scaleY) };
+
+    UINT32 frameWidth{ static_cast<UINT32>(std::lround(sourceWidth * scale)) };
+    UINT32 frameHeight{ static_cast<UINT32>(std::lround(sourceHeight * scale)) };
+
+    if (format.fit == TENSOR_FIT::LETTERBOX)
+    {
+        frameWidth = (std::min)((std::max)(frameWidth, 1u), format.width);
+        frameHeight = (std::min)((std::max)(frameHeight, 1u), format.height);
+    }
+    else
+    {
+        frameWidth = (std::max)(frameWidth, format.width);
+        frameHeight = (std::max)(frameHeight, format.height);
+    }
+
+    *pFrameWidth = frameWidth;
+    *pFrameHeight = frameHeight;
+}
+
+#pragma managed(pop)
@@ -0,0 +1,215 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CTensorWriter.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:02 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        /// <summary>
+        /// Element type of the tensor.
+        /// </summary>
+        enum class TENSOR_DATA_TYPE
+        {
+            FLOAT32,
+            FLOAT16,    // IEEE 754 half precision.
+            UINT8       // Channel bytes as is, not normalized.
+        };
+
+        /// <summary>
+        /// How the frame is fit into the tensor when their aspect ratios differ.
+        /// </summary>
+        enum class TENSOR_FIT
+        {
+            STRETCH,    // The frame is resampled to the tensor size.
+            LETTERBOX,  // The whole frame is centered in the tensor, padded with zeros.
+            CROP        // The center of the frame fills the tensor.
+        };
+
+        /// <summary>
+        /// Order of the channel planes of the tensor.
+        /// </summary>
+        enum class TENSOR_CHANNEL_ORDER
+        {
+            RGB,
+            BGR
+        };
+
+        // =====================================
+        // ====== TENSOR_FORMAT Structure ======
+        // =====================================
+
+        /// <summary>
+        /// Layout of a planar CHW tensor of 3 channels.
+        /// </summary>
+        struct TENSOR_FORMAT
+        {
+            UINT32                  width;
+            UINT32                  height;
+            TENSOR_FIT              fit;
+            TENSOR_CHANNEL_ORDER    channelOrder;
+            TENSOR_DATA_TYPE        dataType;
+            float                   mean[3];        // Per channel in the channel order, in [0, 1] units.
+            float                   std[3];         //  Both are ignored for UINT8.
+        };
+
+        // ============================================
+        // ====== CTensorWriter Class Definition ======
+        // ============================================
+
+        /// <summary>
+        /// Writes BGRA rows of a frame into a planar CHW tensor, normalized as
+        ///  `(value / 255 - mean) / std` per channel, in the same pass.
+        ///  Or, once configured for a YUV source, reads the tensor straight from the
+        ///  native YUV samples, sampling, converting to RGB and normalizing in one pass.
+        /// </summary>
+        /// <remarks>
+        /// The frame is expected at the size from `GetFrameSizeForTensor`, the tensor is then the frame
+        ///  offset by the padding of the letterbox, or by the cropped margins. The padding never changes,
+        ///  so it is written once on `Configure`.
+        /// Rows can be written from several threads at once, as long as they don't overlap.
+        /// </remarks>
+        class CTensorWriter
+        {
+            /* === Member Functions === */
+        public:
+            CTensorWriter();
+
+            CTensorWriter(const CTensorWriter &) = delete;
+            CTensorWriter &operator=(const CTensorWriter &) = delete;
+
+            /// <summary>
+            /// Configure the writer and allocate the tensor for frames of the passed size,
+            ///  throws `std::invalid_argument` on an invalid format.
+            /// </summary>
+            void Configure(const TENSOR_FORMAT &format, UINT32 frameWidth, UINT32 frameHeight) noexcept(false);
+
+            /// <summary>
+            /// Write the frame rows [frameRowBegin, frameRowBegin + rows) into the tensor,
+            ///  `pbScanline0` points to the row `frameRowBegin`.
+            /// </summary>
+            void WriteRows(const BYTE *pbScanline0, LONG lStride, UINT32 frameRowBegin, UINT32 rows);
+
+            /// <summary>
+            /// Configure the writer, after `Configure`, to read the tensor from native NV12, I420, IYUV,
+            ///  or YUY2 samples of the passed size, which the frame of the tensor is bilinearly sampled from.
+            ///  The columns and the rows of the source are visited in reverse for the orientation of the frame.
+            ///  Throws `std::invalid_argument` on another subtype.
+            /// </summary>
+            void ConfigureYuvSource(
+                const GUID              &subtype,
+                UINT32                  sourceWidth,
+                UINT32                  sourceHeight,
+                MFVideoTransferMatrix   matrix,
+                MFNominalRange          nominalRange,
+                bool                    bMirrorColumns,
+                bool                    bReverseRows
+                ) noexcept(false);
+
+            /// <summary>
+            /// Write the tensor rows [tensorRowBegin, tensorRowEnd) from the locked YUV sample,
+            ///  `pbScanline0` points to the first row of the Y plane, or of the packed YUY2 image.
+            /// </summary>
+            void WriteYuvSourceRows(const BYTE *pbScanline0, LONG lStride, UINT32 tensorRowBegin, UINT32 tensorRowEnd);
+
+            bool GetIsConfigured() const { return m_bIsConfigured; }
+            bool GetIsYuvSource() const { return m_bIsYuvSource; }
+            const BYTE *GetBuffer() const { return m_buffer.get(); }
+            size_t GetBufferSize() const { return m_cbPlane * 3; }
+
+            /// <summary>
+            /// Get the size the frame is resampled to for the tensor, keeping the aspect ratio
+            ///  of the source for the letterbox and the crop.
+            /// </summary>
+            static void GetFrameSizeForTensor(
+                const TENSOR_FORMAT &format,
+                UINT32              sourceWidth,
+                UINT32              sourceHeight,
+                UINT32              *pFrameWidth,
+                UINT32              *pFrameHeight
+                );
+
+        private:
+            void WriteRowFloat32(const BYTE *pbSource, UINT32 pixels, size_t tensorOffset);
+            void WriteRowFloat16(const BYTE *pbSource, UINT32 pixels, size_t tensorOffset);
+            void WriteRowUInt8(const BYTE *pbSource, UINT32 pixels, size_t tensorOffset);
+
+            void WriteYuvPixels(const float *pY, const float *pU, const float *pV, UINT32 pixels, size_t tensorOffset);
+
+            /// <summary>
+            /// Byte offsets of the two samples each component of a frame column is interpolated from,
+            ///  within the rows of their planes.
+            /// </summary>
+            struct YUV_COLUMN_TAP
+            {
+                UINT32  lumaOffsets[2];
+                UINT32  uOffsets[2];
+                UINT32  vOffsets[2];
+                float   lumaWeight;         // Weight of the second sample.
+                float   chromaWeight;
+            };
+
+            /// <summary>
+            /// Rows of the planes a frame row is interpolated from.
+            /// </summary>
+            struct YUV_ROW_TAP
+            {
+                UINT32  lumaRows[2];
+                UINT32  chromaRows[2];      // Rows of the chroma planes, same as the luma rows for YUY2.
+                float   lumaWeight;
+                float   chromaWeight;
+            };
+
+            /* === Data Members === */
+        private:
+            bool                    m_bIsConfigured;
+            TENSOR_FORMAT           m_format;
+
+            UINT32                  m_frameWidth;
+            UINT32                  m_frameHeight;
+
+            // Position of the frame in the tensor, negative for the cropped margins.
+            LONG                    m_offsetX;
+            LONG                    m_offsetY;
+
+            // Per plane, the byte of the BGRA pixel it is taken from and its normalization.
+            UINT32                  m_channelShifts[3];
+            float                   m_scales[3];
+            float                   m_biases[3];
+
+            std::unique_ptr<BYTE[]> m_buffer;
+            size_t                  m_cbPlane;
+
+            // YUV source, the taps cover the columns of the frame inside the tensor, and all its rows.
+            bool                                m_bIsYuvSource;
+            GUID                                m_yuvSubtype;
+            UINT32                              m_yuvSourceHeight;
+            std::unique_ptr<YUV_COLUMN_TAP[]>   m_yuvColumnTaps;
+            std::unique_ptr<YUV_ROW_TAP[]>      m_yuvRowTaps;
+
+            // Per plane, the RGB channel from the luma and the chroma, `c = lumaScale * (Y - lumaOffset)
+            //  + uCoefficient * (U - 128) + vCoefficient * (V - 128)`, clamped to [0, 255] before normalizing.
+            float                   m_lumaOffset;
+            float                   m_lumaScale;
+            float                   m_uCoefficients[3];
+            float                   m_vCoefficients[3];
+        };
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,63 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CTraceSpan.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 07:55 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        /// <summary>
+        /// Records a span from its construction to its destruction if tracing is enabled,
+        ///  see `StartTracing`. When tracing is disabled it costs a load and a branch.
+        /// </summary>
+        class CTraceSpan
+        {
+            /* === Member Functions === */
+        public:
+            /// <summary>
+            /// Begin a span, `pszName` has to be a string literal.
+            /// </summary>
+            CTraceSpan(const char *pszName, const void *id) :
+                m_pszName{ pszName },
+                m_id{ id },
+                m_llBegin{ GetIsTracingEnabled() ? GetTraceTime() : 0 }
+            {
+            }
+
+            CTraceSpan(const CTraceSpan &) = delete;
+            CTraceSpan &operator=(const CTraceSpan &) = delete;
+
+            ~CTraceSpan()
+            {
+                // A span begun before tracing started isn't recorded
+                if (m_llBegin != 0 && GetIsTracingEnabled())
+                {
+                    RecordTraceSpan(m_pszName, m_id, m_llBegin, GetTraceTime());
+                }
+            }
+
+            /* === Data Members === */
+        private:
+            const char  *m_pszName;
+            const void  *m_id;
+            LONGLONG    m_llBegin;      // Zero if tracing was disabled on beginning.
+        };
+    }
+}
+
+#pragma managed(pop)
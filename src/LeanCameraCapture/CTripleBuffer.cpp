@@ -0,0 +1,141 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CTripleBuffer.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 05:20 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CTripleBuffer.h"
+
+// Flag of the middle buffer set on publishing and cleared on taking.
+#define TRIPLE_BUFFER_NEW 0x4
+#define TRIPLE_BUFFER_INDEX_MASK 0x3
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CTripleBuffer::CTripleBuffer() :
+    m_buffers{},
+    m_timestamps{},
+    m_sequenceNumbers{},
+    m_cbBuffer{ 0 },
+    m_backIndex{ 0 },
+    m_publishedCount{ 0 },
+    m_frontIndex{ 2 },
+    m_bHasFront{ false },
+    m_lMiddle{ 1 }
+{
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// Allocate
+// --------------------------------------------------------------------
+
+void CTripleBuffer::Allocate(size_t cbBuffer)
+{
+    assert(cbBuffer > 0);
+
+    Free();
+
+    for (auto &buffer : m_buffers)
+    {
+        buffer = AllocateFrameMemory(cbBuffer);
+    }
+
+    m_cbBuffer = cbBuffer;
+}
+
+// --------------------------------------------------------------------
+// Free
+// --------------------------------------------------------------------
+
+void CTripleBuffer::Free()
+{
+    for (UINT32 i = 0; i < 3; i++)
+    {
+        m_buffers[i].reset();
+        m_timestamps[i] = 0;
+        m_sequenceNumbers[i] = 0;
+    }
+
+    m_cbBuffer = 0;
+    m_backIndex = 0;
+    m_publishedCount = 0;
+    m_frontIndex = 2;
+    m_bHasFront = false;
+
+    InterlockedExchange(&m_lMiddle, 1);
+}
+
+// --------------------------------------------------------------------
+// Publish
+//
+// The metadata of the back buffer is written before the exchange,
+//  which is a full barrier, so the consumer sees it with the buffer.
+// --------------------------------------------------------------------
+
+void CTripleBuffer::Publish(LONGLONG llTimestamp)
+{
+    assert(GetIsAllocated());
+
+    m_timestamps[m_backIndex] = llTimestamp;
+    m_sequenceNumbers[m_backIndex] = ++m_publishedCount;
+
+    const LONG lPrevious{ InterlockedExchange(&m_lMiddle, static_cast<LONG>(m_backIndex) | TRIPLE_BUFFER_NEW) };
+
+    m_backIndex = static_cast<UINT32>(lPrevious & TRIPLE_BUFFER_INDEX_MASK);
+}
+
+// --------------------------------------------------------------------
+// TryTakeLatest
+//
+// The middle buffer is swapped in only if it has been published since
+//  the last take, otherwise the front buffer is returned again.
+// --------------------------------------------------------------------
+
+bool CTripleBuffer::TryTakeLatest(TRIPLE_BUFFER_FRAME *pFrame)
+{
+    assert(pFrame != nullptr);
+
+    bool bIsNew{ false };
+
+    if (!GetIsAllocated()) { return false; }
+
+    // Atomic read of the middle, the exchange is done only if something new has been published
+    if ((InterlockedCompareExchange(&m_lMiddle, 0, 0) & TRIPLE_BUFFER_NEW) != 0)
+    {
+        const LONG lPrevious{ InterlockedExchange(&m_lMiddle, static_cast<LONG>(m_frontIndex)) };
+
+        m_frontIndex = static_cast<UINT32>(lPrevious & TRIPLE_BUFFER_INDEX_MASK);
+        m_bHasFront = true;
+        bIsNew = true;
+    }
+
+    if (!m_bHasFront) { return false; }
+
+    pFrame->pbBuffer = m_buffers[m_frontIndex].get();
+    pFrame->llTimestamp = m_timestamps[m_frontIndex];
+    pFrame->sequenceNumber = m_sequenceNumbers[m_frontIndex];
+    pFrame->bIsNew = bIsNew;
+
+    return true;
+}
+
+#pragma managed(pop)
@@ -0,0 +1,107 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CTripleBuffer.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 05:12 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        // ===========================================
+        // ====== TRIPLE_BUFFER_FRAME Structure ======
+        // ===========================================
+
+        /// <summary>
+        /// Latest published buffer taken by the consumer.
+        /// </summary>
+        struct TRIPLE_BUFFER_FRAME
+        {
+            const BYTE  *pbBuffer;          // Valid until the next take or until the buffers are freed.
+            LONGLONG    llTimestamp;        // Timestamp passed on publishing.
+            UINT64      sequenceNumber;     // One for the first published buffer.
+            bool        bIsNew;             // True if published since the last take.
+        };
+
+        // ============================================
+        // ====== CTripleBuffer Class Definition ======
+        // ============================================
+
+        /// <summary>
+        /// Three buffers passed from a single producer to a single consumer without locking or copying.
+        ///  The producer writes the back buffer and publishes it, the consumer takes the latest published
+        ///  buffer as its front buffer. Both swap their buffer with the middle one in one interlocked exchange,
+        ///  so neither waits for the other and the consumer always gets the newest completed buffer.
+        /// </summary>
+        class CTripleBuffer
+        {
+            /* === Member Functions === */
+        public:
+            CTripleBuffer();
+
+            CTripleBuffer(const CTripleBuffer &) = delete;
+            CTripleBuffer &operator=(const CTripleBuffer &) = delete;
+
+            /// <summary>
+            /// Allocate the buffers, throws `std::bad_alloc` on failure.
+            ///  Nothing is published until the producer publishes.
+            /// </summary>
+            void Allocate(size_t cbBuffer) noexcept(false);
+
+            /// <summary>
+            /// Free the buffers, neither the producer nor the consumer may be using them.
+            /// </summary>
+            void Free();
+
+            bool GetIsAllocated() const { return m_cbBuffer != 0; }
+            size_t GetBufferSize() const { return m_cbBuffer; }
+
+            /// <summary>
+            /// [Producer] Gets the buffer to be written, owned by the producer until published.
+            /// </summary>
+            BYTE *GetBackBuffer() const { return m_buffers[m_backIndex].get(); }
+
+            /// <summary>
+            /// [Producer] Publish the back buffer and take a new back buffer.
+            /// </summary>
+            void Publish(LONGLONG llTimestamp);
+
+            /// <summary>
+            /// [Consumer] Take the latest published buffer, the previous front buffer is given back.
+            ///  Returns false if nothing has been published yet.
+            /// </summary>
+            bool TryTakeLatest(TRIPLE_BUFFER_FRAME *pFrame);
+
+            /* === Data Members === */
+        private:
+            FRAME_MEMORY            m_buffers[3];
+            LONGLONG                m_timestamps[3];
+            UINT64                  m_sequenceNumbers[3];
+            size_t                  m_cbBuffer;
+
+            UINT32                  m_backIndex;            // Owned by the producer.
+            UINT64                  m_publishedCount;
+
+            UINT32                  m_frontIndex;           // Owned by the consumer.
+            bool                    m_bHasFront;
+
+            // Index of the middle buffer, with `TRIPLE_BUFFER_NEW` set if published and not taken yet.
+            volatile LONG           m_lMiddle;
+        };
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,213 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CWorkerPool.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 01:10 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "CWorkerPool.h"
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// =========================
+// ====== Constructor ======
+// =========================
+
+CWorkerPool::CWorkerPool() :
+    m_workerCount{ 0 },
+    m_pPool{ nullptr },
+    m_pCleanupGroup{ nullptr },
+    m_callbackEnvironment{},
+    m_pWork{ nullptr },
+    m_pTask{ nullptr },
+    m_pTaskContext{ nullptr },
+    m_taskCount{ 0 },
+    m_nextTask{ 0 }
+{
+    InitializeThreadpoolEnvironment(&m_callbackEnvironment);
+}
+
+// ========================
+// ====== Destructor ======
+// ========================
+
+CWorkerPool::~CWorkerPool()
+{
+    FreeResources();
+
+    DestroyThreadpoolEnvironment(&m_callbackEnvironment);
+}
+
+// ==============================
+// ====== Public Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// Initialize
+//
+// The minimum and maximum threads are the same, so the workers are
+//  created once and don't wind down between frames.
+// --------------------------------------------------------------------
+
+void CWorkerPool::Initialize(UINT32 workerCount) noexcept(false)
+{
+    assert(m_pPool == nullptr);
+    assert(workerCount > 0);
+
+    HRESULT hr{ S_OK };
+    std::string exWhatString{};
+
+    m_pPool = CreateThreadpool(nullptr);
+    if (!m_pPool)
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during CreateThreadpool().");
+    }
+
+    SetThreadpoolThreadMaximum(m_pPool, workerCount);
+    if (!SetThreadpoolThreadMinimum(m_pPool, workerCount))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during SetThreadpoolThreadMinimum().");
+    }
+
+    m_pCleanupGroup = CreateThreadpoolCleanupGroup();
+    if (!m_pCleanupGroup)
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during CreateThreadpoolCleanupGroup().");
+    }
+
+    SetThreadpoolCallbackPool(&m_callbackEnvironment, m_pPool);
+    SetThreadpoolCallbackCleanupGroup(&m_callbackEnvironment, m_pCleanupGroup, nullptr);
+
+    m_pWork = CreateThreadpoolWork(WorkCallback, this, &m_callbackEnvironment);
+    if (!m_pWork)
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        CHECK_FAILED_HR_WITH_GOTO_AND_EX_STR(hr, done, exWhatString, "Error occurred during CreateThreadpoolWork().");
+    }
+
+    m_workerCount = workerCount;
+
+done:
+    if (FAILED(hr))
+    {
+        FreeResources();
+
+        throw std::system_error{ hr, std::system_category(), exWhatString };
+    }
+}
+
+// --------------------------------------------------------------------
+// Run
+// --------------------------------------------------------------------
+
+void CWorkerPool::Run(FP_WORKER_POOL_TASK pTask, void *pContext, UINT32 taskCount)
+{
+    assert(m_pWork != nullptr);
+    assert(pTask != nullptr);
+
+    if (taskCount == 0) { return; }
+
+    m_pTask = pTask;
+    m_pTaskContext = pContext;
+    m_taskCount = taskCount;
+    m_nextTask = 0;
+
+    // The calling thread takes tasks too, so one worker less is needed
+    const UINT32 submissions{ (std::min)(taskCount - 1, m_workerCount) };
+    for (UINT32 i = 0; i < submissions; i++)
+    {
+        SubmitThreadpoolWork(m_pWork);
+    }
+
+    RunTasks();
+
+    // Join, the callbacks return once no tasks are left
+    WaitForThreadpoolWorkCallbacks(m_pWork, FALSE);
+
+    m_pTask = nullptr;
+    m_pTaskContext = nullptr;
+}
+
+// --------------------------------------------------------------------
+// GetProcessorCount [static]
+// --------------------------------------------------------------------
+
+UINT32 CWorkerPool::GetProcessorCount()
+{
+    const DWORD count{ GetActiveProcessorCount(ALL_PROCESSOR_GROUPS) };
+    return (count > 0) ? static_cast<UINT32>(count) : 1;
+}
+
+// ===============================
+// ====== Private Functions ======
+// ===============================
+
+// --------------------------------------------------------------------
+// RunTasks
+//
+// Claims and runs tasks until none are left.
+// --------------------------------------------------------------------
+
+void CWorkerPool::RunTasks()
+{
+    for (;;)
+    {
+        const LONG task{ InterlockedIncrement(&m_nextTask) - 1 };
+        if (static_cast<UINT32>(task) >= m_taskCount) { break; }
+
+        m_pTask(m_pTaskContext, static_cast<UINT32>(task));
+    }
+}
+
+// --------------------------------------------------------------------
+// FreeResources
+// --------------------------------------------------------------------
+
+void CWorkerPool::FreeResources()
+{
+    // Closing the cleanup group members waits for the callbacks and closes the work object
+    if (m_pCleanupGroup)
+    {
+        CloseThreadpoolCleanupGroupMembers(m_pCleanupGroup, FALSE, nullptr);
+        CloseThreadpoolCleanupGroup(m_pCleanupGroup);
+        m_pCleanupGroup = nullptr;
+        m_pWork = nullptr;
+    }
+    else if (m_pWork)
+    {
+        CloseThreadpoolWork(m_pWork);
+        m_pWork = nullptr;
+    }
+
+    if (m_pPool)
+    {
+        CloseThreadpool(m_pPool);
+        m_pPool = nullptr;
+    }
+
+    m_workerCount = 0;
+}
+
+// --------------------------------------------------------------------
+// WorkCallback [static]
+// --------------------------------------------------------------------
+
+VOID CALLBACK CWorkerPool::WorkCallback(PTP_CALLBACK_INSTANCE /*pInstance*/, PVOID pContext, PTP_WORK /*pWork*/)
+{
+    static_cast<CWorkerPool *>(pContext)->RunTasks();
+}
+
+#pragma managed(pop)
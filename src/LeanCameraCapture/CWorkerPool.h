@@ -0,0 +1,96 @@
+/*-----------------------------------------------------------------*\
+ *
+ * CWorkerPool.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 01:02 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        // ========================================
+        // ====== Function Pointers typedefs ======
+        // ========================================
+
+        /// Task run by the worker pool
+        ///
+        /// pContext    => void* passed to `CWorkerPool::Run`
+        /// taskIndex   => UINT32 index of the task in [0, taskCount)
+        typedef void (*FP_WORKER_POOL_TASK)(void *pContext, UINT32 taskIndex);
+
+        // ==========================================
+        // ====== CWorkerPool Class Definition ======
+        // ==========================================
+
+        /// <summary>
+        /// Persistent pool of worker threads running a batch of tasks at a time, built on
+        ///  a private Windows thread pool so the workers stay alive between frames.
+        /// </summary>
+        class CWorkerPool
+        {
+            /* === Member Functions === */
+        public:
+            CWorkerPool();
+
+            CWorkerPool(const CWorkerPool &) = delete;
+            CWorkerPool &operator=(const CWorkerPool &) = delete;
+
+            /// <summary>
+            /// Create the pool with the passed number of workers, throws `std::system_error` on failure.
+            /// </summary>
+            void Initialize(UINT32 workerCount) noexcept(false);
+
+            /// <summary>
+            /// Run the tasks [0, taskCount) on the workers and the calling thread,
+            ///  and return after all of them complete. Only one batch runs at a time.
+            /// </summary>
+            void Run(FP_WORKER_POOL_TASK pTask, void *pContext, UINT32 taskCount);
+
+            UINT32 GetWorkerCount() const { return m_workerCount; }
+
+            /// <summary>
+            /// Gets the number of logical processors across all processor groups.
+            /// </summary>
+            static UINT32 GetProcessorCount();
+
+            ~CWorkerPool();
+
+        private:
+            void RunTasks();
+
+            void FreeResources();
+
+            static VOID CALLBACK WorkCallback(PTP_CALLBACK_INSTANCE pInstance, PVOID pContext, PTP_WORK pWork);
+
+            /* === Data Members === */
+        private:
+            UINT32                  m_workerCount;
+
+            PTP_POOL                m_pPool;
+            PTP_CLEANUP_GROUP       m_pCleanupGroup;
+            TP_CALLBACK_ENVIRON     m_callbackEnvironment;
+            PTP_WORK                m_pWork;                // Submitted once per worker for each batch.
+
+            // The running batch
+            FP_WORKER_POOL_TASK     m_pTask;
+            void                    *m_pTaskContext;
+            UINT32                  m_taskCount;
+            volatile LONG           m_nextTask;             // Claimed with `InterlockedIncrement`.
+        };
+    }
+}
+
+#pragma managed(pop)
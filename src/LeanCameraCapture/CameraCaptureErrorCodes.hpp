@@ -25,6 +25,11 @@ namespace LeanCameraCapture
         /// </summary>
         static const int DeviceLost = LEANCAMERACAPTURE_E_DEVICELOST;
 
+        /// <summary>
+        /// All the frames of the frame pool are held error code, see `FramePoolExhaustedPolicy.DropFrame`.
+        /// </summary>
+        static const int FramePoolExhausted = LEANCAMERACAPTURE_E_FRAMEPOOLEXHAUSTED;
+
     private:
         CameraCaptureErrorCodes() { } // Static Class
     };
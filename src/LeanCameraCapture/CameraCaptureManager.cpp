@@ -25,11 +25,11 @@ using namespace LeanCameraCapture;
 // Start
 // --------------------------------------------------------------------
 
-void CameraCaptureManager::Start(System::IntPtr MainHWnd)
+void CameraCaptureManager::Start()
 {
     try
     {
-        StartMediaFoundation(static_cast<HWND>(MainHWnd.ToPointer()));
+        StartMediaFoundation();
     }
     catch (const std::system_error &ex)
     {
@@ -37,6 +37,11 @@ void CameraCaptureManager::Start(System::IntPtr MainHWnd)
     }
 }
 
+void CameraCaptureManager::Start(System::IntPtr /*MainHWnd*/)
+{
+    Start();
+}
+
 // --------------------------------------------------------------------
 // Stop
 // --------------------------------------------------------------------
@@ -52,3 +57,65 @@ void CameraCaptureManager::Stop()
         throw gcnew CameraCaptureException(ex.code().value(), gcnew System::String{ ex.what() });
     }
 }
+
+// --------------------------------------------------------------------
+// StartTracing
+// --------------------------------------------------------------------
+
+void CameraCaptureManager::StartTracing()
+{
+    ::StartTracing();
+}
+
+// --------------------------------------------------------------------
+// StopTracing
+// --------------------------------------------------------------------
+
+void CameraCaptureManager::StopTracing()
+{
+    ::StopTracing();
+}
+
+// --------------------------------------------------------------------
+// GetTraceJson
+// --------------------------------------------------------------------
+
+System::String ^CameraCaptureManager::GetTraceJson()
+{
+    try
+    {
+        return gcnew System::String{ GetTraceEventsJson().c_str() };
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        throw gcnew System::OutOfMemoryException("Error occurred while allocating memory for the trace.");
+    }
+}
+
+// ===============================
+// ====== Static Properties ======
+// ===============================
+
+// --------------------------------------------------------------------
+// FrameMemoryBytes
+// --------------------------------------------------------------------
+
+System::UInt64 CameraCaptureManager::FrameMemoryBytes::get()
+{
+    Native::FRAME_MEMORY_STATS stats{};
+    GetFrameMemoryStats(&stats);
+
+    return stats.cbTotal;
+}
+
+// --------------------------------------------------------------------
+// LargePageFrameMemoryBytes
+// --------------------------------------------------------------------
+
+System::UInt64 CameraCaptureManager::LargePageFrameMemoryBytes::get()
+{
+    Native::FRAME_MEMORY_STATS stats{};
+    GetFrameMemoryStats(&stats);
+
+    return stats.cbLargePage;
+}
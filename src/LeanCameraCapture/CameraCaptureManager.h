@@ -24,7 +24,13 @@ namespace LeanCameraCapture
         /// <summary>
         /// Start the infrastructure for the library (Initialize COM and Media Foundation)
         /// </summary>
-        /// <param name="MainHWnd">HWND for main window that can be used to receive notifications.</param>
+        static void Start();
+
+        /// <summary>
+        /// Start the infrastructure for the library (Initialize COM and Media Foundation), same as `Start()`.
+        ///  Kept for the callers passing their main window, which is no longer used.
+        /// </summary>
+        /// <param name="MainHWnd">Unused, device change notifications are received on a thread and a window of the library.</param>
         static void Start(System::IntPtr MainHWnd);
 
         /// <summary>
@@ -32,6 +38,23 @@ namespace LeanCameraCapture
         /// </summary>
         static void Stop();
 
+        /// <summary>
+        /// Start recording a timeline of the capture pipeline of all the readers, dropping the last one.
+        ///  Each thread records into its own buffer without locking, and recording costs nearly nothing while stopped.
+        /// </summary>
+        static void StartTracing();
+
+        /// <summary>
+        /// Stop recording the timeline, the recorded timeline is kept until the next start.
+        /// </summary>
+        static void StopTracing();
+
+        /// <summary>
+        /// Get the recorded timeline as Chrome Trace Event JSON, to be loaded in `chrome://tracing` or Perfetto.
+        ///  Spans are per thread, and the reader of each span is in its args.
+        /// </summary>
+        static System::String ^GetTraceJson();
+
     private:
         CameraCaptureManager() {  } // Static class
 
@@ -44,5 +67,22 @@ namespace LeanCameraCapture
         {
             bool get() { return GetIsMediaFoundationStarted(); }
         }
+
+        /// <summary>
+        /// Bytes of memory allocated for the frames of all the readers.
+        /// </summary>
+        static property System::UInt64 FrameMemoryBytes
+        {
+            System::UInt64 get();
+        }
+
+        /// <summary>
+        /// Bytes of the frame memory backed by large pages, which needs the account to hold the
+        ///  "Lock pages in memory" privilege, the rest is backed by normal pages.
+        /// </summary>
+        static property System::UInt64 LargePageFrameMemoryBytes
+        {
+            System::UInt64 get();
+        }
     };
 }
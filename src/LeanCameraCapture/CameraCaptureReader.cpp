@@ -26,9 +26,33 @@ using namespace LeanCameraCapture;
 // =========================
 
 CameraCaptureReader::CameraCaptureReader(CameraCaptureDevice ^device) :
+    m_bComputeFrameStatistics{ false },
+    m_bAutoReconnect{ false },
+    m_bUseNegotiationCache{ true },
+    m_bLowLatency{ false },
+    m_bPublishLatestFrame{ false },
+    m_bReuseEventArgs{ false },
+    m_bZeroCopy{ false },
+    m_framePool{ nullptr },
+    m_framePoolSize{ 0 },
+    m_framePoolExhaustedPolicy{ LeanCameraCapture::FramePoolExhaustedPolicy::DropFrame },
+    m_frameDecimation{ 0 },
+    m_targetFrameRate{ 0.0 },
+    m_maxFrameAge{ System::TimeSpan::Zero },
+    m_outputWidth{ 0 },
+    m_outputHeight{ 0 },
+    m_resampleFilter{ LeanCameraCapture::ResampleFilter::Bilinear },
+    m_rotation{ FrameRotation::None },
+    m_bMirror{ false },
+    m_bFlipVertically{ false },
+    m_outputPixelFormat{ FramePixelFormat::Bgra32 },
+    m_tensorFormat{ nullptr },
     m_pCSourceReader{ nullptr },
+    m_pCounters{ nullptr },
     m_CSourceReaderReadFrameSuccessHandler{ nullptr },
-    m_CSourceReaderReadFrameFailHandler{ nullptr }
+    m_CSourceReaderReadFrameFailHandler{ nullptr },
+    m_CSourceReaderDeviceReconnectedHandler{ nullptr },
+    m_CSourceReaderFormatChangedHandler{ nullptr }
 {
     if (!device)
     {
@@ -38,13 +62,21 @@ CameraCaptureReader::CameraCaptureReader(CameraCaptureDevice ^device) :
     m_device = device;
 
     m_buffer = nullptr;
+    m_tensorBuffer = nullptr;
 
     m_lock = gcnew System::Object();
+    m_nativeReaderLock = gcnew System::Object();
+
+    m_pCounters = new Native::CReaderCounters();
 
     m_CSourceReaderReadFrameSuccessHandler
         = gcnew ReadFrameSuccessNativeCallback(this, &CameraCaptureReader::ReadFrameSuccessNativeHandler);
     m_CSourceReaderReadFrameFailHandler
         = gcnew ReadFrameFailNativeCallback(this, &CameraCaptureReader::ReadFrameFailNativeHandler);
+    m_CSourceReaderDeviceReconnectedHandler
+        = gcnew DeviceReconnectedNativeCallback(this, &CameraCaptureReader::DeviceReconnectedNativeHandler);
+    m_CSourceReaderFormatChangedHandler
+        = gcnew FormatChangedNativeCallback(this, &CameraCaptureReader::FormatChangedNativeHandler);
 }
 
 // ============================
@@ -67,6 +99,31 @@ void CameraCaptureReader::Open()
     // Prepare the source reader
     try
     {
+        // Set the options needed before initialization.
+        newSourceReader->SetOutputSize(
+            m_outputWidth,
+            m_outputHeight,
+            static_cast<Native::RESAMPLE_FILTER>(m_resampleFilter)
+            );
+        newSourceReader->SetOrientation(static_cast<Native::ROTATION>(m_rotation), m_bMirror, m_bFlipVertically);
+        newSourceReader->SetOutputPixelFormat(static_cast<Native::PIXEL_FORMAT>(m_outputPixelFormat));
+
+        // The format is read on open, later changes to it apply on the next open
+        if (m_tensorFormat)
+        {
+            Native::TENSOR_FORMAT tensorFormat{ m_tensorFormat->ToNative() };
+            newSourceReader->SetTensorFormat(&tensorFormat);
+        }
+        newSourceReader->SetCounters(m_pCounters);
+        newSourceReader->SetUseNegotiationCache(m_bUseNegotiationCache);
+        newSourceReader->SetLowLatency(m_bLowLatency, m_maxFrameAge.Ticks);
+        newSourceReader->SetPublishLatestFrame(m_bPublishLatestFrame);
+        newSourceReader->SetZeroCopy(m_bZeroCopy);
+        newSourceReader->SetFrameDecimation(
+            m_frameDecimation,
+            (m_targetFrameRate > 0.0) ? static_cast<LONGLONG>(10000000.0 / m_targetFrameRate) : 0
+            );
+
         // Initialize native source reader.
         newSourceReader->InitializeForDevice(m_device->GetNativeDeviceSymbolicLink());
     }
@@ -86,6 +143,10 @@ void CameraCaptureReader::Open()
         throw gcnew CameraCaptureException(E_UNEXPECTED, gcnew System::String(ex.what()));
     }
 
+    // Set options
+    newSourceReader->SetComputeFrameStatistics(m_bComputeFrameStatistics);
+    newSourceReader->SetAutoReconnect(m_bAutoReconnect);
+
     // Set handlers
     newSourceReader->SetReadFrameSuccessCallback(
         static_cast<Native::FP_READ_SAMPLE_SUCCESS_HANDLER>(
@@ -99,30 +160,72 @@ void CameraCaptureReader::Open()
             )
     );
 
-    m_pCSourceReader = newSourceReader;
-    // Don't use AddRef, as this is just "moving" the reference not adding new one.
+    newSourceReader->SetDeviceReconnectedCallback(
+        static_cast<Native::FP_DEVICE_RECONNECTED_HANDLER>(
+            Marshal::GetFunctionPointerForDelegate(m_CSourceReaderDeviceReconnectedHandler).ToPointer()
+            )
+    );
+
+    newSourceReader->SetFormatChangedCallback(
+        static_cast<Native::FP_FORMAT_CHANGED_HANDLER>(
+            Marshal::GetFunctionPointerForDelegate(m_CSourceReaderFormatChangedHandler).ToPointer()
+            )
+    );
+
+    // Frames still held from the last open are returned to the old pool and collected with it
+    m_framePool = nullptr;
+    if (m_framePoolSize > 0)
+    {
+        m_framePool = gcnew Stack<PooledFrame ^>(static_cast<System::Int32>(m_framePoolSize));
+        for (System::UInt32 i = 0; i < m_framePoolSize; i++)
+        {
+            m_framePool->Push(gcnew PooledFrame(m_framePool));
+        }
+    }
+
+    {
+        msclr::lock nativeReaderLock{ m_nativeReaderLock };
+
+        m_pCSourceReader = newSourceReader;
+        // Don't use AddRef, as this is just "moving" the reference not adding new one.
+    }
+
+    m_pCounters->AddOpen();
 }
 
 void CameraCaptureReader::Close()
 {
-    // Lock
-    msclr::lock l{ m_lock };
+    Native::CSourceReader *pCSourceReader{ nullptr };
+
+    {
+        // Lock
+        msclr::lock l{ m_lock };
+
+        // Check if the reader is already closed
+        if (!IsOpen) { return; }
+
+        // Copying pointer to a local variable avoiding
+        //  Error C2784 "could not deduce template argument for 'T **' from 'cli::interior_ptr<CSourceReader *>'"
+        // btw, decided not to hop around pin_ptr for this.
+        // A latest frame take in progress holds its own reference, so it's not waited for.
+        msclr::lock nativeReaderLock{ m_nativeReaderLock };
+
+        pCSourceReader = m_pCSourceReader;
+        m_pCSourceReader = nullptr;
+    }
 
-    // Check if the reader is already closed
-    if (!IsOpen) { return; }
+    // Closed outside the lock, as closing waits for the sample being handled, and its handler
+    //  may be waiting for the lock. The handlers see the reader detached and return.
+    pCSourceReader->Close();
 
-    m_pCSourceReader->SetReadFrameSuccessCallback(nullptr);
-    m_pCSourceReader->SetReadFrameFailCallback(nullptr);
-    
-    m_pCSourceReader->Close();
+    // Cleared once no sample is being handled, so a handler isn't cleared while being called
+    pCSourceReader->SetReadFrameSuccessCallback(nullptr);
+    pCSourceReader->SetReadFrameFailCallback(nullptr);
+    pCSourceReader->SetDeviceReconnectedCallback(nullptr);
+    pCSourceReader->SetFormatChangedCallback(nullptr);
 
     // Release the native source reader
-    // Copying pointer to a local variable avoiding
-    //  Error C2784 "could not deduce template argument for 'T **' from 'cli::interior_ptr<CSourceReader *>'"
-    // btw, decided not to hop around pin_ptr for this.
-    Native::CSourceReader *pCSourceReader{ m_pCSourceReader };
     SafeRelease(&pCSourceReader);
-    m_pCSourceReader = nullptr;
 }
 
 void CameraCaptureReader::Reopen()
@@ -131,20 +234,509 @@ void CameraCaptureReader::Reopen()
     Open();
 }
 
+System::Threading::Tasks::Task ^CameraCaptureReader::OpenAsync()
+{
+    return System::Threading::Tasks::Task::Run(gcnew System::Action(this, &CameraCaptureReader::Open));
+}
+
 void CameraCaptureReader::ReadSample()
+{
+    IssueReadSample(nullptr);
+}
+
+void CameraCaptureReader::ReadSampleInto(System::IntPtr scan0, System::Int32 stride, FramePixelFormat pixelFormat)
+{
+    if (scan0 == System::IntPtr::Zero)
+    {
+        throw gcnew System::ArgumentNullException(STRINGIZE(scan0));
+    }
+
+    // Lock
+    msclr::lock l{ m_lock };
+
+    Native::IMAGE_VIEW destination{};
+    destination.pbScanline0 = static_cast<BYTE *>(scan0.ToPointer());
+    destination.lStride = stride;
+    destination.widthInPixels = FrameWidth;
+    destination.heightInPixels = FrameHeight;
+    destination.format = static_cast<Native::PIXEL_FORMAT>(pixelFormat);
+
+    IssueReadSample(&destination);
+}
+
+System::Boolean CameraCaptureReader::TryGetLatestFrame(LatestFrame %frame)
+{
+    Native::TRIPLE_BUFFER_FRAME latestFrame{};
+
+    frame = LatestFrame{};
+
+    if (!m_pCounters)
+    {
+        throw gcnew System::ObjectDisposedException(STRINGIZE(CameraCaptureReader));
+    }
+
+    // Not under `m_lock`, the native reader takes the frame without waiting for the capture.
+    //  A reference is taken instead, so closing meanwhile doesn't free the native reader.
+    Native::CSourceReader *pCSourceReader{ nullptr };
+    {
+        msclr::lock nativeReaderLock{ m_nativeReaderLock };
+
+        pCSourceReader = m_pCSourceReader;
+        if (!pCSourceReader) { return false; }
+
+        pCSourceReader->AddRef();
+    }
+
+    try
+    {
+        if (!pCSourceReader->TryGetLatestFrame(&latestFrame))
+        {
+            return false;
+        }
+
+        frame = LatestFrame(
+            System::IntPtr(const_cast<BYTE *>(latestFrame.pbBuffer)),
+            pCSourceReader->GetFrameStride(),
+            pCSourceReader->GetFrameWidth(),
+            pCSourceReader->GetFrameHeight(),
+            static_cast<FramePixelFormat>(pCSourceReader->GetOutputPixelFormat()),
+            System::TimeSpan::FromTicks(latestFrame.llTimestamp),
+            latestFrame.sequenceNumber,
+            latestFrame.bIsNew
+        );
+    }
+    catch (const std::logic_error &ex)
+    {
+        throw gcnew System::InvalidOperationException(gcnew System::String(ex.what()));
+    }
+    finally
+    {
+        SafeRelease(&pCSourceReader);
+    }
+
+    return true;
+}
+
+void CameraCaptureReader::InjectFaults(System::UInt32 failEveryNthSample, System::Int32 failureHResult, System::TimeSpan sampleDelay)
+{
+    InjectFaults(failEveryNthSample, failureHResult, 0, sampleDelay);
+}
+
+void CameraCaptureReader::InjectFaults(System::UInt32 failEveryNthSample, System::Int32 failureHResult, System::UInt32 changeFormatEveryNthSample, System::TimeSpan sampleDelay)
+{
+    if (sampleDelay < System::TimeSpan::Zero)
+    {
+        throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(sampleDelay), "Sample delay can't be negative.");
+    }
+
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (!IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Faults can be injected only while the reader is open.");
+    }
+
+    Native::FAULT_INJECTION faults{};
+    faults.failEveryNthSample = failEveryNthSample;
+    faults.hrFailure = failureHResult;
+    faults.changeFormatEveryNthSample = changeFormatEveryNthSample;
+    faults.dwSampleDelayMs = static_cast<DWORD>(sampleDelay.TotalMilliseconds);
+
+    m_pCSourceReader->SetFaultInjection(faults);
+}
+
+void CameraCaptureReader::SimulateDeviceRemoval()
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (!IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Device changes can be simulated only while the reader is open.");
+    }
+
+    m_pCSourceReader->SimulateDeviceChange(false);
+}
+
+void CameraCaptureReader::SimulateDeviceArrival()
 {
     // Lock
     msclr::lock l{ m_lock };
 
-    // Check if the reader is closed
     if (!IsOpen)
     {
-        throw gcnew System::InvalidOperationException("Cannot issue a read sample on a closed reader.");
+        throw gcnew System::InvalidOperationException("Device changes can be simulated only while the reader is open.");
+    }
+
+    m_pCSourceReader->SimulateDeviceChange(true);
+}
+
+ReaderStatistics ^CameraCaptureReader::GetStatistics()
+{
+    // No lock, the counters are updated atomically.
+    if (!m_pCounters)
+    {
+        throw gcnew System::ObjectDisposedException(STRINGIZE(CameraCaptureReader));
+    }
+
+    Native::READER_COUNTERS counters{};
+    m_pCounters->GetSnapshot(&counters);
+
+    return gcnew ReaderStatistics(counters);
+}
+
+// ============================
+// ====== Static Methods ======
+// ============================
+
+System::Threading::Tasks::Task ^CameraCaptureReader::OpenAllAsync(
+    IEnumerable<CameraCaptureReader ^> ^readers,
+    System::Int32 maxDegreeOfParallelism
+    )
+{
+    if (readers == nullptr)
+    {
+        throw gcnew System::ArgumentNullException(STRINGIZE(readers));
+    }
+
+    if (maxDegreeOfParallelism < 1)
+    {
+        throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(maxDegreeOfParallelism), "Has to be at least one.");
+    }
+
+    auto operation = gcnew OpenAllOperation(readers, maxDegreeOfParallelism);
+
+    return System::Threading::Tasks::Task::Run(gcnew System::Action(operation, &OpenAllOperation::Run));
+}
+
+void CameraCaptureReader::OpenReader(CameraCaptureReader ^reader)
+{
+    if (reader == nullptr)
+    {
+        throw gcnew System::ArgumentNullException(STRINGIZE(reader));
+    }
+
+    reader->Open();
+}
+
+void CameraCaptureReader::OpenAllOperation::Run()
+{
+    auto options = gcnew System::Threading::Tasks::ParallelOptions();
+    options->MaxDegreeOfParallelism = m_maxDegreeOfParallelism;
+
+    // Each reader initializes its device under its own lock, so the readers don't wait on each other
+    System::Threading::Tasks::Parallel::ForEach(
+        m_readers,
+        options,
+        gcnew System::Action<CameraCaptureReader ^>(&CameraCaptureReader::OpenReader)
+        );
+}
+
+// ================================
+// ====== Property Accessors ======
+// ================================
+
+void CameraCaptureReader::FrameDecimation::set(System::UInt32 value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Frame decimation can't be changed while the reader is open.");
+    }
+
+    m_frameDecimation = value;
+}
+
+void CameraCaptureReader::TargetFrameRate::set(System::Double value)
+{
+    if (!(value >= 0.0) || System::Double::IsInfinity(value))
+    {
+        throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(value), "Target frame rate has to be a finite non-negative number.");
+    }
+
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Target frame rate can't be changed while the reader is open.");
+    }
+
+    m_targetFrameRate = value;
+}
+
+void CameraCaptureReader::ReuseEventArgs::set(System::Boolean value)
+{
+    // Lock, the events are raised under the lock so no handler sees the change midway
+    msclr::lock l{ m_lock };
+
+    m_bReuseEventArgs = value;
+
+    if (!value)
+    {
+        m_reusedReadSampleSucceededEventArgs = nullptr;
+        m_reusedReadSampleIntoCompletedEventArgs = nullptr;
+        m_reusedReadSampleViewReceivedEventArgs = nullptr;
+        m_reusedStatistics = nullptr;
+    }
+}
+
+void CameraCaptureReader::FramePoolSize::set(System::UInt32 value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Frame pool size can't be changed while the reader is open.");
+    }
+
+    m_framePoolSize = value;
+}
+
+void CameraCaptureReader::FramePoolExhaustedPolicy::set(LeanCameraCapture::FramePoolExhaustedPolicy value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    m_framePoolExhaustedPolicy = value;
+}
+
+void CameraCaptureReader::ZeroCopy::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Zero copy mode can't be changed while the reader is open.");
+    }
+
+    m_bZeroCopy = value;
+}
+
+void CameraCaptureReader::PublishLatestFrame::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Latest frame mode can't be changed while the reader is open.");
+    }
+
+    m_bPublishLatestFrame = value;
+}
+
+void CameraCaptureReader::LowLatency::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Low latency mode can't be changed while the reader is open.");
+    }
+
+    m_bLowLatency = value;
+}
+
+void CameraCaptureReader::MaxFrameAge::set(System::TimeSpan value)
+{
+    if (value < System::TimeSpan::Zero)
+    {
+        throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(value), "Max frame age can't be negative.");
+    }
+
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Max frame age can't be changed while the reader is open.");
+    }
+
+    m_maxFrameAge = value;
+}
+
+void CameraCaptureReader::UseNegotiationCache::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Negotiation cache can't be changed while the reader is open.");
     }
 
+    m_bUseNegotiationCache = value;
+}
+
+void CameraCaptureReader::AutoReconnect::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    m_bAutoReconnect = value;
+
+    if (IsOpen)
+    {
+        m_pCSourceReader->SetAutoReconnect(value);
+    }
+}
+
+void CameraCaptureReader::ComputeFrameStatistics::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    m_bComputeFrameStatistics = value;
+
+    if (IsOpen)
+    {
+        m_pCSourceReader->SetComputeFrameStatistics(value);
+    }
+}
+
+void CameraCaptureReader::OutputWidth::set(System::UInt32 value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Output size can't be changed while the reader is open.");
+    }
+
+    m_outputWidth = value;
+}
+
+void CameraCaptureReader::OutputHeight::set(System::UInt32 value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Output size can't be changed while the reader is open.");
+    }
+
+    m_outputHeight = value;
+}
+
+void CameraCaptureReader::ResampleFilter::set(LeanCameraCapture::ResampleFilter value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Resample filter can't be changed while the reader is open.");
+    }
+
+    m_resampleFilter = value;
+}
+
+void CameraCaptureReader::OutputPixelFormat::set(FramePixelFormat value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Output pixel format can't be changed while the reader is open.");
+    }
+
+    m_outputPixelFormat = value;
+}
+
+void CameraCaptureReader::TensorFormat::set(LeanCameraCapture::TensorFormat ^value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Tensor format can't be changed while the reader is open.");
+    }
+
+    m_tensorFormat = value;
+}
+
+void CameraCaptureReader::Rotation::set(FrameRotation value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Orientation can't be changed while the reader is open.");
+    }
+
+    m_rotation = value;
+}
+
+void CameraCaptureReader::Mirror::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Orientation can't be changed while the reader is open.");
+    }
+
+    m_bMirror = value;
+}
+
+void CameraCaptureReader::FlipVertically::set(System::Boolean value)
+{
+    // Lock
+    msclr::lock l{ m_lock };
+
+    if (IsOpen)
+    {
+        throw gcnew System::InvalidOperationException("Orientation can't be changed while the reader is open.");
+    }
+
+    m_bFlipVertically = value;
+}
+
+// =============================
+// ====== Private Methods ======
+// =============================
+
+void CameraCaptureReader::IssueReadSample(const Native::IMAGE_VIEW *pDestination)
+{
+    Native::CSourceReader *pCSourceReader{ nullptr };
+
+    {
+        // Lock
+        msclr::lock l{ m_lock };
+
+        // Check if the reader is closed
+        if (!IsOpen)
+        {
+            throw gcnew System::InvalidOperationException("Cannot issue a read sample on a closed reader.");
+        }
+
+        // Held until the read is issued, a close meanwhile fails the read instead of freeing the reader
+        pCSourceReader = m_pCSourceReader;
+        pCSourceReader->AddRef();
+    }
+
+    // Issued outside the lock, as issuing waits for the native reader's lock, which the sample
+    //  being handled holds while its handler waits for this lock.
     try
     {
-        m_pCSourceReader->ReadFrame();
+        pCSourceReader->ReadFrame(pDestination);
+    }
+    catch (const std::invalid_argument &ex)
+    {
+        throw gcnew System::ArgumentException(gcnew System::String(ex.what()));
     }
     catch (const std::logic_error &ex)
     {
@@ -158,11 +750,21 @@ void CameraCaptureReader::ReadSample()
     {
         throw gcnew CameraCaptureException(E_UNEXPECTED, gcnew System::String(ex.what()));
     }
+    finally
+    {
+        SafeRelease(&pCSourceReader);
+    }
 }
 
-// =============================
-// ====== Private Methods ======
-// =============================
+void CameraCaptureReader::AddDispatchAllocatedBytes(System::Int64 llAllocatedBefore)
+{
+    const System::Int64 llAllocated{ System::GC::GetAllocatedBytesForCurrentThread() - llAllocatedBefore };
+
+    if (llAllocated > 0)
+    {
+        m_pCounters->AddDispatchAllocatedBytes(static_cast<UINT64>(llAllocated));
+    }
+}
 
 void CameraCaptureReader::OnReadSampleSucceeded(System::Object ^sender, ReadSampleSucceededEventArgs ^e)
 {
@@ -174,27 +776,267 @@ void CameraCaptureReader::OnReadSampleFailed(System::Object ^sender, ReadSampleF
     ReadSampleFailed(sender, e);
 }
 
+void CameraCaptureReader::OnReadSampleIntoCompleted(System::Object ^sender, ReadSampleIntoCompletedEventArgs ^e)
+{
+    ReadSampleIntoCompleted(sender, e);
+}
+
+void CameraCaptureReader::OnReadSampleViewReceived(System::Object ^sender, ReadSampleViewReceivedEventArgs ^e)
+{
+    ReadSampleViewReceived(sender, e);
+}
+
+void CameraCaptureReader::OnDeviceReconnected(System::Object ^sender, DeviceReconnectedEventArgs ^e)
+{
+    DeviceReconnected(sender, e);
+}
+
+void CameraCaptureReader::OnFormatChanged(System::Object ^sender, FormatChangedEventArgs ^e)
+{
+    FormatChanged(sender, e);
+}
+
 void CameraCaptureReader::ReadFrameSuccessNativeHandler(
     const BYTE *pbBuffer,
     UINT32 widthInPixels,
     UINT32 heightInPixels,
-    UINT32 bytesPerPixel
+    UINT32 bytesPerPixel,
+    const Native::FRAME_METADATA *pMetadata
 )
 {
+    // Check if the reader is closed, before waiting for the lock closing may hold
+    if (!m_pCSourceReader) { return; }
+
+    // Spans the wait for the lock, the copy, and the handlers of the events
+    Native::CTraceSpan span{ "ManagedDispatch", m_pCSourceReader };
+
     // Lock
     msclr::lock l{ m_lock };
 
+    // Check if the reader was closed while waiting for the lock
+    if (!m_pCSourceReader) { return; }
+
+    // What is allocated up to raising the event is counted, the handlers aren't
+    const System::Int64 llAllocatedBefore{ System::GC::GetAllocatedBytesForCurrentThread() };
+
+    // When reusing, the instances of the last sample are overwritten, so steady capture doesn't allocate
+    FrameStatistics ^statistics{ nullptr };
+    if (pMetadata && pMetadata->pStatistics)
+    {
+        if (m_bReuseEventArgs && m_reusedStatistics)
+        {
+            m_reusedStatistics->Update(*pMetadata->pStatistics);
+            statistics = m_reusedStatistics;
+        }
+        else
+        {
+            statistics = gcnew FrameStatistics(*pMetadata->pStatistics);
+        }
+
+        if (m_bReuseEventArgs) { m_reusedStatistics = statistics; }
+    }
+
+    // Latency is in 100-nanosecond units, same as the ticks of TimeSpan
+    System::Nullable<System::TimeSpan> latency{};
+    if (pMetadata && pMetadata->llLatency >= 0)
+    {
+        latency = System::TimeSpan::FromTicks(pMetadata->llLatency);
+    }
+
+    // The frame is already in the caller's destination, no copy needed.
+    if (pMetadata && pMetadata->pDestination)
+    {
+        ReadSampleIntoCompletedEventArgs ^intoArgs{ nullptr };
+
+        if (m_bReuseEventArgs && m_reusedReadSampleIntoCompletedEventArgs)
+        {
+            intoArgs = m_reusedReadSampleIntoCompletedEventArgs;
+            intoArgs->Update(
+                System::IntPtr(pMetadata->pDestination->pbScanline0),
+                pMetadata->pDestination->lStride,
+                widthInPixels,
+                heightInPixels,
+                static_cast<FramePixelFormat>(pMetadata->pDestination->format),
+                pMetadata->bIsWritten,
+                statistics,
+                latency
+            );
+        }
+        else
+        {
+            intoArgs = gcnew ReadSampleIntoCompletedEventArgs(
+                System::IntPtr(pMetadata->pDestination->pbScanline0),
+                pMetadata->pDestination->lStride,
+                widthInPixels,
+                heightInPixels,
+                static_cast<FramePixelFormat>(pMetadata->pDestination->format),
+                pMetadata->bIsWritten,
+                statistics,
+                latency
+            );
+        }
+
+        if (m_bReuseEventArgs) { m_reusedReadSampleIntoCompletedEventArgs = intoArgs; }
+
+        AddDispatchAllocatedBytes(llAllocatedBefore);
+
+        OnReadSampleIntoCompleted(this, intoArgs);
+        return;
+    }
+
+    // The locked sample is passed as is, and is unlocked once the handlers return
+    if (pMetadata && pMetadata->bIsZeroCopy)
+    {
+        ReadSampleViewReceivedEventArgs ^viewArgs{ nullptr };
+
+        if (m_bReuseEventArgs && m_reusedReadSampleViewReceivedEventArgs)
+        {
+            viewArgs = m_reusedReadSampleViewReceivedEventArgs;
+            viewArgs->Update(
+                System::IntPtr(pMetadata->pView->pbScanline0),
+                pMetadata->pView->lStride,
+                widthInPixels,
+                heightInPixels,
+                static_cast<FramePixelFormat>(pMetadata->pView->format),
+                latency
+            );
+        }
+        else
+        {
+            viewArgs = gcnew ReadSampleViewReceivedEventArgs(
+                System::IntPtr(pMetadata->pView->pbScanline0),
+                pMetadata->pView->lStride,
+                widthInPixels,
+                heightInPixels,
+                static_cast<FramePixelFormat>(pMetadata->pView->format),
+                latency
+            );
+        }
+
+        if (m_bReuseEventArgs) { m_reusedReadSampleViewReceivedEventArgs = viewArgs; }
+
+        AddDispatchAllocatedBytes(llAllocatedBefore);
+
+        try
+        {
+            OnReadSampleViewReceived(this, viewArgs);
+        }
+        finally
+        {
+            viewArgs->Invalidate();
+        }
+
+        return;
+    }
+
     auto bufferLen = widthInPixels * heightInPixels * bytesPerPixel;
-    if (!m_buffer || m_buffer->Length < static_cast<INT32>(bufferLen))
+
+    // With a pool, the sample is copied into a free frame instead of the single buffer
+    PooledFrame ^frame{ nullptr };
+    array<System::Byte> ^buffer{ nullptr };
+    if (m_framePool)
+    {
+        {
+            msclr::lock poolLock{ m_framePool };
+            if (m_framePool->Count > 0) { frame = m_framePool->Pop(); }
+        }
+
+        if (!frame)
+        {
+            if (m_framePoolExhaustedPolicy != LeanCameraCapture::FramePoolExhaustedPolicy::Grow)
+            {
+                // Dropped before copying, the failure lets the consumer read again
+                m_pCounters->AddFramePoolDrop();
+
+                auto failedArgs = gcnew ReadSampleFailedEventArgs(
+                    static_cast<System::Int32>(LEANCAMERACAPTURE_E_FRAMEPOOLEXHAUSTED),
+                    "All the frames of the frame pool are held."
+                );
+
+                AddDispatchAllocatedBytes(llAllocatedBefore);
+
+                OnReadSampleFailed(this, failedArgs);
+                return;
+            }
+
+            frame = gcnew PooledFrame(m_framePool);
+        }
+
+        frame->Rent(widthInPixels, heightInPixels, bytesPerPixel);
+        buffer = frame->GetArray();
+    }
+    else
     {
-        m_buffer = gcnew array<System::Byte>(bufferLen);
+        if (!m_buffer || m_buffer->Length < static_cast<INT32>(bufferLen))
+        {
+            m_buffer = gcnew array<System::Byte>(bufferLen);
+        }
+
+        buffer = m_buffer;
     }
 
-    Marshal::Copy(System::IntPtr(const_cast<void *>(static_cast<const void *>(pbBuffer))), m_buffer, 0, bufferLen);
+    // The rows of the reader's own buffers are padded, so they are copied one by one into the packed array
+    const UINT32 cbRow{ widthInPixels * bytesPerPixel };
+    const LONG lStride{ (pMetadata && pMetadata->pView) ? pMetadata->pView->lStride : static_cast<LONG>(cbRow) };
 
-    OnReadSampleSucceeded(this, gcnew ReadSampleSucceededEventArgs(
-        m_buffer, widthInPixels, heightInPixels, bytesPerPixel
-    ));
+    if (lStride == static_cast<LONG>(cbRow))
+    {
+        Marshal::Copy(System::IntPtr(const_cast<void *>(static_cast<const void *>(pbBuffer))), buffer, 0, bufferLen);
+    }
+    else
+    {
+        for (UINT32 y = 0; y < heightInPixels; y++)
+        {
+            const BYTE *pbRow{ pbBuffer + static_cast<LONG_PTR>(lStride) * y };
+            Marshal::Copy(System::IntPtr(const_cast<BYTE *>(pbRow)), buffer, static_cast<INT32>(y * cbRow), static_cast<INT32>(cbRow));
+        }
+    }
+
+    m_pCounters->AddBytesCopied(bufferLen);
+
+    // The tensor has the exact length, its size is told by the length of the array
+    array<System::Byte> ^tensor{ nullptr };
+    if (pMetadata && pMetadata->pbTensor)
+    {
+        if (!m_tensorBuffer || m_tensorBuffer->Length != static_cast<INT32>(pMetadata->cbTensor))
+        {
+            m_tensorBuffer = gcnew array<System::Byte>(static_cast<INT32>(pMetadata->cbTensor));
+        }
+
+        Marshal::Copy(System::IntPtr(const_cast<BYTE *>(pMetadata->pbTensor)), m_tensorBuffer, 0, m_tensorBuffer->Length);
+
+        m_pCounters->AddBytesCopied(pMetadata->cbTensor);
+
+        tensor = m_tensorBuffer;
+    }
+
+    ReadSampleSucceededEventArgs ^args{ nullptr };
+
+    if (m_bReuseEventArgs && m_reusedReadSampleSucceededEventArgs)
+    {
+        args = m_reusedReadSampleSucceededEventArgs;
+        args->Update(buffer, widthInPixels, heightInPixels, bytesPerPixel, statistics, latency, tensor, frame);
+    }
+    else
+    {
+        args = gcnew ReadSampleSucceededEventArgs(
+            buffer, widthInPixels, heightInPixels, bytesPerPixel, statistics, latency, tensor, frame
+        );
+    }
+
+    if (m_bReuseEventArgs) { m_reusedReadSampleSucceededEventArgs = args; }
+
+    AddDispatchAllocatedBytes(llAllocatedBefore);
+
+    try
+    {
+        OnReadSampleSucceeded(this, args);
+    }
+    finally
+    {
+        // Release the reference of the reader, the frame goes back to the pool unless a handler took a reference
+        if (frame) { delete frame; }
+    }
 }
 
 void CameraCaptureReader::ReadFrameFailNativeHandler(
@@ -202,27 +1044,73 @@ void CameraCaptureReader::ReadFrameFailNativeHandler(
     const std::string &errorString
 )
 {
+    // Check if the reader is closed, before waiting for the lock closing may hold
+    if (!m_pCSourceReader) { return; }
+
     // Lock
     msclr::lock l{ m_lock };
 
+    // Check if the reader was closed while waiting for the lock
+    if (!m_pCSourceReader) { return; }
+
     OnReadSampleFailed(this, gcnew ReadSampleFailedEventArgs(hr, gcnew System::String(errorString.c_str())));
 }
 
+void CameraCaptureReader::DeviceReconnectedNativeHandler(
+    LONGLONG llDowntime
+)
+{
+    // Check if the reader is closed, before waiting for the lock closing may hold
+    if (!m_pCSourceReader) { return; }
+
+    // Lock
+    msclr::lock l{ m_lock };
+
+    // Check if the reader was closed while waiting for the lock
+    if (!m_pCSourceReader) { return; }
+
+    // Downtime is in 100-nanosecond units, same as the ticks of TimeSpan
+    OnDeviceReconnected(this, gcnew DeviceReconnectedEventArgs(System::TimeSpan::FromTicks(llDowntime)));
+}
+
+void CameraCaptureReader::FormatChangedNativeHandler(
+    UINT32 widthInPixels,
+    UINT32 heightInPixels,
+    LONGLONG llReconfigurationTime
+)
+{
+    // Check if the reader is closed, before waiting for the lock closing may hold
+    if (!m_pCSourceReader) { return; }
+
+    // Lock
+    msclr::lock l{ m_lock };
+
+    // Check if the reader was closed while waiting for the lock
+    if (!m_pCSourceReader) { return; }
+
+    // Reconfiguration time is in 100-nanosecond units, same as the ticks of TimeSpan
+    OnFormatChanged(this, gcnew FormatChangedEventArgs(
+        widthInPixels,
+        heightInPixels,
+        System::TimeSpan::FromTicks(llReconfigurationTime)
+    ));
+}
+
 // ========================
 // ====== Destructor ======
 // ========================
 
 CameraCaptureReader::~CameraCaptureReader()
 {
-    // Release managed resources
-    if (m_pCSourceReader)
-    {
-        m_pCSourceReader->SetReadFrameSuccessCallback(nullptr);
-        m_pCSourceReader->SetReadFrameFailCallback(nullptr);
-    }
+    // Closed before releasing managed resources, as closing clears the native callbacks
+    //  once no sample is being handled, so a callback isn't cleared while being called
+    Close();
 
+    // Release managed resources
     m_CSourceReaderReadFrameSuccessHandler = nullptr;
     m_CSourceReaderReadFrameFailHandler = nullptr;
+    m_CSourceReaderDeviceReconnectedHandler = nullptr;
+    m_CSourceReaderFormatChangedHandler = nullptr;
 
     // Call finalizer
     this->!CameraCaptureReader();
@@ -237,13 +1125,23 @@ CameraCaptureReader::!CameraCaptureReader()
     // Release unmanaged resources.
     if (m_pCSourceReader)
     {
-        m_pCSourceReader->Close();
-
         // Copying pointer to a local variable avoiding
         //  Error C2784 "could not deduce template argument for 'T **' from 'cli::interior_ptr<CSourceReader *>'"
         // btw, decided not to hop around pin_ptr for this.
         Native::CSourceReader *pCSourceReader{ m_pCSourceReader };
-        SafeRelease(&pCSourceReader);
         m_pCSourceReader = nullptr;
+
+        pCSourceReader->Close();
+        SafeRelease(&pCSourceReader);
+    }
+
+    // Released after the native reader is closed. A close deferred by the callbacks holds
+    //  its own reference, so the counters are freed once the deferred close is done.
+    if (m_pCounters)
+    {
+        Native::CReaderCounters *pCounters{ m_pCounters };
+        m_pCounters = nullptr;
+
+        SafeRelease(&pCounters);
     }
 }
@@ -41,24 +41,135 @@ namespace LeanCameraCapture
 
         /// <summary>
         /// Reopen reader, same as calling Close() then Open().
+        ///  Can be called from the handlers of the events, the device is released before it is opened again.
         /// </summary>
         void Reopen();
 
         /// <summary>
-        /// Read next available sample from the device.
+        /// Open reader on a thread pool thread, the caller isn't blocked during the initialization
+        ///  of the device. The returned task completes once the reader is open, or faults with
+        ///  the exception `Open()` throws.
+        /// </summary>
+        System::Threading::Tasks::Task ^OpenAsync();
+
+        /// <summary>
+        /// Open the readers concurrently, with at most `maxDegreeOfParallelism` devices being initialized
+        ///  at a time. The returned task completes once all the readers are open, or faults with
+        ///  an `AggregateException` of the readers that failed to open, the other readers stay open.
+        /// The time of each device to its first frame is reported by `GetStatistics()`.
+        /// </summary>
+        /// <param name="readers">Readers to be opened, each reader has to appear once.</param>
+        /// <param name="maxDegreeOfParallelism">Maximum number of readers opened at a time.</param>
+        static System::Threading::Tasks::Task ^OpenAllAsync(
+            IEnumerable<CameraCaptureReader ^> ^readers,
+            System::Int32 maxDegreeOfParallelism
+            );
+
+        /// <summary>
+        /// Read next available sample from the device. Can be called from several threads, the reads are issued
+        ///  one at a time. At most 256 reads can be pending, a read issued beyond that throws a `CameraCaptureException`
+        ///  with the HResult of `MF_E_NOTACCEPTING` (0xC00D36B5) and can be issued again once a pending read completes.
         /// </summary>
         void ReadSample();
 
+        /// <summary>
+        /// Read next available sample from the device directly into the destination,
+        ///  e.g. a `WriteableBitmap` back buffer or a `Bitmap.LockBits` region.
+        /// The destination has to hold `FrameHeight` rows of `FrameWidth` pixels, and stay valid
+        ///  until `ReadSampleIntoCompleted` or `ReadSampleFailed` is raised for this read, or the reader is closed.
+        /// Shares the limit of pending reads with `ReadSample`, a read beyond it throws the same `CameraCaptureException`.
+        /// </summary>
+        /// <param name="scan0">First row of the destination.</param>
+        /// <param name="stride">Bytes between the start of two rows, negative for bottom-up destinations.</param>
+        /// <param name="pixelFormat">Pixel format of the destination, has to match the output format.</param>
+        void ReadSampleInto(System::IntPtr scan0, System::Int32 stride, FramePixelFormat pixelFormat);
+
+        /// <summary>
+        /// Take the latest frame published in `PublishLatestFrame` mode, without copying and without waiting
+        ///  for the reader. Single consumer: the frame of the previous call is given back to the reader on each
+        ///  call, so it has to be called from one thread at a time, and a second thread calling it meanwhile
+        ///  gets an `InvalidOperationException`. Closing the reader meanwhile doesn't wait for the call.
+        /// </summary>
+        /// <param name="frame">The latest frame, valid until the next call or until the reader is closed.</param>
+        /// <returns>False if the reader is closed, isn't in `PublishLatestFrame` mode, or no frame is published yet.</returns>
+        System::Boolean TryGetLatestFrame([System::Runtime::InteropServices::Out] LatestFrame %frame);
+
+        // Hooks for reproducing the recovery paths in tests, visible to the tests project only.
+    internal:
+        /// <summary>
+        /// Inject faults into the next samples of the open reader, for reproducing the recovery paths in tests.
+        ///  Zeros inject nothing. Injected failures raise `ReadSampleFailed` as failures of the device would.
+        /// </summary>
+        /// <param name="failEveryNthSample">Every Nth sample fails, zero for none.</param>
+        /// <param name="failureHResult">HResult of the failed samples, `E_FAIL` if it isn't a failure.</param>
+        /// <param name="sampleDelay">Delay of each sample before the reader handles it, as a slow device.</param>
+        void InjectFaults(System::UInt32 failEveryNthSample, System::Int32 failureHResult, System::TimeSpan sampleDelay);
+
+        /// <summary>
+        /// Inject faults into the next samples of the open reader, for reproducing the recovery paths in tests.
+        ///  Zeros inject nothing. Injected failures raise `ReadSampleFailed` and injected format changes
+        ///  reconfigure the reader and raise `FormatChanged`, as the same events of the device would.
+        /// </summary>
+        /// <param name="failEveryNthSample">Every Nth sample fails, zero for none.</param>
+        /// <param name="failureHResult">HResult of the failed samples, `E_FAIL` if it isn't a failure.</param>
+        /// <param name="changeFormatEveryNthSample">Every Nth sample reports a format change, zero for none.</param>
+        /// <param name="sampleDelay">Delay of each sample before the reader handles it, as a slow device.</param>
+        void InjectFaults(System::UInt32 failEveryNthSample, System::Int32 failureHResult, System::UInt32 changeFormatEveryNthSample, System::TimeSpan sampleDelay);
+
+        /// <summary>
+        /// Handle a removal of the device as if it were notified, for testing the recovery.
+        /// </summary>
+        void SimulateDeviceRemoval();
+
+        /// <summary>
+        /// Handle an arrival of the device as if it were notified, the reader reconnects if `AutoReconnect` is set.
+        /// </summary>
+        void SimulateDeviceArrival();
+
+    public:
+        /// <summary>
+        /// Get a snapshot of the health counters of the reader, counted since the reader was created.
+        /// Doesn't wait for the reader's lock, so it can be polled while frames are being read.
+        /// </summary>
+        ReaderStatistics ^GetStatistics();
+
         /// <summary>
         /// Read sample succeeded event.
         /// </summary>
         event System::EventHandler<ReadSampleSucceededEventArgs ^> ^ReadSampleSucceeded;
 
+        /// <summary>
+        /// Read sample into a destination completed event, raised instead of `ReadSampleSucceeded`
+        ///  for reads issued with `ReadSampleInto`.
+        /// </summary>
+        event System::EventHandler<ReadSampleIntoCompletedEventArgs ^> ^ReadSampleIntoCompleted;
+
+        /// <summary>
+        /// Read sample view received event, raised instead of `ReadSampleSucceeded` in `ZeroCopy` mode
+        ///  for frames passed as the locked buffer of the sample.
+        /// </summary>
+        event System::EventHandler<ReadSampleViewReceivedEventArgs ^> ^ReadSampleViewReceived;
+
         /// <summary>
         /// Read sample failed event
         /// </summary>
         event System::EventHandler<ReadSampleFailedEventArgs ^> ^ReadSampleFailed;
 
+        /// <summary>
+        /// Device reconnected event, raised when `AutoReconnect` is set and the reader resumed
+        ///  after the device was lost and arrived again. Reads pending on losing the device are dropped,
+        ///  so new reads have to be issued.
+        /// </summary>
+        event System::EventHandler<DeviceReconnectedEventArgs ^> ^DeviceReconnected;
+
+        /// <summary>
+        /// Format changed event, raised when the device changed its media type while streaming
+        ///  and the reader was reconfigured for it without reopening, before the first frame of the new size.
+        ///  Reads issued into destinations of the previous size fail. In `PublishLatestFrame` mode, the frame size
+        ///  can't change, so a change of the frame size fails and the reader has to be reopened.
+        /// </summary>
+        event System::EventHandler<FormatChangedEventArgs ^> ^FormatChanged;
+
         ~CameraCaptureReader();
         !CameraCaptureReader();
 
@@ -68,17 +179,53 @@ namespace LeanCameraCapture
 
         void OnReadSampleSucceeded(System::Object ^sender, ReadSampleSucceededEventArgs ^e);
         void OnReadSampleFailed(System::Object ^sender, ReadSampleFailedEventArgs ^e);
+        void OnReadSampleIntoCompleted(System::Object ^sender, ReadSampleIntoCompletedEventArgs ^e);
+        void OnReadSampleViewReceived(System::Object ^sender, ReadSampleViewReceivedEventArgs ^e);
+        void OnDeviceReconnected(System::Object ^sender, DeviceReconnectedEventArgs ^e);
+        void OnFormatChanged(System::Object ^sender, FormatChangedEventArgs ^e);
+
+        void IssueReadSample(const Native::IMAGE_VIEW *pDestination);
+        void AddDispatchAllocatedBytes(System::Int64 llAllocatedBefore);
 
         void ReadFrameSuccessNativeHandler(
             const BYTE *pbBuffer,
             UINT32 widthInPixels,
             UINT32 heightInPixels,
-            UINT32 bytesPerPixel
+            UINT32 bytesPerPixel,
+            const Native::FRAME_METADATA *pMetadata
         );
         void ReadFrameFailNativeHandler(
             const HRESULT hr,
             const std::string &errorString
         );
+        void DeviceReconnectedNativeHandler(
+            LONGLONG llDowntime
+        );
+        void FormatChangedNativeHandler(
+            UINT32 widthInPixels,
+            UINT32 heightInPixels,
+            LONGLONG llReconfigurationTime
+        );
+
+        static void OpenReader(CameraCaptureReader ^reader);
+
+        /// <summary>
+        /// Arguments of `OpenAllAsync()` carried into its task.
+        /// </summary>
+        ref class OpenAllOperation sealed
+        {
+        public:
+            OpenAllOperation(IEnumerable<CameraCaptureReader ^> ^readers, System::Int32 maxDegreeOfParallelism) :
+                m_readers{ readers },
+                m_maxDegreeOfParallelism{ maxDegreeOfParallelism }
+            { }
+
+            void Run();
+
+        private:
+            IEnumerable<CameraCaptureReader ^>  ^m_readers;
+            System::Int32                       m_maxDegreeOfParallelism;
+        };
 
         /* === Delegates === */
     private:
@@ -86,12 +233,21 @@ namespace LeanCameraCapture
             const BYTE *pbBuffer,
             UINT32 widthInPixels,
             UINT32 heightInPixels,
-            UINT32 bytesPerPixel
+            UINT32 bytesPerPixel,
+            const Native::FRAME_METADATA *pMetadata
         );
         delegate void ReadFrameFailNativeCallback(
             const HRESULT hr,
             const std::string &errorString
         );
+        delegate void DeviceReconnectedNativeCallback(
+            LONGLONG llDowntime
+        );
+        delegate void FormatChangedNativeCallback(
+            UINT32 widthInPixels,
+            UINT32 heightInPixels,
+            LONGLONG llReconfigurationTime
+        );
 
         /* === Properties === */
     public:
@@ -111,13 +267,294 @@ namespace LeanCameraCapture
             System::Boolean get() { return m_pCSourceReader != nullptr; }
         }
 
+        /// <summary>
+        /// Gets width of the frames in pixels, zero if the reader is closed.
+        /// </summary>
+        property System::UInt32 FrameWidth
+        {
+            System::UInt32 get() { return IsOpen ? m_pCSourceReader->GetFrameWidth() : 0; }
+        }
+
+        /// <summary>
+        /// Gets height of the frames in pixels, zero if the reader is closed.
+        /// </summary>
+        property System::UInt32 FrameHeight
+        {
+            System::UInt32 get() { return IsOpen ? m_pCSourceReader->GetFrameHeight() : 0; }
+        }
+
+        /// <summary>
+        /// Gets or sets the decimation of the frames, only every Nth frame of the device is delivered,
+        ///  zero or one for every frame. Skipped frames are dropped before being converted or copied.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::UInt32 FrameDecimation
+        {
+            System::UInt32 get() { return m_frameDecimation; }
+            void set(System::UInt32 value);
+        }
+
+        /// <summary>
+        /// Gets or sets the maximum rate of the delivered frames in frames per second, zero for the device rate.
+        ///  Frames are picked from their timestamps, and skipped frames are dropped before being converted or copied.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Double TargetFrameRate
+        {
+            System::Double get() { return m_targetFrameRate; }
+            void set(System::Double value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the event args, and their `FrameStatistics`, are reused for every sample instead of
+        ///  being allocated per sample, so steady capture doesn't allocate on the managed heap when the buffers
+        ///  are read through `ReadSampleSucceededEventArgs.Buffer` and `FrameStatistics.LumaHistogram`,
+        ///  or the views through `ReadSampleViewReceivedEventArgs.CopyTo`.
+        ///  What the reader allocates is counted in `ReaderStatistics.DispatchAllocatedBytes`.
+        /// A reused instance is valid only during its handler, and must not be kept.
+        /// </summary>
+        property System::Boolean ReuseEventArgs
+        {
+            System::Boolean get() { return m_bReuseEventArgs; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets the number of frames of the pool the samples are copied into, zero for a single buffer
+        ///  overwritten by every sample. With a pool, each sample is passed as a `PooledFrame` that can be kept
+        ///  across threads and is returned to the pool on disposing, see `ReadSampleSucceededEventArgs.Frame`.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::UInt32 FramePoolSize
+        {
+            System::UInt32 get() { return m_framePoolSize; }
+            void set(System::UInt32 value);
+        }
+
+        /// <summary>
+        /// Gets or sets what is done with a sample when all the frames of the pool are held, defaults to `DropFrame`.
+        /// </summary>
+        property LeanCameraCapture::FramePoolExhaustedPolicy FramePoolExhaustedPolicy
+        {
+            LeanCameraCapture::FramePoolExhaustedPolicy get() { return m_framePoolExhaustedPolicy; }
+            void set(LeanCameraCapture::FramePoolExhaustedPolicy value);
+        }
+
+        /// <summary>
+        /// Gets or sets if frames that need no conversion are passed with `ReadSampleViewReceived` as the locked
+        ///  buffer of the sample, with no copy. The view keeps the direction of the buffer, so its stride is negative
+        ///  for bottom-up buffers, and `ReadSampleViewReceivedEventArgs.CopyTo` makes a top-down copy on request.
+        ///  Frames that still need a copy, e.g. the luma of YUY2, are raised with `ReadSampleSucceeded`, and
+        ///  `ComputeFrameStatistics` doesn't apply to views. Isn't supported with an output size, orientation,
+        ///  `TensorFormat`, or `PublishLatestFrame`.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Boolean ZeroCopy
+        {
+            System::Boolean get() { return m_bZeroCopy; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the reader reads continuously and publishes each frame for `TryGetLatestFrame`,
+        ///  instead of reading on request. In this mode `ReadSample` and `ReadSampleInto` can't be used
+        ///  and `ReadSampleSucceeded` isn't raised, while `ReadSampleFailed` still is.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Boolean PublishLatestFrame
+        {
+            System::Boolean get() { return m_bPublishLatestFrame; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the reader favors the freshest frame over delivering every frame.
+        /// The device is asked for low latency, and a frame that waited in the queue of the device
+        ///  longer than `MaxFrameAge` is dropped and a newer frame is read instead. The latency
+        ///  of each frame is reported with the frame, if the device reports the capture time.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Boolean LowLatency
+        {
+            System::Boolean get() { return m_bLowLatency; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets the age over the freshest frame seen after which a frame is dropped in `LowLatency` mode,
+        ///  zero for a frame duration of the device.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::TimeSpan MaxFrameAge
+        {
+            System::TimeSpan get() { return m_maxFrameAge; }
+            void set(System::TimeSpan value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the negotiated media type and processor of the device are kept on disk
+        ///  and reused on the next open, skipping the negotiation. The kept negotiation is checked
+        ///  against the device and renegotiated on mismatch. Defaults to true.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Boolean UseNegotiationCache
+        {
+            System::Boolean get() { return m_bUseNegotiationCache; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the reader reconnects to the device when it arrives again after being lost,
+        ///  reusing the negotiated media type, the processor and the buffers.
+        ///  `DeviceReconnected` is raised on reconnecting.
+        /// </summary>
+        property System::Boolean AutoReconnect
+        {
+            System::Boolean get() { return m_bAutoReconnect; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets if frame statistics (luma histogram, channel means, min/max, and sharpness)
+        ///  are computed natively while copying each frame.
+        /// </summary>
+        property System::Boolean ComputeFrameStatistics
+        {
+            System::Boolean get() { return m_bComputeFrameStatistics; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets the width of the frames, zero for the device width.
+        /// Frames are resampled to the output size using `ResampleFilter`.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::UInt32 OutputWidth
+        {
+            System::UInt32 get() { return m_outputWidth; }
+            void set(System::UInt32 value);
+        }
+
+        /// <summary>
+        /// Gets or sets the height of the frames, zero for the device height.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::UInt32 OutputHeight
+        {
+            System::UInt32 get() { return m_outputHeight; }
+            void set(System::UInt32 value);
+        }
+
+        /// <summary>
+        /// Gets or sets the filter used to resample the frames to the output size.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property LeanCameraCapture::ResampleFilter ResampleFilter
+        {
+            LeanCameraCapture::ResampleFilter get() { return m_resampleFilter; }
+            void set(LeanCameraCapture::ResampleFilter value);
+        }
+
+        /// <summary>
+        /// Gets or sets the pixel format of the frames. `Gray8` frames are read from the luma of the device's
+        ///  NV12, I420, or YUY2 frames with no color conversion, and don't support `Rotation`, `Mirror`,
+        ///  or `ComputeFrameStatistics`. Opening fails if the device offers none of these formats.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property FramePixelFormat OutputPixelFormat
+        {
+            FramePixelFormat get() { return m_outputPixelFormat; }
+            void set(FramePixelFormat value);
+        }
+
+        /// <summary>
+        /// Gets or sets the format of the tensor written natively from each frame for ML models, null for none.
+        ///  The frame is resized for the tensor in place of `OutputWidth` and `OutputHeight`, which have to be zero.
+        ///  The tensor is read in a single pass from the native samples if the device delivers NV12, I420, or YUY2,
+        ///  or else it is written from each band of the frame as it is copied. The tensor is passed with
+        ///  `ReadSampleSucceeded`. Needs `Bgra32` frames, and isn't supported with 90 and 270 rotations.
+        /// Can be set only while the reader is closed, and read on open.
+        /// </summary>
+        property LeanCameraCapture::TensorFormat ^TensorFormat
+        {
+            LeanCameraCapture::TensorFormat ^get() { return m_tensorFormat; }
+            void set(LeanCameraCapture::TensorFormat ^value);
+        }
+
+        /// <summary>
+        /// Gets or sets the clockwise rotation of the frames, applied after `Mirror` and `FlipVertically`.
+        /// Rotation happens natively while writing the frame, the output size is the size before rotation.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property FrameRotation Rotation
+        {
+            FrameRotation get() { return m_rotation; }
+            void set(FrameRotation value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the frames are mirrored horizontally.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Boolean Mirror
+        {
+            System::Boolean get() { return m_bMirror; }
+            void set(System::Boolean value);
+        }
+
+        /// <summary>
+        /// Gets or sets if the frames are flipped vertically.
+        /// Can be set only while the reader is closed, and applied on open.
+        /// </summary>
+        property System::Boolean FlipVertically
+        {
+            System::Boolean get() { return m_bFlipVertically; }
+            void set(System::Boolean value);
+        }
+
         /* === Data Members === */
     private:
         CameraCaptureDevice     ^m_device;  // Reference to the device used for the reader.
 
         System::Object          ^m_lock;    // Lock object for synchronization.
 
+        // Held only to swap the native reader or take a reference to it, never while waiting for
+        //  the capture or the handlers, so `TryGetLatestFrame` doesn't wait behind `m_lock`.
+        System::Object          ^m_nativeReaderLock;
+
         array<System::Byte>     ^m_buffer;  // Here we store buffer to avoid multiple invocations of GC.
+        array<System::Byte>     ^m_tensorBuffer;
+
+        Stack<PooledFrame ^>    ^m_framePool;   // Free frames of the pool, null if the pool isn't used.
+        System::UInt32          m_framePoolSize;
+        LeanCameraCapture::FramePoolExhaustedPolicy m_framePoolExhaustedPolicy;
+
+        // Instances of the last sample, overwritten for the next one if `ReuseEventArgs` is set.
+        ReadSampleSucceededEventArgs        ^m_reusedReadSampleSucceededEventArgs;
+        ReadSampleIntoCompletedEventArgs    ^m_reusedReadSampleIntoCompletedEventArgs;
+        ReadSampleViewReceivedEventArgs     ^m_reusedReadSampleViewReceivedEventArgs;
+        FrameStatistics                     ^m_reusedStatistics;
+
+        System::Boolean         m_bComputeFrameStatistics;  // Applied to the native reader on open.
+        System::Boolean         m_bAutoReconnect;           // Applied to the native reader on open.
+        System::Boolean         m_bUseNegotiationCache;     // Applied to the native reader on open.
+        System::Boolean         m_bLowLatency;              // Low latency mode, applied on open.
+        System::Boolean         m_bPublishLatestFrame;      // Applied to the native reader on open.
+        System::Boolean         m_bReuseEventArgs;
+        System::Boolean         m_bZeroCopy;                // Applied to the native reader on open.
+        System::UInt32          m_frameDecimation;          // Decimation, applied on open.
+        System::Double          m_targetFrameRate;
+        System::TimeSpan        m_maxFrameAge;
+
+        System::UInt32                      m_outputWidth;      // Output size and filter, applied on open.
+        System::UInt32                      m_outputHeight;
+        LeanCameraCapture::ResampleFilter   m_resampleFilter;
+
+        FrameRotation                       m_rotation;         // Orientation, applied on open.
+        System::Boolean                     m_bMirror;
+        System::Boolean                     m_bFlipVertically;
+        FramePixelFormat                    m_outputPixelFormat;    // Applied on open.
+        LeanCameraCapture::TensorFormat     ^m_tensorFormat;        // Read on open, null for no tensor.
 
         // On opening the managed reader, a new native reader is allocated and initialized,
         //  and on close, the native reader is released.
@@ -125,10 +562,16 @@ namespace LeanCameraCapture
         //  with CComPtr or track it ourselves with `SafeRelease`
         Native::CSourceReader               *m_pCSourceReader; // Native CSourceReader.
 
+        // Health counters updated by the native reader, kept across reopening the reader
+        //  and freed with the managed reader.
+        Native::CReaderCounters             *m_pCounters;
+
         // Delegates to the underlying native CSourceReader.
         // We save the delegates here as member in the class to avoid them being GCed,
         //  as the CLR won't track the delegate in the native outer space.
         ReadFrameSuccessNativeCallback      ^m_CSourceReaderReadFrameSuccessHandler;
         ReadFrameFailNativeCallback         ^m_CSourceReaderReadFrameFailHandler;
+        DeviceReconnectedNativeCallback     ^m_CSourceReaderDeviceReconnectedHandler;
+        FormatChangedNativeCallback         ^m_CSourceReaderFormatChangedHandler;
     };
 }
@@ -0,0 +1,45 @@
+/*-----------------------------------------------------------------*\
+ *
+ * DeviceReconnectedEventArgs.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 03:36 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Provides data for DeviceReconnected event.
+    /// </summary>
+    public ref class DeviceReconnectedEventArgs : public System::EventArgs
+    {
+        /* === Constructor === */
+    public:
+        DeviceReconnectedEventArgs(System::TimeSpan downtime) :
+            m_downtime{ downtime }
+        { }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the time from losing the device to resuming the reader.
+        /// </summary>
+        property System::TimeSpan Downtime
+        {
+            System::TimeSpan get() { return m_downtime; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::TimeSpan    m_downtime;
+    };
+}
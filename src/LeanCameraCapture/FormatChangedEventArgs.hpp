@@ -0,0 +1,65 @@
+/*-----------------------------------------------------------------*\
+ *
+ * FormatChangedEventArgs.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 11:02 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Provides data for FormatChanged event.
+    /// </summary>
+    public ref class FormatChangedEventArgs : public System::EventArgs
+    {
+        /* === Constructor === */
+    public:
+        FormatChangedEventArgs(System::UInt32 width, System::UInt32 height, System::TimeSpan reconfigurationTime) :
+            m_width{ width },
+            m_height{ height },
+            m_reconfigurationTime{ reconfigurationTime }
+        { }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the width of the frames from now on.
+        /// </summary>
+        property System::UInt32 Width
+        {
+            System::UInt32 get() { return m_width; }
+        }
+
+        /// <summary>
+        /// Gets the height of the frames from now on.
+        /// </summary>
+        property System::UInt32 Height
+        {
+            System::UInt32 get() { return m_height; }
+        }
+
+        /// <summary>
+        /// Gets the time taken to reconfigure the reader for the new media type.
+        /// </summary>
+        property System::TimeSpan ReconfigurationTime
+        {
+            System::TimeSpan get() { return m_reconfigurationTime; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::UInt32      m_width;
+        System::UInt32      m_height;
+        System::TimeSpan    m_reconfigurationTime;
+    };
+}
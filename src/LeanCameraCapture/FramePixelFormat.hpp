@@ -0,0 +1,37 @@
+/*-----------------------------------------------------------------*\
+ *
+ * FramePixelFormat.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 12:41 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Pixel format of the frames written by a reader.
+    /// </summary>
+    public enum class FramePixelFormat
+    {
+        /// <summary>
+        /// 32 bits per pixel, blue, green, red, and alpha bytes in order.
+        /// Same as `PixelFormats.Bgra32` and `PixelFormat.Format32bppArgb` on little-endian.
+        /// </summary>
+        Bgra32 = static_cast<int>(Native::PIXEL_FORMAT::BGRA32),
+
+        /// <summary>
+        /// 8 bits per pixel, the luma of the frame.
+        /// Same as `PixelFormats.Gray8`.
+        /// </summary>
+        Gray8 = static_cast<int>(Native::PIXEL_FORMAT::GRAY8)
+    };
+}
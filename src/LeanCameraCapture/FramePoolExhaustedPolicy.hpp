@@ -0,0 +1,36 @@
+/*-----------------------------------------------------------------*\
+ *
+ * FramePoolExhaustedPolicy.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:48 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// What a reader does with a sample when all the frames of its pool are held, see `CameraCaptureReader.FramePoolSize`.
+    /// </summary>
+    public enum class FramePoolExhaustedPolicy
+    {
+        /// <summary>
+        /// The sample is dropped before being copied, and `ReadSampleFailed` is raised
+        ///  with `CameraCaptureErrorCodes.FramePoolExhausted`.
+        /// </summary>
+        DropFrame,
+
+        /// <summary>
+        /// A new frame is allocated and added to the pool.
+        /// </summary>
+        Grow
+    };
+}
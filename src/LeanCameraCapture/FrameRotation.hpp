@@ -0,0 +1,45 @@
+/*-----------------------------------------------------------------*\
+ *
+ * FrameRotation.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 12:24 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Clockwise rotation applied to the frames of a reader, e.g. for portrait-mounted cameras.
+    /// </summary>
+    public enum class FrameRotation
+    {
+        /// <summary>
+        /// Frames are kept as captured.
+        /// </summary>
+        None = static_cast<int>(Native::ROTATION::NONE),
+
+        /// <summary>
+        /// Frames are rotated 90 degrees clockwise, width and height are swapped.
+        /// </summary>
+        Clockwise90 = static_cast<int>(Native::ROTATION::CLOCKWISE_90),
+
+        /// <summary>
+        /// Frames are rotated 180 degrees.
+        /// </summary>
+        Clockwise180 = static_cast<int>(Native::ROTATION::CLOCKWISE_180),
+
+        /// <summary>
+        /// Frames are rotated 270 degrees clockwise, width and height are swapped.
+        /// </summary>
+        Clockwise270 = static_cast<int>(Native::ROTATION::CLOCKWISE_270)
+    };
+}
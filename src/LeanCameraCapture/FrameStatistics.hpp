@@ -0,0 +1,204 @@
+/*-----------------------------------------------------------------*\
+ *
+ * FrameStatistics.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 10:31 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+using namespace System::Collections::Generic;
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Statistics computed natively over a frame while it is being copied.
+    /// </summary>
+    public ref class FrameStatistics sealed
+    {
+        /* === Constructor === */
+    internal:
+        FrameStatistics(const Native::FRAME_STATISTICS &statistics)
+        {
+            // Set in the body for the same reason as `ReadSampleSucceededEventArgs`, error `C2440`.
+            m_lumaHistogram = gcnew array<System::UInt32>(256);
+
+            Update(statistics);
+        }
+
+        /// <summary>
+        /// Overwrite with the statistics of another frame, reusing the histogram array.
+        /// </summary>
+        void Update(const Native::FRAME_STATISTICS &statistics)
+        {
+            m_meanLuma = statistics.meanLuma;
+            m_meanBlue = statistics.meanBlue;
+            m_meanGreen = statistics.meanGreen;
+            m_meanRed = statistics.meanRed;
+            m_minLuma = statistics.minLuma;
+            m_minBlue = statistics.minBlue;
+            m_minGreen = statistics.minGreen;
+            m_minRed = statistics.minRed;
+            m_maxLuma = statistics.maxLuma;
+            m_maxBlue = statistics.maxBlue;
+            m_maxGreen = statistics.maxGreen;
+            m_maxRed = statistics.maxRed;
+            m_sharpness = statistics.sharpness;
+
+            for (int i = 0; i < 256; i++)
+            {
+                m_lumaHistogram[i] = statistics.lumaHistogram[i];
+            }
+        }
+
+        /* === Methods === */
+    public:
+        /// <summary>
+        /// Get the 256-bin luma histogram of the frame.
+        /// </summary>
+        IReadOnlyCollection<System::UInt32> ^GetLumaHistogram()
+        {
+            return System::Array::AsReadOnly(m_lumaHistogram);
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the 256-bin luma histogram of the frame without copying or allocating.
+        /// </summary>
+        property System::ReadOnlyMemory<System::UInt32> LumaHistogram
+        {
+            System::ReadOnlyMemory<System::UInt32> get() { return System::ReadOnlyMemory<System::UInt32>(m_lumaHistogram); }
+        }
+
+        /// <summary>
+        /// Gets mean luma (brightness) of the frame.
+        /// </summary>
+        property System::Double MeanLuma
+        {
+            System::Double get() { return m_meanLuma; }
+        }
+
+        /// <summary>
+        /// Gets mean of the blue channel.
+        /// </summary>
+        property System::Double MeanBlue
+        {
+            System::Double get() { return m_meanBlue; }
+        }
+
+        /// <summary>
+        /// Gets mean of the green channel.
+        /// </summary>
+        property System::Double MeanGreen
+        {
+            System::Double get() { return m_meanGreen; }
+        }
+
+        /// <summary>
+        /// Gets mean of the red channel.
+        /// </summary>
+        property System::Double MeanRed
+        {
+            System::Double get() { return m_meanRed; }
+        }
+
+        /// <summary>
+        /// Gets minimum luma of the frame.
+        /// </summary>
+        property System::Byte MinLuma
+        {
+            System::Byte get() { return m_minLuma; }
+        }
+
+        /// <summary>
+        /// Gets minimum of the blue channel.
+        /// </summary>
+        property System::Byte MinBlue
+        {
+            System::Byte get() { return m_minBlue; }
+        }
+
+        /// <summary>
+        /// Gets minimum of the green channel.
+        /// </summary>
+        property System::Byte MinGreen
+        {
+            System::Byte get() { return m_minGreen; }
+        }
+
+        /// <summary>
+        /// Gets minimum of the red channel.
+        /// </summary>
+        property System::Byte MinRed
+        {
+            System::Byte get() { return m_minRed; }
+        }
+
+        /// <summary>
+        /// Gets maximum luma of the frame.
+        /// </summary>
+        property System::Byte MaxLuma
+        {
+            System::Byte get() { return m_maxLuma; }
+        }
+
+        /// <summary>
+        /// Gets maximum of the blue channel.
+        /// </summary>
+        property System::Byte MaxBlue
+        {
+            System::Byte get() { return m_maxBlue; }
+        }
+
+        /// <summary>
+        /// Gets maximum of the green channel.
+        /// </summary>
+        property System::Byte MaxGreen
+        {
+            System::Byte get() { return m_maxGreen; }
+        }
+
+        /// <summary>
+        /// Gets maximum of the red channel.
+        /// </summary>
+        property System::Byte MaxRed
+        {
+            System::Byte get() { return m_maxRed; }
+        }
+
+        /// <summary>
+        /// Gets sharpness score of the frame, the variance of the Laplacian over luma.
+        /// Higher is sharper.
+        /// </summary>
+        property System::Double Sharpness
+        {
+            System::Double get() { return m_sharpness; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        array<System::UInt32>   ^m_lumaHistogram;
+        System::Double          m_meanLuma;
+        System::Double          m_meanBlue;
+        System::Double          m_meanGreen;
+        System::Double          m_meanRed;
+        System::Byte            m_minLuma;
+        System::Byte            m_minBlue;
+        System::Byte            m_minGreen;
+        System::Byte            m_minRed;
+        System::Byte            m_maxLuma;
+        System::Byte            m_maxBlue;
+        System::Byte            m_maxGreen;
+        System::Byte            m_maxRed;
+        System::Double          m_sharpness;
+    };
+}
@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------*\
+ *
+ * LatestFrame.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 05:44 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Latest frame published by a reader, see `CameraCaptureReader.TryGetLatestFrame`.
+    /// The frame memory is owned by the reader and stays valid until the next call
+    ///  to `TryGetLatestFrame` or until the reader is closed.
+    /// </summary>
+    public value class LatestFrame
+    {
+        /* === Constructor === */
+    internal:
+        LatestFrame(
+            System::IntPtr scan0,
+            System::Int32 stride,
+            System::UInt32 widthInPixels,
+            System::UInt32 heightInPixels,
+            FramePixelFormat pixelFormat,
+            System::TimeSpan timestamp,
+            System::UInt64 sequenceNumber,
+            System::Boolean isNew) :
+            m_scan0{ scan0 },
+            m_stride{ stride },
+            m_widthInPixels{ widthInPixels },
+            m_heightInPixels{ heightInPixels },
+            m_pixelFormat{ pixelFormat },
+            m_timestamp{ timestamp },
+            m_sequenceNumber{ sequenceNumber },
+            m_isNew{ isNew }
+        {
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the first row of the frame.
+        /// </summary>
+        property System::IntPtr Scan0
+        {
+            System::IntPtr get() { return m_scan0; }
+        }
+
+        /// <summary>
+        /// Gets the bytes between the start of two rows of the frame.
+        /// </summary>
+        property System::Int32 Stride
+        {
+            System::Int32 get() { return m_stride; }
+        }
+
+        /// <summary>
+        /// Gets frame width in pixels.
+        /// </summary>
+        property System::UInt32 WidthInPixels
+        {
+            System::UInt32 get() { return m_widthInPixels; }
+        }
+
+        /// <summary>
+        /// Gets frame height in pixels.
+        /// </summary>
+        property System::UInt32 HeightInPixels
+        {
+            System::UInt32 get() { return m_heightInPixels; }
+        }
+
+        /// <summary>
+        /// Gets pixel format of the frame.
+        /// </summary>
+        property FramePixelFormat PixelFormat
+        {
+            FramePixelFormat get() { return m_pixelFormat; }
+        }
+
+        /// <summary>
+        /// Gets the sample time of the frame.
+        /// </summary>
+        property System::TimeSpan Timestamp
+        {
+            System::TimeSpan get() { return m_timestamp; }
+        }
+
+        /// <summary>
+        /// Gets the number of the frame since the reader was opened, starting at one.
+        ///  A gap from the previous call is the number of frames that weren't taken.
+        /// </summary>
+        property System::UInt64 SequenceNumber
+        {
+            System::UInt64 get() { return m_sequenceNumber; }
+        }
+
+        /// <summary>
+        /// Gets if the frame was published since the last call, false if it's the same frame again.
+        /// </summary>
+        property System::Boolean IsNew
+        {
+            System::Boolean get() { return m_isNew; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::IntPtr          m_scan0;
+        System::Int32           m_stride;
+        System::UInt32          m_widthInPixels;
+        System::UInt32          m_heightInPixels;
+        FramePixelFormat        m_pixelFormat;
+        System::TimeSpan        m_timestamp;
+        System::UInt64          m_sequenceNumber;
+        System::Boolean         m_isNew;
+    };
+}
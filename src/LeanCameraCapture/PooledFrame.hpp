@@ -0,0 +1,162 @@
+/*-----------------------------------------------------------------*\
+ *
+ * PooledFrame.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:51 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+using namespace System::Collections::Generic;
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Frame from the pool of a reader, see `CameraCaptureReader.FramePoolSize`.
+    /// The frame is reference counted, the reader holds a reference while raising `ReadSampleSucceeded`
+    ///  and releases it after the handlers return. To keep the frame after the handler, e.g. for handing
+    ///  it to another thread, take a reference with `AddReference` and dispose the frame once per reference
+    ///  when done with it. The frame goes back to the pool when the last reference is released.
+    /// </summary>
+    public ref class PooledFrame sealed
+    {
+        /* === Constructor === */
+    internal:
+        PooledFrame(Stack<PooledFrame ^> ^pool) :
+            m_pool{ pool },
+            m_references{ 0 },
+            m_widthInPixels{ 0 },
+            m_heightInPixels{ 0 },
+            m_bytesPerPixel{ 0 }
+        {
+        }
+
+        /// <summary>
+        /// Take the frame from the pool for a sample, with a single reference held by the reader.
+        /// </summary>
+        void Rent(System::UInt32 widthInPixels, System::UInt32 heightInPixels, System::UInt32 bytesPerPixel)
+        {
+            auto length = static_cast<System::Int32>(widthInPixels * heightInPixels * bytesPerPixel);
+
+            // The array only grows, so the frames stop allocating once they fit the size of the samples
+            if (!m_buffer || m_buffer->Length < length)
+            {
+                m_buffer = gcnew array<System::Byte>(length);
+            }
+
+            m_widthInPixels = widthInPixels;
+            m_heightInPixels = heightInPixels;
+            m_bytesPerPixel = bytesPerPixel;
+
+            m_references = 1;
+        }
+
+        array<System::Byte> ^GetArray() { return m_buffer; }
+
+        /* === Destructor === */
+    public:
+        /// <summary>
+        /// Release a reference of the frame.
+        /// </summary>
+        ~PooledFrame()
+        {
+            // A compare exchange loop, so disposing more than the references can't send the frame to the pool twice
+            System::Int32 references{ 0 };
+            do
+            {
+                references = m_references;
+                if (references == 0) { return; }
+            } while (System::Threading::Interlocked::CompareExchange(m_references, references - 1, references) != references);
+
+            if (references == 1)
+            {
+                // The reader rents from the pool under the same lock
+                System::Threading::Monitor::Enter(m_pool);
+                try
+                {
+                    m_pool->Push(this);
+                }
+                finally
+                {
+                    System::Threading::Monitor::Exit(m_pool);
+                }
+            }
+        }
+
+        /* === Methods === */
+    public:
+        /// <summary>
+        /// Take a reference of the frame, to be released by disposing the frame.
+        /// </summary>
+        /// <returns>The same frame.</returns>
+        PooledFrame ^AddReference()
+        {
+            System::Int32 references{ 0 };
+            do
+            {
+                references = m_references;
+                if (references == 0)
+                {
+                    throw gcnew System::ObjectDisposedException(STRINGIZE(PooledFrame), "The frame is back in the pool.");
+                }
+            } while (System::Threading::Interlocked::CompareExchange(m_references, references + 1, references) != references);
+
+            return this;
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the frame's buffer, use `Span` of the memory to read it.
+        /// </summary>
+        property System::ReadOnlyMemory<System::Byte> Buffer
+        {
+            System::ReadOnlyMemory<System::Byte> get()
+            {
+                // The array is reused across samples, so it can be longer than the frame
+                return System::ReadOnlyMemory<System::Byte>(m_buffer, 0, static_cast<int>(m_widthInPixels * m_heightInPixels * m_bytesPerPixel));
+            }
+        }
+
+        /// <summary>
+        /// Gets frame width in pixels.
+        /// </summary>
+        property System::UInt32 WidthInPixels
+        {
+            System::UInt32 get() { return m_widthInPixels; }
+        }
+
+        /// <summary>
+        /// Gets frame height in pixels.
+        /// </summary>
+        property System::UInt32 HeightInPixels
+        {
+            System::UInt32 get() { return m_heightInPixels; }
+        }
+
+        /// <summary>
+        /// Gets bytes per pixel.
+        /// </summary>
+        property System::UInt32 BytesPerPixel
+        {
+            System::UInt32 get() { return m_bytesPerPixel; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        Stack<PooledFrame ^>    ^m_pool;
+        array<System::Byte>     ^m_buffer;
+        System::Int32           m_references;
+        System::UInt32          m_widthInPixels;
+        System::UInt32          m_heightInPixels;
+        System::UInt32          m_bytesPerPixel;
+    };
+}
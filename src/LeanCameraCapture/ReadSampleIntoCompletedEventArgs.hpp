@@ -0,0 +1,143 @@
+/*-----------------------------------------------------------------*\
+ *
+ * ReadSampleIntoCompletedEventArgs.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 12:44 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Provides data for ReadSampleIntoCompleted event.
+    /// </summary>
+    public ref class ReadSampleIntoCompletedEventArgs : public System::EventArgs
+    {
+        /* === Constructor === */
+    public:
+        ReadSampleIntoCompletedEventArgs(
+            System::IntPtr scan0,
+            System::Int32 stride,
+            System::UInt32 widthInPixels,
+            System::UInt32 heightInPixels,
+            FramePixelFormat pixelFormat,
+            System::Boolean isFrameWritten,
+            FrameStatistics ^statistics,
+            System::Nullable<System::TimeSpan> latency)
+        {
+            Update(scan0, stride, widthInPixels, heightInPixels, pixelFormat, isFrameWritten, statistics, latency);
+        }
+
+    internal:
+        /// <summary>
+        /// Overwrite with the data of another read, for reusing the instance.
+        /// </summary>
+        void Update(
+            System::IntPtr scan0,
+            System::Int32 stride,
+            System::UInt32 widthInPixels,
+            System::UInt32 heightInPixels,
+            FramePixelFormat pixelFormat,
+            System::Boolean isFrameWritten,
+            FrameStatistics ^statistics,
+            System::Nullable<System::TimeSpan> latency)
+        {
+            m_scan0 = scan0;
+            m_stride = stride;
+            m_widthInPixels = widthInPixels;
+            m_heightInPixels = heightInPixels;
+            m_pixelFormat = pixelFormat;
+            m_isFrameWritten = isFrameWritten;
+            m_statistics = statistics;
+            m_latency = latency;
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the first row of the destination passed to `ReadSampleInto`.
+        /// </summary>
+        property System::IntPtr Scan0
+        {
+            System::IntPtr get() { return m_scan0; }
+        }
+
+        /// <summary>
+        /// Gets the stride of the destination passed to `ReadSampleInto`.
+        /// </summary>
+        property System::Int32 Stride
+        {
+            System::Int32 get() { return m_stride; }
+        }
+
+        /// <summary>
+        /// Gets frame width in pixels.
+        /// </summary>
+        property System::UInt32 WidthInPixels
+        {
+            System::UInt32 get() { return m_widthInPixels; }
+        }
+
+        /// <summary>
+        /// Gets frame height in pixels.
+        /// </summary>
+        property System::UInt32 HeightInPixels
+        {
+            System::UInt32 get() { return m_heightInPixels; }
+        }
+
+        /// <summary>
+        /// Gets pixel format of the destination.
+        /// </summary>
+        property FramePixelFormat PixelFormat
+        {
+            FramePixelFormat get() { return m_pixelFormat; }
+        }
+
+        /// <summary>
+        /// Gets if a frame was written into the destination,
+        ///  false if the device delivered no sample for this read e.g. a gap in the stream.
+        /// </summary>
+        property System::Boolean IsFrameWritten
+        {
+            System::Boolean get() { return m_isFrameWritten; }
+        }
+
+        /// <summary>
+        /// Gets the frame statistics, or null if `CameraCaptureReader.ComputeFrameStatistics` isn't set.
+        /// </summary>
+        property FrameStatistics ^Statistics
+        {
+            FrameStatistics ^get() { return m_statistics; }
+        }
+
+        /// <summary>
+        /// Gets the time from the capture of the frame by the device to its delivery,
+        ///  or null if the device doesn't report the capture time.
+        /// </summary>
+        property System::Nullable<System::TimeSpan> Latency
+        {
+            System::Nullable<System::TimeSpan> get() { return m_latency; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::IntPtr          m_scan0;
+        System::Int32           m_stride;
+        System::UInt32          m_widthInPixels;
+        System::UInt32          m_heightInPixels;
+        FramePixelFormat        m_pixelFormat;
+        System::Boolean         m_isFrameWritten;
+        FrameStatistics         ^m_statistics;
+        System::Nullable<System::TimeSpan>  m_latency;
+    };
+}
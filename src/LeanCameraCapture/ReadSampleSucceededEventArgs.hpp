@@ -30,15 +30,40 @@ namespace LeanCameraCapture
             array<System::Byte> ^buffer,
             System::UInt32 widthInPixels,
             System::UInt32 heightInPixels,
-            System::UInt32 bytesPerPixel) :
-            m_widthInPixels{ widthInPixels },
-            m_heightInPixels{ heightInPixels },
-            m_bytesPerPixel{ bytesPerPixel }
+            System::UInt32 bytesPerPixel,
+            FrameStatistics ^statistics,
+            System::Nullable<System::TimeSpan> latency,
+            array<System::Byte> ^tensor,
+            PooledFrame ^frame)
         {
-            // We set the array in the body of the constructor not in the initializer list
+            // We set the arrays in the body of the constructor not in the initializer list
             //  as a workaround for error `C2440`:
             //  `Initialization of a managed array with an initializer list is not supported in this context`
+            Update(buffer, widthInPixels, heightInPixels, bytesPerPixel, statistics, latency, tensor, frame);
+        }
+
+    internal:
+        /// <summary>
+        /// Overwrite with the data of another sample, for reusing the instance.
+        /// </summary>
+        void Update(
+            array<System::Byte> ^buffer,
+            System::UInt32 widthInPixels,
+            System::UInt32 heightInPixels,
+            System::UInt32 bytesPerPixel,
+            FrameStatistics ^statistics,
+            System::Nullable<System::TimeSpan> latency,
+            array<System::Byte> ^tensor,
+            PooledFrame ^frame)
+        {
             m_buffer = buffer;
+            m_widthInPixels = widthInPixels;
+            m_heightInPixels = heightInPixels;
+            m_bytesPerPixel = bytesPerPixel;
+            m_statistics = statistics;
+            m_latency = latency;
+            m_tensor = tensor;
+            m_frame = frame;
         }
 
         /* === Methods === */
@@ -57,8 +82,47 @@ namespace LeanCameraCapture
             return System::Array::AsReadOnly(m_buffer);
         }
 
+        /// <summary>
+        /// Copy the tensor written from the sample into an array of its element type,
+        ///  e.g. `float[]` for `TensorDataType.Float32` and `ushort[]` for `TensorDataType.Float16`.
+        /// </summary>
+        /// <param name="destination">Array of at least `TensorByteCount` bytes.</param>
+        void CopyTensorTo(System::Array ^destination)
+        {
+            if (!m_tensor)
+            {
+                throw gcnew System::InvalidOperationException("No tensor is written, `CameraCaptureReader.TensorFormat` isn't set.");
+            }
+
+            System::Buffer::BlockCopy(m_tensor, 0, destination, 0, m_tensor->Length);
+        }
+
         /* === Properties === */
     public:
+        /// <summary>
+        /// Gets the sample's buffer without copying or allocating, use `Span` of the memory to read it.
+        /// </summary>
+        property System::ReadOnlyMemory<System::Byte> Buffer
+        {
+            System::ReadOnlyMemory<System::Byte> get()
+            {
+                // The buffer is reused across samples, so it can be longer than the sample
+                return System::ReadOnlyMemory<System::Byte>(m_buffer, 0, static_cast<int>(m_widthInPixels * m_heightInPixels * m_bytesPerPixel));
+            }
+        }
+
+        /// <summary>
+        /// Gets the tensor written from the sample without copying or allocating,
+        ///  empty if `CameraCaptureReader.TensorFormat` isn't set.
+        /// </summary>
+        property System::ReadOnlyMemory<System::Byte> Tensor
+        {
+            System::ReadOnlyMemory<System::Byte> get()
+            {
+                return m_tensor ? System::ReadOnlyMemory<System::Byte>(m_tensor) : System::ReadOnlyMemory<System::Byte>::Empty;
+            }
+        }
+
         /// <summary>
         /// Gets sample width in pixels.
         /// </summary>
@@ -83,11 +147,49 @@ namespace LeanCameraCapture
             System::UInt32 get() { return m_bytesPerPixel; }
         }
 
+        /// <summary>
+        /// Gets the bytes of the tensor written from the sample, zero if `CameraCaptureReader.TensorFormat` isn't set.
+        /// </summary>
+        property System::Int32 TensorByteCount
+        {
+            System::Int32 get() { return m_tensor ? m_tensor->Length : 0; }
+        }
+
+        /// <summary>
+        /// Gets the pooled frame holding the sample's buffer, or null if `CameraCaptureReader.FramePoolSize` is zero.
+        ///  Take a reference with `PooledFrame.AddReference` to keep the frame after the handler.
+        /// </summary>
+        property PooledFrame ^Frame
+        {
+            PooledFrame ^get() { return m_frame; }
+        }
+
+        /// <summary>
+        /// Gets the frame statistics, or null if `CameraCaptureReader.ComputeFrameStatistics` isn't set.
+        /// </summary>
+        property FrameStatistics ^Statistics
+        {
+            FrameStatistics ^get() { return m_statistics; }
+        }
+
+        /// <summary>
+        /// Gets the time from the capture of the frame by the device to its delivery,
+        ///  or null if the device doesn't report the capture time.
+        /// </summary>
+        property System::Nullable<System::TimeSpan> Latency
+        {
+            System::Nullable<System::TimeSpan> get() { return m_latency; }
+        }
+
         /* === Backing Fields === */
     private:
         array<System::Byte>     ^m_buffer;
+        array<System::Byte>     ^m_tensor;
         System::UInt32          m_widthInPixels;
         System::UInt32          m_heightInPixels;
         System::UInt32          m_bytesPerPixel;
+        FrameStatistics         ^m_statistics;
+        PooledFrame             ^m_frame;
+        System::Nullable<System::TimeSpan>  m_latency;
     };
 }
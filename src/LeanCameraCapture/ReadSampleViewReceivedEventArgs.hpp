@@ -0,0 +1,186 @@
+/*-----------------------------------------------------------------*\
+ *
+ * ReadSampleViewReceivedEventArgs.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 07:14 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Provides data for ReadSampleViewReceived event.
+    /// The view is the locked buffer of the sample, valid only during the handler.
+    /// </summary>
+    public ref class ReadSampleViewReceivedEventArgs : public System::EventArgs
+    {
+        /* === Constructor === */
+    public:
+        ReadSampleViewReceivedEventArgs(
+            System::IntPtr scan0,
+            System::Int32 stride,
+            System::UInt32 widthInPixels,
+            System::UInt32 heightInPixels,
+            FramePixelFormat pixelFormat,
+            System::Nullable<System::TimeSpan> latency)
+        {
+            Update(scan0, stride, widthInPixels, heightInPixels, pixelFormat, latency);
+        }
+
+    internal:
+        /// <summary>
+        /// Overwrite with the view of another sample, for reusing the instance.
+        /// </summary>
+        void Update(
+            System::IntPtr scan0,
+            System::Int32 stride,
+            System::UInt32 widthInPixels,
+            System::UInt32 heightInPixels,
+            FramePixelFormat pixelFormat,
+            System::Nullable<System::TimeSpan> latency)
+        {
+            m_scan0 = scan0;
+            m_stride = stride;
+            m_widthInPixels = widthInPixels;
+            m_heightInPixels = heightInPixels;
+            m_pixelFormat = pixelFormat;
+            m_latency = latency;
+        }
+
+        /// <summary>
+        /// Detach from the buffer once it's unlocked, so a kept instance can't read it.
+        /// </summary>
+        void Invalidate()
+        {
+            m_scan0 = System::IntPtr::Zero;
+        }
+
+        /* === Methods === */
+    public:
+        /// <summary>
+        /// Copy the frame into a top-down array of packed rows, whichever the direction of the view is.
+        /// </summary>
+        /// <param name="destination">Array of at least `WidthInPixels * HeightInPixels * BytesPerPixel` bytes.</param>
+        void CopyTo(array<System::Byte> ^destination)
+        {
+            if (m_scan0 == System::IntPtr::Zero)
+            {
+                throw gcnew System::InvalidOperationException("The view is valid only during the handler of the event.");
+            }
+
+            auto cbRow = static_cast<System::Int32>(m_widthInPixels * BytesPerPixel);
+            auto cbFrame = cbRow * static_cast<System::Int32>(m_heightInPixels);
+
+            if (!destination || destination->Length < cbFrame)
+            {
+                throw gcnew System::ArgumentException("Destination is smaller than the frame.", STRINGIZE(destination));
+            }
+
+            // Packed top-down rows are a single block
+            if (m_stride == cbRow)
+            {
+                System::Runtime::InteropServices::Marshal::Copy(m_scan0, destination, 0, cbFrame);
+                return;
+            }
+
+            for (System::UInt32 y = 0; y < m_heightInPixels; y++)
+            {
+                System::Runtime::InteropServices::Marshal::Copy(
+                    System::IntPtr::Add(m_scan0, m_stride * static_cast<System::Int32>(y)),
+                    destination,
+                    cbRow * static_cast<System::Int32>(y),
+                    cbRow
+                );
+            }
+        }
+
+        /// <summary>
+        /// Copy the frame into a new top-down array of packed rows.
+        /// </summary>
+        array<System::Byte> ^ToArray()
+        {
+            auto destination = gcnew array<System::Byte>(static_cast<System::Int32>(m_widthInPixels * m_heightInPixels * BytesPerPixel));
+            CopyTo(destination);
+
+            return destination;
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the top row of the frame, zero after the handler returned.
+        /// </summary>
+        property System::IntPtr Scan0
+        {
+            System::IntPtr get() { return m_scan0; }
+        }
+
+        /// <summary>
+        /// Gets the bytes from the start of a row to the start of the row below it,
+        ///  negative for a bottom-up buffer where the rows go backwards in memory from `Scan0`.
+        /// </summary>
+        property System::Int32 Stride
+        {
+            System::Int32 get() { return m_stride; }
+        }
+
+        /// <summary>
+        /// Gets frame width in pixels.
+        /// </summary>
+        property System::UInt32 WidthInPixels
+        {
+            System::UInt32 get() { return m_widthInPixels; }
+        }
+
+        /// <summary>
+        /// Gets frame height in pixels.
+        /// </summary>
+        property System::UInt32 HeightInPixels
+        {
+            System::UInt32 get() { return m_heightInPixels; }
+        }
+
+        /// <summary>
+        /// Gets pixel format of the frame.
+        /// </summary>
+        property FramePixelFormat PixelFormat
+        {
+            FramePixelFormat get() { return m_pixelFormat; }
+        }
+
+        /// <summary>
+        /// Gets bytes per pixel.
+        /// </summary>
+        property System::UInt32 BytesPerPixel
+        {
+            System::UInt32 get() { return Native::GetBytesPerPixel(static_cast<Native::PIXEL_FORMAT>(m_pixelFormat)); }
+        }
+
+        /// <summary>
+        /// Gets the time from the capture of the frame by the device to its delivery,
+        ///  or null if the device doesn't report the capture time.
+        /// </summary>
+        property System::Nullable<System::TimeSpan> Latency
+        {
+            System::Nullable<System::TimeSpan> get() { return m_latency; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::IntPtr          m_scan0;
+        System::Int32           m_stride;
+        System::UInt32          m_widthInPixels;
+        System::UInt32          m_heightInPixels;
+        FramePixelFormat        m_pixelFormat;
+        System::Nullable<System::TimeSpan>  m_latency;
+    };
+}
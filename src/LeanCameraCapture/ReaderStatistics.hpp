@@ -0,0 +1,190 @@
+/*-----------------------------------------------------------------*\
+ *
+ * ReaderStatistics.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 02:41 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Snapshot of the health counters of a reader, counted since the reader was created.
+    /// </summary>
+    public ref class ReaderStatistics sealed
+    {
+        /* === Constructor === */
+    internal:
+        ReaderStatistics(const Native::READER_COUNTERS &counters) :
+            m_deliveredFramesPerSecond{ counters.deliveredFramesPerSecond },
+            m_deliveredFrames{ counters.deliveredFrames },
+            m_framesDroppedBySource{ counters.streamTicks },
+            m_framesDroppedByBackpressure{ counters.backpressureDrops },
+            m_framesDroppedAsStale{ counters.staleDrops },
+            m_framesSkippedByDecimation{ counters.decimatedFrames },
+            m_framesDroppedByFramePool{ counters.framePoolDrops },
+            m_conversionFailures{ counters.conversionFailures },
+            m_formatChanges{ counters.formatChanges },
+            m_reopenCount{ counters.reopens },
+            m_bytesCopied{ counters.bytesCopied },
+            m_dispatchAllocatedBytes{ counters.dispatchAllocatedBytes },
+            m_queueDepth{ counters.queueDepth },
+            m_timeToFirstFrame{ System::TimeSpan::FromTicks(counters.timeToFirstFrame) },
+            m_bIsNegotiationCached{ counters.isNegotiationCached }
+        {
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the smoothed rate of the delivered frames, falls towards zero while no frames are delivered.
+        /// </summary>
+        property System::Double DeliveredFramesPerSecond
+        {
+            System::Double get() { return m_deliveredFramesPerSecond; }
+        }
+
+        /// <summary>
+        /// Gets the number of frames delivered.
+        /// </summary>
+        property System::UInt64 DeliveredFrames
+        {
+            System::UInt64 get() { return m_deliveredFrames; }
+        }
+
+        /// <summary>
+        /// Gets the number of gaps the source reported in the stream (stream ticks), i.e. frames dropped by the device.
+        /// </summary>
+        property System::UInt64 FramesDroppedBySource
+        {
+            System::UInt64 get() { return m_framesDroppedBySource; }
+        }
+
+        /// <summary>
+        /// Gets the number of frames the device captured while no read was pending,
+        ///  estimated from the gaps between the timestamps of the delivered frames.
+        /// </summary>
+        property System::UInt64 FramesDroppedByBackpressure
+        {
+            System::UInt64 get() { return m_framesDroppedByBackpressure; }
+        }
+
+        /// <summary>
+        /// Gets the number of samples dropped in low latency mode for waiting in the queue of the device
+        ///  longer than `CameraCaptureReader.MaxFrameAge`.
+        /// </summary>
+        property System::UInt64 FramesDroppedAsStale
+        {
+            System::UInt64 get() { return m_framesDroppedAsStale; }
+        }
+
+        /// <summary>
+        /// Gets the number of frames skipped by `CameraCaptureReader.FrameDecimation` and `CameraCaptureReader.TargetFrameRate`.
+        /// </summary>
+        property System::UInt64 FramesSkippedByDecimation
+        {
+            System::UInt64 get() { return m_framesSkippedByDecimation; }
+        }
+
+        /// <summary>
+        /// Gets the number of samples dropped for having no free frame in the pool of `CameraCaptureReader.FramePoolSize`.
+        /// </summary>
+        property System::UInt64 FramesDroppedByFramePool
+        {
+            System::UInt64 get() { return m_framesDroppedByFramePool; }
+        }
+
+        /// <summary>
+        /// Gets the number of samples that failed to be converted into a frame.
+        /// </summary>
+        property System::UInt64 ConversionFailures
+        {
+            System::UInt64 get() { return m_conversionFailures; }
+        }
+
+        /// <summary>
+        /// Gets the number of media type changes of the device handled without reopening the reader.
+        /// </summary>
+        property System::UInt64 FormatChanges
+        {
+            System::UInt64 get() { return m_formatChanges; }
+        }
+
+        /// <summary>
+        /// Gets the number of times the reader has been opened again after the first open.
+        /// </summary>
+        property System::UInt64 ReopenCount
+        {
+            System::UInt64 get() { return m_reopenCount; }
+        }
+
+        /// <summary>
+        /// Gets the number of bytes copied into frames.
+        /// </summary>
+        property System::UInt64 BytesCopied
+        {
+            System::UInt64 get() { return m_bytesCopied; }
+        }
+
+        /// <summary>
+        /// Gets the number of managed bytes the reader allocated delivering the frames, not counting
+        ///  what the event handlers allocate. Stays the same over steady capture with `ReuseEventArgs`,
+        ///  measured with `GC.GetAllocatedBytesForCurrentThread()` on the thread raising the events.
+        /// </summary>
+        property System::UInt64 DispatchAllocatedBytes
+        {
+            System::UInt64 get() { return m_dispatchAllocatedBytes; }
+        }
+
+        /// <summary>
+        /// Gets the number of reads issued and not completed yet.
+        /// </summary>
+        property System::UInt32 QueueDepth
+        {
+            System::UInt32 get() { return m_queueDepth; }
+        }
+
+        /// <summary>
+        /// Gets the time from starting the last open to its first frame, zero until the frame is delivered.
+        /// </summary>
+        property System::TimeSpan TimeToFirstFrame
+        {
+            System::TimeSpan get() { return m_timeToFirstFrame; }
+        }
+
+        /// <summary>
+        /// Gets if the last open skipped the media type negotiation using the negotiation cache.
+        /// </summary>
+        property System::Boolean IsNegotiationCached
+        {
+            System::Boolean get() { return m_bIsNegotiationCached; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::Double          m_deliveredFramesPerSecond;
+        System::UInt64          m_deliveredFrames;
+        System::UInt64          m_framesDroppedBySource;
+        System::UInt64          m_framesDroppedByBackpressure;
+        System::UInt64          m_framesDroppedAsStale;
+        System::UInt64          m_framesSkippedByDecimation;
+        System::UInt64          m_framesDroppedByFramePool;
+        System::UInt64          m_conversionFailures;
+        System::UInt64          m_formatChanges;
+        System::UInt64          m_reopenCount;
+        System::UInt64          m_bytesCopied;
+        System::UInt64          m_dispatchAllocatedBytes;
+        System::UInt32          m_queueDepth;
+        System::TimeSpan        m_timeToFirstFrame;
+        System::Boolean         m_bIsNegotiationCached;
+    };
+}
@@ -0,0 +1,40 @@
+/*-----------------------------------------------------------------*\
+ *
+ * ResampleFilter.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:52 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Filter used for resizing the frames to the output size of a reader.
+    /// </summary>
+    public enum class ResampleFilter
+    {
+        /// <summary>
+        /// Averages the pixels of each area, supports only integer downscaling ratios e.g. 1920x1080 to 640x360.
+        /// </summary>
+        Box = static_cast<int>(Native::RESAMPLE_FILTER::BOX),
+
+        /// <summary>
+        /// Linear interpolation, widened to cover all the pixels when downscaling.
+        /// </summary>
+        Bilinear = static_cast<int>(Native::RESAMPLE_FILTER::BILINEAR),
+
+        /// <summary>
+        /// Lanczos with 3 lobes, sharpest and slowest of the filters.
+        /// </summary>
+        Lanczos3 = static_cast<int>(Native::RESAMPLE_FILTER::LANCZOS3)
+    };
+}
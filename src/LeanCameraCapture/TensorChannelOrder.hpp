@@ -0,0 +1,35 @@
+/*-----------------------------------------------------------------*\
+ *
+ * TensorChannelOrder.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:46 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Order of the channel planes of the tensor written by a reader.
+    /// </summary>
+    public enum class TensorChannelOrder
+    {
+        /// <summary>
+        /// Red, green, then blue planes.
+        /// </summary>
+        Rgb = static_cast<int>(Native::TENSOR_CHANNEL_ORDER::RGB),
+
+        /// <summary>
+        /// Blue, green, then red planes.
+        /// </summary>
+        Bgr = static_cast<int>(Native::TENSOR_CHANNEL_ORDER::BGR)
+    };
+}
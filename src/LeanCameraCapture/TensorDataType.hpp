@@ -0,0 +1,41 @@
+/*-----------------------------------------------------------------*\
+ *
+ * TensorDataType.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:41 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Element type of the tensor written by a reader.
+    /// </summary>
+    public enum class TensorDataType
+    {
+        /// <summary>
+        /// 32-bit floats, normalized with the mean and the standard deviation.
+        /// </summary>
+        Float32 = static_cast<int>(Native::TENSOR_DATA_TYPE::FLOAT32),
+
+        /// <summary>
+        /// 16-bit IEEE 754 half floats, normalized with the mean and the standard deviation.
+        /// Same as `System.Half`.
+        /// </summary>
+        Float16 = static_cast<int>(Native::TENSOR_DATA_TYPE::FLOAT16),
+
+        /// <summary>
+        /// The channel bytes as is, the mean and the standard deviation are ignored.
+        /// </summary>
+        UInt8 = static_cast<int>(Native::TENSOR_DATA_TYPE::UINT8)
+    };
+}
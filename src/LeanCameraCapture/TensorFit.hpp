@@ -0,0 +1,40 @@
+/*-----------------------------------------------------------------*\
+ *
+ * TensorFit.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:44 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// How the frame is fit into the tensor written by a reader when their aspect ratios differ.
+    /// </summary>
+    public enum class TensorFit
+    {
+        /// <summary>
+        /// The frame is resized to the tensor size, changing its aspect ratio.
+        /// </summary>
+        Stretch = static_cast<int>(Native::TENSOR_FIT::STRETCH),
+
+        /// <summary>
+        /// The whole frame is resized into the tensor and centered, the rest of the tensor is zeros.
+        /// </summary>
+        Letterbox = static_cast<int>(Native::TENSOR_FIT::LETTERBOX),
+
+        /// <summary>
+        /// The frame is resized to cover the tensor, and its center is written.
+        /// </summary>
+        Crop = static_cast<int>(Native::TENSOR_FIT::CROP)
+    };
+}
@@ -0,0 +1,180 @@
+/*-----------------------------------------------------------------*\
+ *
+ * TensorFormat.hpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 06:52 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+using namespace System::Collections::Generic;
+
+namespace LeanCameraCapture
+{
+    /// <summary>
+    /// Format of the planar CHW tensor of 3 channels a reader writes from each frame,
+    ///  see `CameraCaptureReader.TensorFormat`.
+    /// Each channel is normalized as `(value / 255 - mean) / std`, with a mean of zero
+    ///  and a standard deviation of one unless `SetNormalization` is called.
+    /// </summary>
+    public ref class TensorFormat sealed
+    {
+        /* === Constructor === */
+    public:
+        TensorFormat(System::UInt32 width, System::UInt32 height) :
+            m_width{ width },
+            m_height{ height },
+            m_fit{ TensorFit::Stretch },
+            m_channelOrder{ TensorChannelOrder::Rgb },
+            m_dataType{ TensorDataType::Float32 }
+        {
+            if (width == 0)
+            {
+                throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(width), "Tensor width can't be zero.");
+            }
+
+            if (height == 0)
+            {
+                throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(height), "Tensor height can't be zero.");
+            }
+
+            // Set in the body for the same reason as `ReadSampleSucceededEventArgs`, error `C2440`.
+            m_mean = gcnew array<System::Single>{ 0.0f, 0.0f, 0.0f };
+            m_std = gcnew array<System::Single>{ 1.0f, 1.0f, 1.0f };
+        }
+
+        /* === Methods === */
+    public:
+        /// <summary>
+        /// Set the mean and the standard deviation of each channel, in the channel order and in [0, 1] units,
+        ///  e.g. `{ 0.485, 0.456, 0.406 }` and `{ 0.229, 0.224, 0.225 }` for RGB ImageNet models.
+        /// </summary>
+        void SetNormalization(array<System::Single> ^mean, array<System::Single> ^std)
+        {
+            if (!mean || mean->Length != 3)
+            {
+                throw gcnew System::ArgumentException("A mean is needed for each of the 3 channels.", STRINGIZE(mean));
+            }
+
+            if (!std || std->Length != 3)
+            {
+                throw gcnew System::ArgumentException("A standard deviation is needed for each of the 3 channels.", STRINGIZE(std));
+            }
+
+            for (int c = 0; c < 3; c++)
+            {
+                if (!System::Single::IsFinite(mean[c]))
+                {
+                    throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(mean), "Means have to be finite.");
+                }
+
+                if (!(std[c] > 0.0f) || !System::Single::IsFinite(std[c]))
+                {
+                    throw gcnew System::ArgumentOutOfRangeException(STRINGIZE(std), "Standard deviations have to be finite and positive.");
+                }
+            }
+
+            m_mean = safe_cast<array<System::Single> ^>(mean->Clone());
+            m_std = safe_cast<array<System::Single> ^>(std->Clone());
+        }
+
+        /// <summary>
+        /// Get the mean of each channel in the channel order.
+        /// </summary>
+        IReadOnlyCollection<System::Single> ^GetMean()
+        {
+            return System::Array::AsReadOnly(m_mean);
+        }
+
+        /// <summary>
+        /// Get the standard deviation of each channel in the channel order.
+        /// </summary>
+        IReadOnlyCollection<System::Single> ^GetStd()
+        {
+            return System::Array::AsReadOnly(m_std);
+        }
+
+    internal:
+        Native::TENSOR_FORMAT ToNative()
+        {
+            Native::TENSOR_FORMAT format{};
+
+            format.width = m_width;
+            format.height = m_height;
+            format.fit = static_cast<Native::TENSOR_FIT>(m_fit);
+            format.channelOrder = static_cast<Native::TENSOR_CHANNEL_ORDER>(m_channelOrder);
+            format.dataType = static_cast<Native::TENSOR_DATA_TYPE>(m_dataType);
+
+            for (int c = 0; c < 3; c++)
+            {
+                format.mean[c] = m_mean[c];
+                format.std[c] = m_std[c];
+            }
+
+            return format;
+        }
+
+        /* === Properties === */
+    public:
+        /// <summary>
+        /// Gets the tensor width.
+        /// </summary>
+        property System::UInt32 Width
+        {
+            System::UInt32 get() { return m_width; }
+        }
+
+        /// <summary>
+        /// Gets the tensor height.
+        /// </summary>
+        property System::UInt32 Height
+        {
+            System::UInt32 get() { return m_height; }
+        }
+
+        /// <summary>
+        /// Gets or sets how the frame is fit into the tensor, `Stretch` by default.
+        /// </summary>
+        property TensorFit Fit
+        {
+            TensorFit get() { return m_fit; }
+            void set(TensorFit value) { m_fit = value; }
+        }
+
+        /// <summary>
+        /// Gets or sets the order of the channel planes, `Rgb` by default.
+        /// </summary>
+        property TensorChannelOrder ChannelOrder
+        {
+            TensorChannelOrder get() { return m_channelOrder; }
+            void set(TensorChannelOrder value) { m_channelOrder = value; }
+        }
+
+        /// <summary>
+        /// Gets or sets the element type, `Float32` by default.
+        /// </summary>
+        property TensorDataType DataType
+        {
+            TensorDataType get() { return m_dataType; }
+            void set(TensorDataType value) { m_dataType = value; }
+        }
+
+        /* === Backing Fields === */
+    private:
+        System::UInt32          m_width;
+        System::UInt32          m_height;
+        TensorFit               m_fit;
+        TensorChannelOrder      m_channelOrder;
+        TensorDataType          m_dataType;
+        array<System::Single>   ^m_mean;
+        array<System::Single>   ^m_std;
+    };
+}
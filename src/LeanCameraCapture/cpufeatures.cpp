@@ -0,0 +1,100 @@
+/*-----------------------------------------------------------------*\
+ *
+ * cpufeatures.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:07 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "cpufeatures.h"
+
+#pragma managed(push, off)
+
+// ===============================
+// ====== Feature Detection ======
+// ===============================
+
+// --------------------------------------------------------------------
+// DetectAvx2Support
+//
+// AVX2 needs the CPUID bit, and the OS has to save the YMM registers
+//  on context switch, which is checked through OSXSAVE and XGETBV.
+// --------------------------------------------------------------------
+
+static bool DetectAvx2Support()
+{
+    int cpuInfo[4]{};
+
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7) { return false; }
+
+    __cpuid(cpuInfo, 1);
+    const bool bOsXSave{ (cpuInfo[2] & (1 << 27)) != 0 };
+    const bool bAvx{ (cpuInfo[2] & (1 << 28)) != 0 };
+    if (!bOsXSave || !bAvx) { return false; }
+
+    // XMM (bit 1) and YMM (bit 2) states are enabled by the OS
+    if ((_xgetbv(0) & 0x6) != 0x6) { return false; }
+
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 5)) != 0;
+}
+
+// --------------------------------------------------------------------
+// DetectF16cSupport
+//
+// F16C works on the YMM registers, so it needs the same OS support
+//  as AVX.
+// --------------------------------------------------------------------
+
+static bool DetectF16cSupport()
+{
+    int cpuInfo[4]{};
+
+    __cpuid(cpuInfo, 1);
+    const bool bOsXSave{ (cpuInfo[2] & (1 << 27)) != 0 };
+    const bool bAvx{ (cpuInfo[2] & (1 << 28)) != 0 };
+    const bool bF16c{ (cpuInfo[2] & (1 << 29)) != 0 };
+    if (!bOsXSave || !bAvx || !bF16c) { return false; }
+
+    return (_xgetbv(0) & 0x6) == 0x6;
+}
+
+// =====================
+// ====== Globals ======
+// =====================
+
+// Detected once on load, CPUID is cheap and has no side effects.
+static const bool g_bIsAvx2Supported{ DetectAvx2Support() };
+static const bool g_bIsF16cSupported{ DetectF16cSupport() };
+
+// =======================
+// ====== Functions ======
+// =======================
+
+// --------------------------------------------------------------------
+// GetIsAvx2Supported
+// --------------------------------------------------------------------
+
+bool GetIsAvx2Supported()
+{
+    return g_bIsAvx2Supported;
+}
+
+// --------------------------------------------------------------------
+// GetIsF16cSupported
+// --------------------------------------------------------------------
+
+bool GetIsF16cSupported()
+{
+    return g_bIsF16cSupported;
+}
+
+#pragma managed(pop)
@@ -0,0 +1,30 @@
+/*-----------------------------------------------------------------*\
+ *
+ * cpufeatures.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:05 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+/// <summary>
+/// [Internal][Native] Gets if AVX2 is supported by both the processor and the OS
+/// </summary>
+bool GetIsAvx2Supported();
+
+/// <summary>
+/// [Internal][Native] Gets if F16C half precision conversions are supported by both the processor and the OS
+/// </summary>
+bool GetIsF16cSupported();
+
+#pragma managed(pop)
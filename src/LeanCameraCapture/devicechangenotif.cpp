@@ -15,20 +15,48 @@
 
 #include "devicechangenotif.h"
 
+#define NOTIFICATION_WINDOW_CLASS_NAME L"LeanCameraCaptureDeviceChangeNotification"
+
 #pragma managed(push, off)
 
 // =====================
 // ====== Globals ======
 // =====================
 
-// The registered notification pointer
+// The listening thread and its message-only window
+static HANDLE g_hNotificationThread{ nullptr };
+static HWND g_hwndNotification{ nullptr };
+
+// The registered notification pointer, owned by the listening thread
 static HDEVNOTIFY g_HDevNofity{ nullptr };
 
-// Map for the devices' symbolic link and handlers
-static std::multimap<const std::wstring &, CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER*> g_mmapHandlers{};
+// Handlers indexed by the normalized symbolic link of the device.
+//  Handlers are called under the shared lock, so removing a handler waits for its running calls.
+static SRWLOCK g_srwlockHandlers{ SRWLOCK_INIT };
+static std::unordered_map<std::wstring, std::vector<CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER *>> g_umapHandlers{};
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// NormalizeSymbolicLink
+//
+// Symbolic links are compared case insensitive, so they are indexed
+//  in lower case.
+// --------------------------------------------------------------------
+
+static std::wstring NormalizeSymbolicLink(const WCHAR *pwszSymbolicLink) noexcept(false)
+{
+    std::wstring normalized{ pwszSymbolicLink };
+
+    if (!normalized.empty())
+    {
+        CharLowerBuffW(&normalized[0], static_cast<DWORD>(normalized.size()));
+    }
 
-// The original WindowProc before subclassing
-static WNDPROC g_wndprocOriginal{ nullptr };
+    return normalized;
+}
 
 // ============================================
 // ====== Device Change Handler Function ======
@@ -38,28 +66,47 @@ static WNDPROC g_wndprocOriginal{ nullptr };
 // OnCaptureDeviceChangeNotification
 // --------------------------------------------------------------------
 
-static void OnCaptureDeviceChangeNotification(PDEV_BROADCAST_HDR pHdr)
+static void OnCaptureDeviceChangeNotification(WPARAM wParam, PDEV_BROADCAST_HDR pHdr)
 {
     DEV_BROADCAST_DEVICEINTERFACE *pDi{ nullptr };
 
+    if (wParam != DBT_DEVICEARRIVAL && wParam != DBT_DEVICEREMOVECOMPLETE) { return; }
+
     if (!pHdr) { return; }
     if (pHdr->dbch_devicetype != DBT_DEVTYP_DEVICEINTERFACE) { return; }
 
     pDi = reinterpret_cast<DEV_BROADCAST_DEVICEINTERFACE *>(pHdr);
 
-    for (const auto& item : g_mmapHandlers)
+    std::wstring symbolicLink{};
+    try
+    {
+        symbolicLink = NormalizeSymbolicLink(pDi->dbcc_name);
+    }
+    catch (const std::bad_alloc &/*ex*/)
     {
-        if (!item.second) { continue; }
-        if (_wcsicmp(item.first.c_str(), pDi->dbcc_name) != 0) { continue; }
+        return;
+    }
+
+    AcquireSRWLockShared(&g_srwlockHandlers);
 
-        // Call the handler
-        (*(item.second))();
+    auto entryFindIterator = g_umapHandlers.find(symbolicLink);
+    if (entryFindIterator != g_umapHandlers.end())
+    {
+        for (auto pCallback : entryFindIterator->second)
+        {
+            if (!pCallback) { continue; }
+
+            // Call the handler
+            (*pCallback)(wParam == DBT_DEVICEARRIVAL);
+        }
     }
+
+    ReleaseSRWLockShared(&g_srwlockHandlers);
 }
 
-// ========================================
-// ====== WindowProc For Subclassing ======
-// ========================================
+// ============================================
+// ====== Notification Window and Thread ======
+// ============================================
 
 // --------------------------------------------------------------------
 // DeviceChangeNotificationWindowProc
@@ -70,91 +117,146 @@ static LRESULT CALLBACK DeviceChangeNotificationWindowProc(HWND hwnd, UINT uMsg,
     switch (uMsg)
     {
     case WM_DEVICECHANGE:
-        OnCaptureDeviceChangeNotification(reinterpret_cast<PDEV_BROADCAST_HDR>(lParam));
-        break;
+        OnCaptureDeviceChangeNotification(wParam, reinterpret_cast<PDEV_BROADCAST_HDR>(lParam));
+        return TRUE;
+    case WM_CLOSE:
+        DestroyWindow(hwnd);
+        return 0;
+    case WM_DESTROY:
+        PostQuitMessage(0);
+        return 0;
     }
 
-    return CallWindowProc(g_wndprocOriginal, hwnd, uMsg, wParam, lParam);
+    return DefWindowProcW(hwnd, uMsg, wParam, lParam);
 }
 
-// =======================
-// ====== Functions ======
-// =======================
-
 // --------------------------------------------------------------------
-// RegisterCaptureDeviceChangeNotificationForHwnd
+// NotificationThreadProc
+//
+// Creates the message-only window, registers it for the capture
+//  devices' notifications, then sets the ready event and pumps the
+//  window's messages until the window is closed.
 // --------------------------------------------------------------------
 
-void RegisterCaptureDeviceChangeNotificationForHwnd(HWND hwnd) noexcept(false)
+static DWORD WINAPI NotificationThreadProc(LPVOID pParameter)
 {
-    if (g_HDevNofity)
-    {
-        throw std::logic_error{ "Capture device change notification is already registered." };
-    }
+    HANDLE hReadyEvent{ static_cast<HANDLE>(pParameter) };
 
-    // Register the window for receiving the device change notification messages
     DEV_BROADCAST_DEVICEINTERFACE di{ 0 };
+    MSG msg{};
+
+    g_hwndNotification = CreateWindowExW(
+        0,
+        NOTIFICATION_WINDOW_CLASS_NAME,
+        L"",
+        0,
+        0, 0, 0, 0,
+        HWND_MESSAGE,
+        nullptr,
+        GetModuleHandleW(nullptr),
+        nullptr
+        );
+    if (!g_hwndNotification) { goto done; }
+
+    // Register the window for receiving the device change notification messages
     di.dbcc_size = sizeof(di);
     di.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
     di.dbcc_classguid = KSCATEGORY_CAPTURE;
 
-    g_HDevNofity = RegisterDeviceNotification(hwnd, &di, DEVICE_NOTIFY_WINDOW_HANDLE);
+    g_HDevNofity = RegisterDeviceNotificationW(g_hwndNotification, &di, DEVICE_NOTIFY_WINDOW_HANDLE);
     if (!g_HDevNofity)
     {
-        throw std::system_error{ E_FAIL, std::system_category(), "Couldn't register capture device change notification." };
+        DestroyWindow(g_hwndNotification);
+        g_hwndNotification = nullptr;
     }
 
-    // Subclass the window passed to the argument for being used as the receiver for the notification
-    SetLastError(0);
-    g_wndprocOriginal = reinterpret_cast<WNDPROC>(
-        SetWindowLongPtr(
-            hwnd,
-            GWLP_WNDPROC,
-#ifdef _WIN64
-            reinterpret_cast<LONG_PTR>(&DeviceChangeNotificationWindowProc)
-#else
-            reinterpret_cast<LONG>(&DeviceChangeNotificationWindowProc)
-#endif
-        ));
-    if (!g_wndprocOriginal && GetLastError() != ERROR_SUCCESS)
+done:
+    // The window handle tells the starting thread whether we are ready
+    SetEvent(hReadyEvent);
+
+    if (!g_hwndNotification) { return 1; }
+
+    while (GetMessageW(&msg, nullptr, 0, 0) > 0)
     {
-        UnregisterDeviceNotification(g_HDevNofity);
-        throw std::system_error{ E_FAIL, std::system_category(), "Couldn't subclass the passed window." };
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
     }
+
+    UnregisterDeviceNotification(g_HDevNofity);
+    g_HDevNofity = nullptr;
+
+    return 0;
 }
 
+// =======================
+// ====== Functions ======
+// =======================
+
 // --------------------------------------------------------------------
-// UnregisterRegisteredCaptureDeviceChangeNotification
+// StartCaptureDeviceChangeNotification
 // --------------------------------------------------------------------
 
-void UnregisterRegisteredCaptureDeviceChangeNotification(HWND hwnd) noexcept(false)
+void StartCaptureDeviceChangeNotification() noexcept(false)
 {
-    if (!g_HDevNofity) { return; }
-
-    // Restore the original WindowProc
-    SetLastError(0);
-    auto returnResult = SetWindowLongPtr(
-        hwnd,
-        GWLP_WNDPROC,
-#ifdef _WIN64
-            reinterpret_cast<LONG_PTR>(g_wndprocOriginal)
-#else
-            reinterpret_cast<LONG>(g_wndprocOriginal)
-#endif
-    );
-
-    // Here we are ignoring `ERROR_INVALID_WINDOW_HANDLE` as the consumer may unregister the handler
-    //  after the owner window has been destroyed and the handle became invalid.
-    DWORD dwErrorCode{ GetLastError() };
-    if (returnResult == 0 && dwErrorCode != ERROR_SUCCESS && dwErrorCode != ERROR_INVALID_WINDOW_HANDLE)
+    if (g_hNotificationThread)
     {
-        throw std::system_error{ E_FAIL, std::system_category(), "Couldn't restore the original WndProc." };
+        throw std::logic_error{ "Capture device change notification is already started." };
     }
 
-    UnregisterDeviceNotification(g_HDevNofity);
+    WNDCLASSEXW wc{ 0 };
+    wc.cbSize = sizeof(wc);
+    wc.lpfnWndProc = DeviceChangeNotificationWindowProc;
+    wc.hInstance = GetModuleHandleW(nullptr);
+    wc.lpszClassName = NOTIFICATION_WINDOW_CLASS_NAME;
 
-    // Set the registered notification pointer to nullptr
-    g_HDevNofity = nullptr;
+    if (!RegisterClassExW(&wc) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS)
+    {
+        throw std::system_error{ HRESULT_FROM_WIN32(GetLastError()), std::system_category(), "Couldn't register the notification window class." };
+    }
+
+    HANDLE hReadyEvent{ CreateEventW(nullptr, TRUE, FALSE, nullptr) };
+    if (!hReadyEvent)
+    {
+        throw std::system_error{ HRESULT_FROM_WIN32(GetLastError()), std::system_category(), "Couldn't create the notification thread ready event." };
+    }
+
+    g_hNotificationThread = CreateThread(nullptr, 0, NotificationThreadProc, hReadyEvent, 0, nullptr);
+    if (!g_hNotificationThread)
+    {
+        HRESULT hr{ HRESULT_FROM_WIN32(GetLastError()) };
+        CloseHandle(hReadyEvent);
+        throw std::system_error{ hr, std::system_category(), "Couldn't create the notification thread." };
+    }
+
+    WaitForSingleObject(hReadyEvent, INFINITE);
+    CloseHandle(hReadyEvent);
+
+    if (!g_hwndNotification)
+    {
+        WaitForSingleObject(g_hNotificationThread, INFINITE);
+        CloseHandle(g_hNotificationThread);
+        g_hNotificationThread = nullptr;
+
+        throw std::system_error{ E_FAIL, std::system_category(), "Couldn't register capture device change notification." };
+    }
+}
+
+// --------------------------------------------------------------------
+// StopCaptureDeviceChangeNotification
+// --------------------------------------------------------------------
+
+void StopCaptureDeviceChangeNotification()
+{
+    if (!g_hNotificationThread) { return; }
+
+    // Closing the window ends the thread's message loop
+    PostMessageW(g_hwndNotification, WM_CLOSE, 0, 0);
+
+    WaitForSingleObject(g_hNotificationThread, INFINITE);
+    CloseHandle(g_hNotificationThread);
+
+    g_hNotificationThread = nullptr;
+    g_hwndNotification = nullptr;
 }
 
 // --------------------------------------------------------------------
@@ -164,28 +266,30 @@ void UnregisterRegisteredCaptureDeviceChangeNotification(HWND hwnd) noexcept(fal
 void AddCaptureDeviceChangeNotificationHandler(
     const std::wstring &deviceSymbolicLink,
     CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER *ppCallback
-    )
+    ) noexcept(false)
 {
-    // Check if no entry is already present
-    auto entryFindIterator = std::find_if(
-        g_mmapHandlers.begin(),
-        g_mmapHandlers.end(),
-        [&deviceSymbolicLink, &ppCallback](std::pair<const std::wstring &, CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER*> item)
-        {
-            if (item.first != deviceSymbolicLink) { return false; }
+    // Normalize before taking the lock, as it may throw
+    std::wstring symbolicLink{ NormalizeSymbolicLink(deviceSymbolicLink.c_str()) };
 
-            // We are comparing pointers for the callback
-            if (item.second != ppCallback) { return false; }
+    AcquireSRWLockExclusive(&g_srwlockHandlers);
 
-            return true;
-        }
-    );
+    try
+    {
+        auto &handlers = g_umapHandlers[symbolicLink];
 
-    // Entry already present
-    if (entryFindIterator != g_mmapHandlers.end()) { return; }
+        // Insert the entry if not already present, we are comparing pointers for the callback
+        if (std::find(handlers.begin(), handlers.end(), ppCallback) == handlers.end())
+        {
+            handlers.push_back(ppCallback);
+        }
+    }
+    catch (...)
+    {
+        ReleaseSRWLockExclusive(&g_srwlockHandlers);
+        throw;
+    }
 
-    // Insert the entry
-    g_mmapHandlers.insert({ deviceSymbolicLink, ppCallback });
+    ReleaseSRWLockExclusive(&g_srwlockHandlers);
 }
 
 // --------------------------------------------------------------------
@@ -197,24 +301,26 @@ void RemoveCaptureDeviceChangeNotificationHandler(
     CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER *ppCallback
     )
 {
-    auto entryFindIterator = std::find_if(
-        g_mmapHandlers.begin(),
-        g_mmapHandlers.end(),
-        [&deviceSymbolicLink, &ppCallback](std::pair<const std::wstring &, CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER *> item)
-        {
-            if (item.first != deviceSymbolicLink) { return false; }
+    if (deviceSymbolicLink.empty()) { return; }
 
-            // We are comparing pointers for the callback
-            if (item.second != ppCallback) { return false; }
+    std::wstring symbolicLink{ NormalizeSymbolicLink(deviceSymbolicLink.c_str()) };
 
-            return true;
-        }
-    );
+    AcquireSRWLockExclusive(&g_srwlockHandlers);
+
+    auto entryFindIterator = g_umapHandlers.find(symbolicLink);
+    if (entryFindIterator != g_umapHandlers.end())
+    {
+        auto &handlers = entryFindIterator->second;
+
+        handlers.erase(std::remove(handlers.begin(), handlers.end(), ppCallback), handlers.end());
 
-    // Entry not present
-    if (entryFindIterator == g_mmapHandlers.end()) { return; }
+        if (handlers.empty())
+        {
+            g_umapHandlers.erase(entryFindIterator);
+        }
+    }
 
-    g_mmapHandlers.erase(entryFindIterator);
+    ReleaseSRWLockExclusive(&g_srwlockHandlers);
 }
 
 #pragma managed(pop)
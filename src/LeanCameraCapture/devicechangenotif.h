@@ -18,30 +18,34 @@
 #pragma managed(push, off)
 
 /// <summary>
-/// Function pointer definition for the device change notification handlers
+/// Function pointer definition for the device change notification handlers,
+///  `bIsArrival` is true if the device has arrived and false if it has been removed.
 /// </summary>
-typedef std::function<void()> CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER;
+typedef std::function<void(bool bIsArrival)> CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER;
 
 /// <summary>
-/// [Internal][Native] Register capture device change notification listener on a window handler
+/// [Internal][Native] Start the thread listening for capture device change notifications
+///  on its own message-only window, handlers are called on that thread.
 /// </summary>
-void RegisterCaptureDeviceChangeNotificationForHwnd(HWND hwnd) noexcept(false);
+void StartCaptureDeviceChangeNotification() noexcept(false);
 
 /// <summary>
-/// [Internal][Native] Remove the registered listener
+/// [Internal][Native] Stop the listening thread, has to be called from another thread than the handlers'.
 /// </summary>
-void UnregisterRegisteredCaptureDeviceChangeNotification(HWND hwnd) noexcept(false);
+void StopCaptureDeviceChangeNotification();
 
 /// <summary>
-/// [Internal][Native] Add a handler for a specific device capture change notification
+/// [Internal][Native] Add a handler for a specific device capture change notification.
+/// Must not be called while holding a lock that a handler takes.
 /// </summary>
 void AddCaptureDeviceChangeNotificationHandler(
     const std::wstring &deviceSymbolicLink,
     CAPTURE_DEVICE_CAHNGE_NOTIF_HANDLER *ppCallback
-    );
+    ) noexcept(false);
 
 /// <summary>
-/// [Internal][Native] Remove handler
+/// [Internal][Native] Remove handler, once it returns the handler won't be called anymore.
+/// Must not be called while holding a lock that a handler takes.
 /// </summary>
 void RemoveCaptureDeviceChangeNotificationHandler(
     const std::wstring &deviceSymbolicLink,
@@ -18,4 +18,7 @@
 // Application HResult that indicates Device Lost Error
 #define LEANCAMERACAPTURE_E_DEVICELOST 0xA0000009 // 0b1'0'1'0'0'00000000000'0000000000001001
 
+// Application HResult that indicates all the frames of the frame pool are held
+#define LEANCAMERACAPTURE_E_FRAMEPOOLEXHAUSTED 0xA000000A // 0b1'0'1'0'0'00000000000'0000000000001010
+
 #pragma managed(pop)
@@ -0,0 +1,155 @@
+/*-----------------------------------------------------------------*\
+ *
+ * framememory.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 07:32 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "framememory.h"
+
+#pragma managed(push, off)
+
+using namespace LeanCameraCapture::Native;
+
+// =====================
+// ====== Globals ======
+// =====================
+
+static INIT_ONCE g_largePageInitOnce = INIT_ONCE_STATIC_INIT;
+static SIZE_T g_cbLargePage{ 0 };      // Zero if large pages can't be used.
+
+static volatile LONG64 g_llFrameMemoryBytes{ 0 };
+static volatile LONG64 g_llLargePageBytes{ 0 };
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// InitializeLargePages
+//
+// Large pages need `SeLockMemoryPrivilege`, which is granted to the
+//  account by policy and has to be enabled in the process token.
+//  `AdjustTokenPrivileges` succeeds even if the privilege isn't
+//  granted, so the last error tells if it was enabled.
+// --------------------------------------------------------------------
+
+static BOOL CALLBACK InitializeLargePages(PINIT_ONCE /*pInitOnce*/, PVOID /*pParameter*/, PVOID * /*ppContext*/)
+{
+    const SIZE_T cbLargePage{ GetLargePageMinimum() };
+    if (cbLargePage == 0) { return TRUE; }
+
+    HANDLE hToken{ nullptr };
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &hToken)) { return TRUE; }
+
+    TOKEN_PRIVILEGES privileges{};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+    if (LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid)
+        && AdjustTokenPrivileges(hToken, FALSE, &privileges, 0, nullptr, nullptr)
+        && GetLastError() == ERROR_SUCCESS)
+    {
+        g_cbLargePage = cbLargePage;
+    }
+
+    CloseHandle(hToken);
+
+    _RPT1(_CRT_WARN, "Large pages for frame memory are %s.\n", (g_cbLargePage != 0) ? "enabled" : "not available");
+
+    return TRUE;
+}
+
+// --------------------------------------------------------------------
+// RoundUp
+// --------------------------------------------------------------------
+
+static size_t RoundUp(size_t cb, size_t cbMultiple)
+{
+    return (cb + cbMultiple - 1) / cbMultiple * cbMultiple;
+}
+
+// ==================================
+// ====== FRAME_MEMORY_DELETER ======
+// ==================================
+
+void FRAME_MEMORY_DELETER::operator()(BYTE *pb) const
+{
+    if (!pb) { return; }
+
+    VirtualFree(pb, 0, MEM_RELEASE);
+
+    InterlockedAdd64(&g_llFrameMemoryBytes, -static_cast<LONG64>(cb));
+    if (bIsLargePage) { InterlockedAdd64(&g_llLargePageBytes, -static_cast<LONG64>(cb)); }
+}
+
+// =======================
+// ====== Functions ======
+// =======================
+
+// --------------------------------------------------------------------
+// AllocateFrameMemory
+//
+// Large pages have to be committed on reserving and can fail once the
+//  physical memory is fragmented, so normal pages are the fallback for
+//  each allocation. A frame smaller than a large page isn't worth the
+//  rounding, its TLB entries are few anyway.
+// --------------------------------------------------------------------
+
+FRAME_MEMORY AllocateFrameMemory(size_t cb)
+{
+    assert(cb > 0);
+
+    InitOnceExecuteOnce(&g_largePageInitOnce, InitializeLargePages, nullptr, nullptr);
+
+    BYTE *pb{ nullptr };
+    FRAME_MEMORY_DELETER deleter{ 0, false };
+
+    if (g_cbLargePage != 0 && cb >= g_cbLargePage)
+    {
+        deleter.cb = RoundUp(cb, g_cbLargePage);
+        deleter.bIsLargePage = true;
+
+        pb = static_cast<BYTE *>(VirtualAlloc(nullptr, deleter.cb, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGE, PAGE_READWRITE));
+    }
+
+    if (!pb)
+    {
+        SYSTEM_INFO systemInfo{};
+        GetSystemInfo(&systemInfo);
+
+        deleter.cb = RoundUp(cb, systemInfo.dwPageSize);
+        deleter.bIsLargePage = false;
+
+        pb = static_cast<BYTE *>(VirtualAlloc(nullptr, deleter.cb, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    }
+
+    if (!pb) { throw std::bad_alloc{}; }
+
+    InterlockedAdd64(&g_llFrameMemoryBytes, static_cast<LONG64>(deleter.cb));
+    if (deleter.bIsLargePage) { InterlockedAdd64(&g_llLargePageBytes, static_cast<LONG64>(deleter.cb)); }
+
+    return FRAME_MEMORY{ pb, deleter };
+}
+
+// --------------------------------------------------------------------
+// GetFrameMemoryStats
+// --------------------------------------------------------------------
+
+void GetFrameMemoryStats(FRAME_MEMORY_STATS *pStats)
+{
+    assert(pStats != nullptr);
+
+    pStats->cbTotal = static_cast<UINT64>(InterlockedCompareExchange64(&g_llFrameMemoryBytes, 0, 0));
+    pStats->cbLargePage = static_cast<UINT64>(InterlockedCompareExchange64(&g_llLargePageBytes, 0, 0));
+}
+
+#pragma managed(pop)
@@ -0,0 +1,60 @@
+/*-----------------------------------------------------------------*\
+ *
+ * framememory.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 07:32 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        /// <summary>
+        /// Frees the frame memory it was allocated with, see `AllocateFrameMemory`.
+        /// </summary>
+        struct FRAME_MEMORY_DELETER
+        {
+            size_t  cb;                 // Committed bytes, rounded up to the page size.
+            bool    bIsLargePage;
+
+            void operator()(BYTE *pb) const;
+        };
+
+        typedef std::unique_ptr<BYTE[], FRAME_MEMORY_DELETER> FRAME_MEMORY;
+
+        /// <summary>
+        /// Frame memory currently allocated by the process.
+        /// </summary>
+        struct FRAME_MEMORY_STATS
+        {
+            UINT64  cbTotal;
+            UINT64  cbLargePage;        // Part of the total backed by large pages.
+        };
+    }
+}
+
+/// <summary>
+/// [Internal][Native] Allocate memory for frames, backed by large pages if the process is allowed to lock pages
+///  in memory and the size is at least a large page, and by normal pages otherwise. The memory starts at a page,
+///  so it is aligned to cache lines. Throws `std::bad_alloc` on failure.
+/// </summary>
+LeanCameraCapture::Native::FRAME_MEMORY AllocateFrameMemory(size_t cb) noexcept(false);
+
+/// <summary>
+/// [Internal][Native] Get the frame memory currently allocated by the process.
+/// </summary>
+void GetFrameMemoryStats(LeanCameraCapture::Native::FRAME_MEMORY_STATS *pStats);
+
+#pragma managed(pop)
@@ -0,0 +1,309 @@
+/*-----------------------------------------------------------------*\
+ *
+ * imagetransform.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:59 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "imagetransform.h"
+
+// Source rows per block when transposing, 16 pixels of 4 bytes fill a 64-byte cache line of a destination row.
+#define TRANSPOSE_BLOCK_ROWS 16
+
+// Bytes ahead of the copy the source is prefetched when streaming, a few cache lines to cover the memory latency.
+#define COPY_PREFETCH_DISTANCE 512
+
+#pragma managed(push, off)
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// ExtractLumaRowFromYuy2Avx2
+//
+// Packing works within the 128-bit lanes, so the 64-bit quarters are
+//  put back in order after packing. Returns the pixels done, the rest
+//  is left for the SSE2 loop.
+// --------------------------------------------------------------------
+
+static UINT32 ExtractLumaRowFromYuy2Avx2(const BYTE *pbSource, BYTE *pbDestination, UINT32 widthInPixels)
+{
+    const __m256i lumaMask{ _mm256_set1_epi16(0x00FF) };
+
+    UINT32 x{ 0 };
+    for (; x + 32 <= widthInPixels; x += 32)
+    {
+        __m256i pixels0{ _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pbSource + static_cast<size_t>(x) * 2)) };
+        __m256i pixels1{ _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pbSource + static_cast<size_t>(x) * 2 + 32)) };
+
+        __m256i luma{ _mm256_packus_epi16(_mm256_and_si256(pixels0, lumaMask), _mm256_and_si256(pixels1, lumaMask)) };
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pbDestination + x), _mm256_permute4x64_epi64(luma, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    return x;
+}
+
+// --------------------------------------------------------------------
+// CopyRowNonTemporal
+//
+// Streaming stores need an aligned destination, so the bytes before
+//  the first 16-byte boundary and after the last one are copied as is.
+//  A cache line is moved per iteration, the source prefetched with the
+//  non-temporal hint isn't kept in the outer caches either.
+// --------------------------------------------------------------------
+
+static void CopyRowNonTemporal(BYTE *pbDestination, const BYTE *pbSource, size_t cb)
+{
+    size_t cbHead{ (16 - (reinterpret_cast<UINT_PTR>(pbDestination) & 15)) & 15 };
+    cbHead = (std::min)(cbHead, cb);
+
+    std::memcpy(pbDestination, pbSource, cbHead);
+    pbDestination += cbHead;
+    pbSource += cbHead;
+    cb -= cbHead;
+
+    size_t i{ 0 };
+    for (; i + 64 <= cb; i += 64)
+    {
+        // Prefetching past the end of the source is harmless, prefetches don't fault
+        _mm_prefetch(reinterpret_cast<const char *>(pbSource + i + COPY_PREFETCH_DISTANCE), _MM_HINT_NTA);
+
+        __m128i bytes0{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSource + i)) };
+        __m128i bytes1{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSource + i + 16)) };
+        __m128i bytes2{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSource + i + 32)) };
+        __m128i bytes3{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSource + i + 48)) };
+
+        _mm_stream_si128(reinterpret_cast<__m128i *>(pbDestination + i), bytes0);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(pbDestination + i + 16), bytes1);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(pbDestination + i + 32), bytes2);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(pbDestination + i + 48), bytes3);
+    }
+
+    for (; i + 16 <= cb; i += 16)
+    {
+        _mm_stream_si128(
+            reinterpret_cast<__m128i *>(pbDestination + i),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSource + i))
+            );
+    }
+
+    std::memcpy(pbDestination + i, pbSource + i, cb - i);
+}
+
+// =======================
+// ====== Functions ======
+// =======================
+
+// --------------------------------------------------------------------
+// CopyImage
+// --------------------------------------------------------------------
+
+void CopyImage(
+    BYTE        *pbDestination,
+    LONG        lDestinationStride,
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    DWORD       cbRow,
+    UINT32      rows,
+    bool        bStreamDestination
+    )
+{
+    assert(pbSource != nullptr);
+    assert(pbDestination != nullptr);
+
+    if (!bStreamDestination)
+    {
+        // Contiguous rows in the same direction are a single block
+        if (lSourceStride == lDestinationStride && lSourceStride == static_cast<LONG>(cbRow))
+        {
+            std::memcpy(pbDestination, pbSource, static_cast<size_t>(cbRow) * rows);
+            return;
+        }
+
+        for (UINT32 y = 0; y < rows; y++)
+        {
+            std::memcpy(
+                pbDestination + static_cast<LONG_PTR>(lDestinationStride) * y,
+                pbSource + static_cast<LONG_PTR>(lSourceStride) * y,
+                cbRow
+                );
+        }
+
+        return;
+    }
+
+    for (UINT32 y = 0; y < rows; y++)
+    {
+        CopyRowNonTemporal(
+            pbDestination + static_cast<LONG_PTR>(lDestinationStride) * y,
+            pbSource + static_cast<LONG_PTR>(lSourceStride) * y,
+            cbRow
+            );
+    }
+
+    // Streaming stores are weakly ordered, they are made visible before the frame is handed over
+    _mm_sfence();
+}
+
+// --------------------------------------------------------------------
+// MirrorRows32
+// --------------------------------------------------------------------
+
+void MirrorRows32(
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    BYTE        *pbDestination,
+    LONG        lDestinationStride,
+    UINT32      widthInPixels,
+    UINT32      rows
+    )
+{
+    assert(pbSource != nullptr);
+    assert(pbDestination != nullptr);
+
+    for (UINT32 y = 0; y < rows; y++)
+    {
+        const UINT32 *pSource{ reinterpret_cast<const UINT32 *>(pbSource + static_cast<LONG_PTR>(lSourceStride) * y) };
+        UINT32 *pDestination{ reinterpret_cast<UINT32 *>(pbDestination + static_cast<LONG_PTR>(lDestinationStride) * y) };
+
+        UINT32 x{ 0 };
+        for (; x + 4 <= widthInPixels; x += 4)
+        {
+            __m128i pixels{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource + widthInPixels - x - 4)) };
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + x), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+
+        for (; x < widthInPixels; x++)
+        {
+            pDestination[x] = pSource[widthInPixels - x - 1];
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// TransposeImage32
+// --------------------------------------------------------------------
+
+void TransposeImage32(
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    UINT32      sourceWidthInPixels,
+    UINT32      sourceHeightInPixels,
+    BYTE        *pbDestination,
+    LONG        lDestinationStride
+    )
+{
+    assert(pbSource != nullptr);
+    assert(pbDestination != nullptr);
+
+    for (UINT32 blockY = 0; blockY < sourceHeightInPixels; blockY += TRANSPOSE_BLOCK_ROWS)
+    {
+        const UINT32 blockEnd{ (std::min)(blockY + TRANSPOSE_BLOCK_ROWS, sourceHeightInPixels) };
+        const UINT32 tiledEnd{ blockY + ((blockEnd - blockY) & ~3u) };
+
+        UINT32 x{ 0 };
+        for (; x + 4 <= sourceWidthInPixels; x += 4)
+        {
+            BYTE *pbDestinationRow0{ pbDestination + static_cast<LONG_PTR>(lDestinationStride) * x };
+
+            UINT32 y{ blockY };
+            for (; y < tiledEnd; y += 4)
+            {
+                const BYTE *pbSourceRow0{ pbSource + static_cast<LONG_PTR>(lSourceStride) * y + static_cast<size_t>(x) * 4 };
+
+                __m128i row0{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSourceRow0)) };
+                __m128i row1{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSourceRow0 + lSourceStride)) };
+                __m128i row2{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSourceRow0 + static_cast<LONG_PTR>(lSourceStride) * 2)) };
+                __m128i row3{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSourceRow0 + static_cast<LONG_PTR>(lSourceStride) * 3)) };
+
+                // 4x4 transpose of 32-bit lanes
+                __m128i low01{ _mm_unpacklo_epi32(row0, row1) };
+                __m128i low23{ _mm_unpacklo_epi32(row2, row3) };
+                __m128i high01{ _mm_unpackhi_epi32(row0, row1) };
+                __m128i high23{ _mm_unpackhi_epi32(row2, row3) };
+
+                BYTE *pbDestinationTile{ pbDestinationRow0 + static_cast<size_t>(y) * 4 };
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pbDestinationTile), _mm_unpacklo_epi64(low01, low23));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pbDestinationTile + lDestinationStride), _mm_unpackhi_epi64(low01, low23));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pbDestinationTile + static_cast<LONG_PTR>(lDestinationStride) * 2), _mm_unpacklo_epi64(high01, high23));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pbDestinationTile + static_cast<LONG_PTR>(lDestinationStride) * 3), _mm_unpackhi_epi64(high01, high23));
+            }
+
+            // Rows left in the block that don't fill a tile
+            for (; y < blockEnd; y++)
+            {
+                const UINT32 *pSource{ reinterpret_cast<const UINT32 *>(pbSource + static_cast<LONG_PTR>(lSourceStride) * y) + x };
+                for (UINT32 i = 0; i < 4; i++)
+                {
+                    reinterpret_cast<UINT32 *>(pbDestinationRow0 + static_cast<LONG_PTR>(lDestinationStride) * i)[y] = pSource[i];
+                }
+            }
+        }
+
+        // Columns left that don't fill a tile
+        for (; x < sourceWidthInPixels; x++)
+        {
+            UINT32 *pDestination{ reinterpret_cast<UINT32 *>(pbDestination + static_cast<LONG_PTR>(lDestinationStride) * x) };
+            for (UINT32 y = blockY; y < blockEnd; y++)
+            {
+                pDestination[y] = reinterpret_cast<const UINT32 *>(pbSource + static_cast<LONG_PTR>(lSourceStride) * y)[x];
+            }
+        }
+    }
+}
+
+// --------------------------------------------------------------------
+// ExtractLumaFromYuy2
+// --------------------------------------------------------------------
+
+void ExtractLumaFromYuy2(
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    BYTE        *pbDestination,
+    LONG        lDestinationStride,
+    UINT32      widthInPixels,
+    UINT32      rows
+    )
+{
+    assert(pbSource != nullptr);
+    assert(pbDestination != nullptr);
+
+    const bool bUseAvx2{ GetIsAvx2Supported() };
+    const __m128i lumaMask{ _mm_set1_epi16(0x00FF) };
+
+    for (UINT32 y = 0; y < rows; y++)
+    {
+        const BYTE *pbSourceRow{ pbSource + static_cast<LONG_PTR>(lSourceStride) * y };
+        BYTE *pbDestinationRow{ pbDestination + static_cast<LONG_PTR>(lDestinationStride) * y };
+
+        UINT32 x{ bUseAvx2 ? ExtractLumaRowFromYuy2Avx2(pbSourceRow, pbDestinationRow, widthInPixels) : 0 };
+        for (; x + 16 <= widthInPixels; x += 16)
+        {
+            __m128i pixels0{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSourceRow + static_cast<size_t>(x) * 2)) };
+            __m128i pixels1{ _mm_loadu_si128(reinterpret_cast<const __m128i *>(pbSourceRow + static_cast<size_t>(x) * 2 + 16)) };
+
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(pbDestinationRow + x),
+                _mm_packus_epi16(_mm_and_si128(pixels0, lumaMask), _mm_and_si128(pixels1, lumaMask))
+                );
+        }
+
+        for (; x < widthInPixels; x++)
+        {
+            pbDestinationRow[x] = pbSourceRow[static_cast<size_t>(x) * 2];
+        }
+    }
+}
+
+#pragma managed(pop)
@@ -0,0 +1,99 @@
+/*-----------------------------------------------------------------*\
+ *
+ * imagetransform.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:58 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        /// <summary>
+        /// Clockwise rotation applied to the frames.
+        /// </summary>
+        enum class ROTATION
+        {
+            NONE,
+            CLOCKWISE_90,
+            CLOCKWISE_180,
+            CLOCKWISE_270
+        };
+    }
+}
+
+/// <summary>
+/// [Internal][Native] Copy rows of bytes, strides can differ and be negative.
+/// </summary>
+/// <remarks>
+/// With `bStreamDestination` the destination is written with non-temporal stores, bypassing the cache
+///  for a destination that isn't read again soon, and the source is prefetched ahead of the copy.
+/// </remarks>
+void CopyImage(
+    BYTE        *pbDestination,
+    LONG        lDestinationStride,
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    DWORD       cbRow,
+    UINT32      rows,
+    bool        bStreamDestination
+    );
+
+/// <summary>
+/// [Internal][Native] Copy rows of 32-bit pixels mirrored horizontally, strides can be negative.
+/// </summary>
+void MirrorRows32(
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    BYTE        *pbDestination,
+    LONG        lDestinationStride,
+    UINT32      widthInPixels,
+    UINT32      rows
+    );
+
+/// <summary>
+/// [Internal][Native] Transpose an image of 32-bit pixels, source row `y` is written
+///  to destination column `y`, strides can be negative.
+/// </summary>
+/// <remarks>
+/// Pixels are moved in 4x4 tiles, and the tiles are visited in blocks of rows
+///  so each destination row is written a full cache line at a time.
+/// </remarks>
+void TransposeImage32(
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    UINT32      sourceWidthInPixels,
+    UINT32      sourceHeightInPixels,
+    BYTE        *pbDestination,
+    LONG        lDestinationStride
+    );
+
+/// <summary>
+/// [Internal][Native] Copy the luma of YUY2 rows into rows of 8-bit pixels, strides can be negative.
+/// </summary>
+/// <remarks>
+/// Luma is every other byte of YUY2, so it is taken by masking and packing
+///  whole registers of pixels, with AVX2 if supported.
+/// </remarks>
+void ExtractLumaFromYuy2(
+    const BYTE  *pbSource,
+    LONG        lSourceStride,
+    BYTE        *pbDestination,
+    LONG        lDestinationStride,
+    UINT32      widthInPixels,
+    UINT32      rows
+    );
+
+#pragma managed(pop)
@@ -0,0 +1,62 @@
+/*-----------------------------------------------------------------*\
+ *
+ * imageview.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-18 11:12 PM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+namespace LeanCameraCapture
+{
+    namespace Native
+    {
+        /// <summary>
+        /// Pixel formats handled by the native image routines.
+        /// </summary>
+        enum class PIXEL_FORMAT
+        {
+            BGRA32, // 4 bytes per pixel, same memory layout as MFVideoFormat_RGB32.
+            GRAY8,  // 1 byte per pixel.
+            NV12    // 8-bit Y plane followed by an interleaved, half resolution UV plane.
+        };
+
+        /// <summary>
+        /// Non-owning view over an image in memory.
+        /// </summary>
+        /// <remarks>
+        /// Strides are signed, a negative stride means a bottom-up image
+        ///  where `pbScanline0` points to the top row at the end of the memory.
+        /// </remarks>
+        struct IMAGE_VIEW
+        {
+            BYTE            *pbScanline0;       // First row of the image (the Y plane for NV12).
+            LONG            lStride;
+            BYTE            *pbChromaScanline0; // First row of the UV plane for NV12, nullptr otherwise.
+            LONG            lChromaStride;
+            UINT32          widthInPixels;
+            UINT32          heightInPixels;
+            PIXEL_FORMAT    format;
+        };
+
+        /// <summary>
+        /// Gets the bytes per pixel of the first plane of the format.
+        /// </summary>
+        inline UINT32 GetBytesPerPixel(PIXEL_FORMAT format)
+        {
+            return (format == PIXEL_FORMAT::BGRA32) ? 4 : 1;
+        }
+    }
+}
+
+#pragma managed(pop)
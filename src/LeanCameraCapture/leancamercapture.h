@@ -20,13 +20,25 @@
 #include <string>
 #include <memory>
 #include <cmath>
+#include <cstring>
 #include <cassert>
 #include <stdexcept>
 #include <system_error>
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <deque>
 #include <algorithm>
 #include <functional>
 #include <type_traits>
+#include <iterator>
+
+// =========================================
+// ====== Compiler Intrinsics Headers ======
+// =========================================
+
+#include <intrin.h>
+#include <immintrin.h>
 
 // =================================
 // ====== Windows API Headers ======
@@ -38,6 +50,7 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 #include <Shlwapi.h>
+#include <ShlObj.h>
 #include <objbase.h>
 #include <mfapi.h>
 #include <mfidl.h>
@@ -45,6 +58,7 @@
 #include <mftransform.h>
 #include <Mferror.h>
 #include <Dbt.h>
+#include <cfgmgr32.h>
 #include <ks.h>
 #include <crtdbg.h>
 
@@ -57,12 +71,26 @@
 #include "saferelease.h"
 #include "mfmethods.h"
 #include "devicechangenotif.h"
+#include "cpufeatures.h"
+#include "framememory.h"
+#include "imageview.h"
+#include "imagetransform.h"
+#include "negotiationcache.h"
+#include "tracing.h"
 
 // =============================================
 // ====== Native C++ Headers With Classes ======
 // =============================================
 
 #include "CBufferLock.hpp"
+#include "CFrameStatisticsAccumulator.h"
+#include "CReadQueue.h"
+#include "CReaderCounters.h"
+#include "CResampler.h"
+#include "CTensorWriter.h"
+#include "CTraceSpan.hpp"
+#include "CTripleBuffer.h"
+#include "CWorkerPool.h"
 #include "CSourceReader.h"
 
 // =================================
@@ -73,6 +101,22 @@
 #include "CameraCaptureException.hpp"
 #include "CameraCaptureManager.h"
 #include "CameraCaptureDevice.h"
+#include "DeviceReconnectedEventArgs.hpp"
+#include "FormatChangedEventArgs.hpp"
+#include "FramePoolExhaustedPolicy.hpp"
+#include "FramePixelFormat.hpp"
+#include "FrameRotation.hpp"
+#include "FrameStatistics.hpp"
+#include "LatestFrame.hpp"
+#include "PooledFrame.hpp"
+#include "ReaderStatistics.hpp"
+#include "ResampleFilter.hpp"
 #include "ReadSampleFailedEventArgs.hpp"
+#include "ReadSampleIntoCompletedEventArgs.hpp"
 #include "ReadSampleSucceededEventArgs.hpp"
+#include "ReadSampleViewReceivedEventArgs.hpp"
+#include "TensorChannelOrder.hpp"
+#include "TensorDataType.hpp"
+#include "TensorFit.hpp"
+#include "TensorFormat.hpp"
 #include "CameraCaptureReader.h"
@@ -22,7 +22,6 @@
 // =======================================================================
 
 static bool g_IsMediaFoundationStarted{ false };
-static HWND g_hwndMain{ nullptr };
 
 // ======================================
 // ====== Media Foundation Methods ======
@@ -31,15 +30,12 @@ static HWND g_hwndMain{ nullptr };
 // --------------------------------------------------------------------
 // StartMediaFoundation
 //
-// This method takes a window handler for the main window where
-//  the library is going to attach its window-based handlers
-//  like device change notification handler.
+// Device change notifications are received on the library's own
+//  thread and window, so no window of the consumer is needed.
 // --------------------------------------------------------------------
 
-void StartMediaFoundation(HWND hwndMain) noexcept(false)
+void StartMediaFoundation() noexcept(false)
 {
-    assert(hwndMain != nullptr);
-
     if (g_IsMediaFoundationStarted) { return; }
 
     HRESULT hr{ S_OK };
@@ -56,9 +52,8 @@ void StartMediaFoundation(HWND hwndMain) noexcept(false)
         throw std::system_error{ hr, std::system_category(), "Error occurred during MFStartup." };
     }
 
-    // Register capture device change notification for the main window
-    RegisterCaptureDeviceChangeNotificationForHwnd(hwndMain);
-    g_hwndMain = hwndMain;
+    // Start listening for capture device change notifications
+    StartCaptureDeviceChangeNotification();
 
     g_IsMediaFoundationStarted = true;
 }
@@ -73,12 +68,8 @@ void StopMediaFoundation() noexcept(false)
 
     HRESULT hr{ S_OK };
 
-    // Unregister capture device change notification for main window
-    if (g_hwndMain)
-    {
-        UnregisterRegisteredCaptureDeviceChangeNotification(g_hwndMain);
-        g_hwndMain = nullptr;
-    }
+    // Stop listening for capture device change notifications
+    StopCaptureDeviceChangeNotification();
 
     hr = MFShutdown();
     if (FAILED(hr))
@@ -100,13 +91,4 @@ bool GetIsMediaFoundationStarted()
     return g_IsMediaFoundationStarted;
 }
 
-// --------------------------------------------------------------------
-// GetMainHwnd
-// --------------------------------------------------------------------
-
-HWND GetMainHwnd()
-{
-    return g_hwndMain;
-}
-
 #pragma managed(pop)
@@ -20,7 +20,7 @@
 /// <summary>
 /// [Internal][Native] Start the media foundation
 /// </summary>
-void StartMediaFoundation(HWND hwndMain) noexcept(false);
+void StartMediaFoundation() noexcept(false);
 
 /// <summary>
 /// [Internal][Native] Stop the media foundation
@@ -32,9 +32,4 @@ void StopMediaFoundation() noexcept(false);
 /// </summary>
 bool GetIsMediaFoundationStarted();
 
-/// <summary>
-/// [Internal][Native] Get registered Main HWND.
-/// </summary>
-HWND GetMainHwnd();
-
 #pragma managed(pop)
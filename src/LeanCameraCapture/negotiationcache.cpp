@@ -0,0 +1,435 @@
+/*-----------------------------------------------------------------*\
+ *
+ * negotiationcache.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 04:10 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "negotiationcache.h"
+
+// Define the device property keys in this translation unit only
+#include <initguid.h>
+#include <devpkey.h>
+
+#define NEGOTIATION_CACHE_DIRECTORY_NAME    L"LeanCameraCapture"
+#define NEGOTIATION_CACHE_FILE_NAME         L"negotiation.cache"
+
+#define NEGOTIATION_CACHE_FILE_MAGIC        0x4E43434CUL    // 'LCCN'
+#define NEGOTIATION_CACHE_FILE_VERSION      1
+
+// Bounds for reading the file, anything beyond is treated as a corrupted file.
+#define NEGOTIATION_CACHE_MAX_FILE_SIZE     (1024 * 1024)
+#define NEGOTIATION_CACHE_MAX_KEY_LENGTH    4096
+
+#pragma managed(push, off)
+
+// =====================
+// ====== Globals ======
+// =====================
+
+// Entries indexed by the normalized symbolic link and the driver version of the device,
+//  loaded from the file on the first look up.
+static SRWLOCK g_srwlockNegotiationCache{ SRWLOCK_INIT };
+static bool g_bIsNegotiationCacheLoaded{ false };
+static std::unordered_map<std::wstring, NEGOTIATION_CACHE_ENTRY> g_umapNegotiationCache{};
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// GetDeviceDriverVersion
+//
+// Gets the version of the driver of the device the interface belongs
+//  to, empty if it can't be retrieved.
+// --------------------------------------------------------------------
+
+static std::wstring GetDeviceDriverVersion(const WCHAR *pwszDeviceSymbolicLink) noexcept(false)
+{
+    WCHAR wszInstanceId[MAX_DEVICE_ID_LEN]{};
+    WCHAR wszDriverVersion[MAX_PATH]{};
+
+    DEVPROPTYPE propertyType{ DEVPROP_TYPE_EMPTY };
+    ULONG cbProperty{ sizeof(wszInstanceId) };
+    DEVINST devInst{ 0 };
+
+    if (CM_Get_Device_Interface_PropertyW(
+        pwszDeviceSymbolicLink,
+        &DEVPKEY_Device_InstanceId,
+        &propertyType,
+        reinterpret_cast<PBYTE>(wszInstanceId),
+        &cbProperty,
+        0
+        ) != CR_SUCCESS || propertyType != DEVPROP_TYPE_STRING)
+    {
+        return std::wstring{};
+    }
+
+    if (CM_Locate_DevNodeW(&devInst, wszInstanceId, CM_LOCATE_DEVNODE_NORMAL) != CR_SUCCESS)
+    {
+        return std::wstring{};
+    }
+
+    cbProperty = sizeof(wszDriverVersion);
+    if (CM_Get_DevNode_PropertyW(
+        devInst,
+        &DEVPKEY_Device_DriverVersion,
+        &propertyType,
+        reinterpret_cast<PBYTE>(wszDriverVersion),
+        &cbProperty,
+        0
+        ) != CR_SUCCESS || propertyType != DEVPROP_TYPE_STRING)
+    {
+        return std::wstring{};
+    }
+
+    wszDriverVersion[MAX_PATH - 1] = L'\0';
+
+    return std::wstring{ wszDriverVersion };
+}
+
+// --------------------------------------------------------------------
+// GetNegotiationCacheKey
+//
+// Symbolic links are compared case insensitive, so they are keyed in
+//  lower case. A driver update changes the key, so the negotiation is
+//  done again for the new driver.
+// --------------------------------------------------------------------
+
+static std::wstring GetNegotiationCacheKey(const WCHAR *pwszDeviceSymbolicLink) noexcept(false)
+{
+    std::wstring key{ pwszDeviceSymbolicLink };
+
+    if (!key.empty())
+    {
+        CharLowerBuffW(&key[0], static_cast<DWORD>(key.size()));
+    }
+
+    key += L'|';
+    key += GetDeviceDriverVersion(pwszDeviceSymbolicLink);
+
+    return key;
+}
+
+// --------------------------------------------------------------------
+// GetNegotiationCacheDirectory
+//
+// The cache is kept per user under the local application data.
+// --------------------------------------------------------------------
+
+static bool GetNegotiationCacheDirectory(std::wstring *pDirectory) noexcept(false)
+{
+    assert(pDirectory != nullptr);
+
+    PWSTR pwszLocalAppData{ nullptr };
+
+    if (FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &pwszLocalAppData)))
+    {
+        return false;
+    }
+
+    try
+    {
+        *pDirectory = std::wstring{ pwszLocalAppData } + L"\\" + NEGOTIATION_CACHE_DIRECTORY_NAME;
+    }
+    catch (...)
+    {
+        CoTaskMemFree(pwszLocalAppData);
+        throw;
+    }
+
+    CoTaskMemFree(pwszLocalAppData);
+
+    return true;
+}
+
+// --------------------------------------------------------------------
+// LoadNegotiationCache
+//
+// Reads the cache file into the entries, has to be called under the
+//  exclusive lock. A missing or corrupted file leaves the cache empty.
+// --------------------------------------------------------------------
+
+static void LoadNegotiationCache() noexcept(false)
+{
+    std::wstring directory{};
+    if (!GetNegotiationCacheDirectory(&directory)) { return; }
+
+    const std::wstring path{ directory + L"\\" + NEGOTIATION_CACHE_FILE_NAME };
+
+    HANDLE hFile{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (hFile == INVALID_HANDLE_VALUE) { return; }
+
+    LARGE_INTEGER fileSize{};
+    std::vector<BYTE> content{};
+    DWORD cbRead{ 0 };
+    BOOL bIsRead{ FALSE };
+
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0 && fileSize.QuadPart <= NEGOTIATION_CACHE_MAX_FILE_SIZE)
+    {
+        try
+        {
+            content.resize(static_cast<size_t>(fileSize.QuadPart));
+        }
+        catch (...)
+        {
+            CloseHandle(hFile);
+            throw;
+        }
+
+        bIsRead = ReadFile(hFile, content.data(), static_cast<DWORD>(content.size()), &cbRead, nullptr);
+    }
+
+    CloseHandle(hFile);
+
+    if (!bIsRead || cbRead != content.size()) { return; }
+
+    // ---
+    // --- Parse the entries, the file is taken as a whole or not at all
+    // ---
+
+    std::unordered_map<std::wstring, NEGOTIATION_CACHE_ENTRY> umapEntries{};
+    size_t offset{ 0 };
+
+    auto read = [&content, &offset](void *pDestination, size_t cb) {
+        if (content.size() - offset < cb) { return false; }
+        std::memcpy(pDestination, content.data() + offset, cb);
+        offset += cb;
+        return true;
+    };
+
+    UINT32 magic{ 0 };
+    UINT32 version{ 0 };
+    UINT32 count{ 0 };
+
+    if (!read(&magic, sizeof(magic)) || magic != NEGOTIATION_CACHE_FILE_MAGIC) { return; }
+    if (!read(&version, sizeof(version)) || version != NEGOTIATION_CACHE_FILE_VERSION) { return; }
+    if (!read(&count, sizeof(count))) { return; }
+
+    for (UINT32 i = 0; i < count; i++)
+    {
+        UINT32 keyLength{ 0 };
+        std::wstring key{};
+        NEGOTIATION_CACHE_ENTRY entry{};
+
+        if (!read(&keyLength, sizeof(keyLength)) || keyLength > NEGOTIATION_CACHE_MAX_KEY_LENGTH) { return; }
+
+        key.resize(keyLength);
+        if (keyLength > 0 && !read(&key[0], keyLength * sizeof(WCHAR))) { return; }
+
+        if (!read(&entry, sizeof(entry))) { return; }
+
+        umapEntries[key] = entry;
+    }
+
+    g_umapNegotiationCache.swap(umapEntries);
+
+    _RPTFW2(_CRT_WARN, L"Loaded %d negotiation cache entries from '%s'.\n", count, path.c_str());
+}
+
+// --------------------------------------------------------------------
+// SaveNegotiationCache
+//
+// Writes the entries into a temporary file and replaces the cache file
+//  with it, so a reader never sees a partial file. Has to be called
+//  under the lock.
+// --------------------------------------------------------------------
+
+static void SaveNegotiationCache() noexcept(false)
+{
+    std::wstring directory{};
+    if (!GetNegotiationCacheDirectory(&directory)) { return; }
+
+    const std::wstring path{ directory + L"\\" + NEGOTIATION_CACHE_FILE_NAME };
+    const std::wstring temporaryPath{ path + L".tmp" };
+
+    std::vector<BYTE> content{};
+
+    auto write = [&content](const void *pSource, size_t cb) {
+        const BYTE *pbSource{ static_cast<const BYTE *>(pSource) };
+        content.insert(content.end(), pbSource, pbSource + cb);
+    };
+
+    const UINT32 magic{ NEGOTIATION_CACHE_FILE_MAGIC };
+    const UINT32 version{ NEGOTIATION_CACHE_FILE_VERSION };
+    const UINT32 count{ static_cast<UINT32>(g_umapNegotiationCache.size()) };
+
+    write(&magic, sizeof(magic));
+    write(&version, sizeof(version));
+    write(&count, sizeof(count));
+
+    for (const auto &keyEntryPair : g_umapNegotiationCache)
+    {
+        const UINT32 keyLength{ static_cast<UINT32>(keyEntryPair.first.size()) };
+
+        write(&keyLength, sizeof(keyLength));
+        write(keyEntryPair.first.data(), keyLength * sizeof(WCHAR));
+        write(&keyEntryPair.second, sizeof(keyEntryPair.second));
+    }
+
+    if (!CreateDirectoryW(directory.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) { return; }
+
+    HANDLE hFile{ CreateFileW(temporaryPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (hFile == INVALID_HANDLE_VALUE) { return; }
+
+    DWORD cbWritten{ 0 };
+    const BOOL bIsWritten{
+        WriteFile(hFile, content.data(), static_cast<DWORD>(content.size()), &cbWritten, nullptr)
+            && cbWritten == content.size()
+    };
+
+    CloseHandle(hFile);
+
+    if (!bIsWritten || !MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileW(temporaryPath.c_str());
+        return;
+    }
+
+    _RPTFW2(_CRT_WARN, L"Saved %d negotiation cache entries into '%s'.\n", count, path.c_str());
+}
+
+// =========================================
+// ====== Negotiation Cache Functions ======
+// =========================================
+
+// --------------------------------------------------------------------
+// DescribeMediaTypeForNegotiationCache
+// --------------------------------------------------------------------
+
+bool DescribeMediaTypeForNegotiationCache(IMFMediaType *pMediaType, NEGOTIATION_CACHE_ENTRY *pEntry)
+{
+    assert(pMediaType != nullptr);
+    assert(pEntry != nullptr);
+
+    if (FAILED(pMediaType->GetGUID(MF_MT_SUBTYPE, &pEntry->nativeSubtype))) { return false; }
+    if (FAILED(MFGetAttributeSize(pMediaType, MF_MT_FRAME_SIZE, &pEntry->width, &pEntry->height))) { return false; }
+
+    // The frame rate is optional
+    if (FAILED(MFGetAttributeRatio(pMediaType, MF_MT_FRAME_RATE, &pEntry->frameRateNumerator, &pEntry->frameRateDenominator)))
+    {
+        pEntry->frameRateNumerator = 0;
+        pEntry->frameRateDenominator = 0;
+    }
+
+    return true;
+}
+
+// --------------------------------------------------------------------
+// GetIsMediaTypeMatchingNegotiationCacheEntry
+// --------------------------------------------------------------------
+
+bool GetIsMediaTypeMatchingNegotiationCacheEntry(IMFMediaType *pMediaType, const NEGOTIATION_CACHE_ENTRY &entry)
+{
+    assert(pMediaType != nullptr);
+
+    NEGOTIATION_CACHE_ENTRY description{};
+
+    if (!DescribeMediaTypeForNegotiationCache(pMediaType, &description)) { return false; }
+
+    return description.nativeSubtype == entry.nativeSubtype
+        && description.width == entry.width
+        && description.height == entry.height
+        && description.frameRateNumerator == entry.frameRateNumerator
+        && description.frameRateDenominator == entry.frameRateDenominator;
+}
+
+// --------------------------------------------------------------------
+// LookupNegotiationCacheEntry
+// --------------------------------------------------------------------
+
+bool LookupNegotiationCacheEntry(const WCHAR *pwszDeviceSymbolicLink, NEGOTIATION_CACHE_ENTRY *pEntry)
+{
+    assert(pwszDeviceSymbolicLink != nullptr);
+    assert(pEntry != nullptr);
+
+    bool bIsFound{ false };
+    std::wstring key{};
+
+    try
+    {
+        key = GetNegotiationCacheKey(pwszDeviceSymbolicLink);
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        return false;
+    }
+
+    AcquireSRWLockExclusive(&g_srwlockNegotiationCache);
+
+    try
+    {
+        if (!g_bIsNegotiationCacheLoaded)
+        {
+            g_bIsNegotiationCacheLoaded = true;
+            LoadNegotiationCache();
+        }
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        // Continue with what is kept in memory
+    }
+
+    auto entryFindIterator = g_umapNegotiationCache.find(key);
+    if (entryFindIterator != g_umapNegotiationCache.end())
+    {
+        *pEntry = entryFindIterator->second;
+        bIsFound = true;
+    }
+
+    ReleaseSRWLockExclusive(&g_srwlockNegotiationCache);
+
+    return bIsFound;
+}
+
+// --------------------------------------------------------------------
+// StoreNegotiationCacheEntry
+// --------------------------------------------------------------------
+
+void StoreNegotiationCacheEntry(const WCHAR *pwszDeviceSymbolicLink, const NEGOTIATION_CACHE_ENTRY &entry)
+{
+    assert(pwszDeviceSymbolicLink != nullptr);
+
+    std::wstring key{};
+
+    try
+    {
+        key = GetNegotiationCacheKey(pwszDeviceSymbolicLink);
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        return;
+    }
+
+    AcquireSRWLockExclusive(&g_srwlockNegotiationCache);
+
+    try
+    {
+        // Load first, so the entries of the other devices are kept in the file
+        if (!g_bIsNegotiationCacheLoaded)
+        {
+            g_bIsNegotiationCacheLoaded = true;
+            LoadNegotiationCache();
+        }
+
+        g_umapNegotiationCache[key] = entry;
+
+        SaveNegotiationCache();
+    }
+    catch (const std::bad_alloc &/*ex*/)
+    {
+        // The cache is a speed up only
+    }
+
+    ReleaseSRWLockExclusive(&g_srwlockNegotiationCache);
+}
+
+#pragma managed(pop)
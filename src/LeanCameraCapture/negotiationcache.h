@@ -0,0 +1,58 @@
+/*-----------------------------------------------------------------*\
+ *
+ * negotiationcache.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 04:02 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+/// <summary>
+/// Negotiation of a device kept on disk, the native type is identified by its index
+///  and its description is used to validate the type behind the index.
+/// </summary>
+struct NEGOTIATION_CACHE_ENTRY
+{
+    DWORD   nativeTypeIndex;        // Index of the native type passed to `IMFSourceReader::GetNativeMediaType`.
+    GUID    nativeSubtype;
+    UINT32  width;
+    UINT32  height;
+    UINT32  frameRateNumerator;
+    UINT32  frameRateDenominator;
+    CLSID   processorClsid;         // Video processor converting the native type.
+};
+
+/// <summary>
+/// [Internal][Native] Describe the media type in the entry, the index and the processor aren't touched.
+///  Returns false if the type lacks the subtype or the size.
+/// </summary>
+bool DescribeMediaTypeForNegotiationCache(IMFMediaType *pMediaType, NEGOTIATION_CACHE_ENTRY *pEntry);
+
+/// <summary>
+/// [Internal][Native] Gets if the media type matches the native type described in the entry.
+/// </summary>
+bool GetIsMediaTypeMatchingNegotiationCacheEntry(IMFMediaType *pMediaType, const NEGOTIATION_CACHE_ENTRY &entry);
+
+/// <summary>
+/// [Internal][Native] Look up the negotiation of the device, keyed by the symbolic link and the driver version.
+///  The cache file is loaded on the first look up. Returns false if none is kept.
+/// </summary>
+bool LookupNegotiationCacheEntry(const WCHAR *pwszDeviceSymbolicLink, NEGOTIATION_CACHE_ENTRY *pEntry);
+
+/// <summary>
+/// [Internal][Native] Keep the negotiation of the device and write the cache file.
+///  The cache is a speed up only, so failing to write it is ignored.
+/// </summary>
+void StoreNegotiationCacheEntry(const WCHAR *pwszDeviceSymbolicLink, const NEGOTIATION_CACHE_ENTRY &entry);
+
+#pragma managed(pop)
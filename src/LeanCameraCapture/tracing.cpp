@@ -0,0 +1,269 @@
+/*-----------------------------------------------------------------*\
+ *
+ * tracing.cpp
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 07:55 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#include "leancamercapture.h"
+
+#include "tracing.h"
+
+// Spans kept per thread for a trace, later spans of the thread are dropped.
+#define TRACE_BUFFER_SPANS 8192
+
+#pragma managed(push, off)
+
+// ================================
+// ====== Private Structures ======
+// ================================
+
+struct TRACE_SPAN
+{
+    const char  *pszName;
+    const void  *id;
+    LONGLONG    llBegin;
+    LONGLONG    llEnd;
+};
+
+/// <summary>
+/// Spans of a thread, written only by its thread. The count is published after the span,
+///  so a reader sees whole spans, and the generation resets the buffer on the next write
+///  after a new trace starts. Once its thread exits, the buffer is taken by the next thread
+///  that records a span, so the buffers are bounded by the threads tracing at once.
+/// </summary>
+struct TRACE_THREAD_BUFFER
+{
+    TRACE_THREAD_BUFFER *pNext;         // Buffers are never freed, so readers walk the list freely.
+    volatile LONG       lIsFree;        // Set on exit of the thread, cleared by the thread taking it.
+    volatile DWORD      dwThreadId;
+    volatile LONG       lGeneration;
+    volatile LONG       lCount;
+    TRACE_SPAN          spans[TRACE_BUFFER_SPANS];
+};
+
+// =====================
+// ====== Globals ======
+// =====================
+
+volatile LONG g_lIsTracingEnabled{ 0 };
+
+static volatile LONG g_lTraceGeneration{ 0 };
+static volatile LONG64 g_llTraceStart{ 0 };
+
+static TRACE_THREAD_BUFFER *volatile g_pTraceBuffers{ nullptr };
+
+// The buffer of each thread is kept in a FLS slot, allocated on the first trace.
+//  Unlike TLS, the slot has a callback on the exit of the thread, without a `DllMain`.
+static INIT_ONCE g_traceFlsInitOnce = INIT_ONCE_STATIC_INIT;
+static DWORD g_dwTraceFlsIndex{ FLS_OUT_OF_INDEXES };
+
+// ==============================
+// ====== Helper Functions ======
+// ==============================
+
+// --------------------------------------------------------------------
+// ReleaseThreadTraceBuffer
+//
+// Called on the exit of a thread that has a buffer, the spans are
+//  kept until another thread takes the buffer.
+// --------------------------------------------------------------------
+
+static VOID WINAPI ReleaseThreadTraceBuffer(PVOID pData)
+{
+    auto pBuffer = static_cast<TRACE_THREAD_BUFFER *>(pData);
+    if (pBuffer)
+    {
+        InterlockedExchange(&pBuffer->lIsFree, TRUE);
+    }
+}
+
+// --------------------------------------------------------------------
+// InitializeTraceFls
+// --------------------------------------------------------------------
+
+static BOOL CALLBACK InitializeTraceFls(PINIT_ONCE /*pInitOnce*/, PVOID /*pParameter*/, PVOID * /*ppContext*/)
+{
+    g_dwTraceFlsIndex = FlsAlloc(ReleaseThreadTraceBuffer);
+
+    return TRUE;
+}
+
+// --------------------------------------------------------------------
+// GetThreadTraceBuffer
+//
+// The buffer of an exited thread is taken with a compare exchange on
+//  its flag, otherwise a new buffer is pushed to the front of the list
+//  with a compare exchange. Nothing is ever removed from the list.
+// --------------------------------------------------------------------
+
+static TRACE_THREAD_BUFFER *GetThreadTraceBuffer()
+{
+    if (g_dwTraceFlsIndex == FLS_OUT_OF_INDEXES) { return nullptr; }
+
+    auto pBuffer = static_cast<TRACE_THREAD_BUFFER *>(FlsGetValue(g_dwTraceFlsIndex));
+    if (pBuffer) { return pBuffer; }
+
+    for (TRACE_THREAD_BUFFER *pFree = g_pTraceBuffers; pFree; pFree = pFree->pNext)
+    {
+        if (InterlockedCompareExchange(&pFree->lIsFree, FALSE, TRUE) == TRUE)
+        {
+            pBuffer = pFree;
+            break;
+        }
+    }
+
+    if (pBuffer)
+    {
+        // The spans of the exited thread are dropped before the buffer changes threads
+        InterlockedExchange(&pBuffer->lCount, 0);
+        pBuffer->dwThreadId = GetCurrentThreadId();
+        InterlockedExchange(&pBuffer->lGeneration, g_lTraceGeneration);
+    }
+    else
+    {
+        pBuffer = new (std::nothrow) TRACE_THREAD_BUFFER{};
+        if (!pBuffer) { return nullptr; }
+
+        pBuffer->dwThreadId = GetCurrentThreadId();
+        pBuffer->lGeneration = g_lTraceGeneration;
+
+        TRACE_THREAD_BUFFER *pHead{ nullptr };
+        do
+        {
+            pHead = g_pTraceBuffers;
+            pBuffer->pNext = pHead;
+        } while (InterlockedCompareExchangePointer(
+            reinterpret_cast<PVOID volatile *>(&g_pTraceBuffers), pBuffer, pHead) != pHead);
+    }
+
+    FlsSetValue(g_dwTraceFlsIndex, pBuffer);
+
+    return pBuffer;
+}
+
+// =======================
+// ====== Functions ======
+// =======================
+
+// --------------------------------------------------------------------
+// StartTracing
+// --------------------------------------------------------------------
+
+void StartTracing()
+{
+    InitOnceExecuteOnce(&g_traceFlsInitOnce, InitializeTraceFls, nullptr, nullptr);
+
+    InterlockedExchange64(&g_llTraceStart, GetTraceTime());
+    InterlockedIncrement(&g_lTraceGeneration);
+    InterlockedExchange(&g_lIsTracingEnabled, 1);
+}
+
+// --------------------------------------------------------------------
+// StopTracing
+// --------------------------------------------------------------------
+
+void StopTracing()
+{
+    InterlockedExchange(&g_lIsTracingEnabled, 0);
+}
+
+// --------------------------------------------------------------------
+// GetTraceTime
+// --------------------------------------------------------------------
+
+LONGLONG GetTraceTime()
+{
+    LARGE_INTEGER now{};
+    QueryPerformanceCounter(&now);
+
+    return now.QuadPart;
+}
+
+// --------------------------------------------------------------------
+// RecordTraceSpan
+// --------------------------------------------------------------------
+
+void RecordTraceSpan(const char *pszName, const void *id, LONGLONG llBegin, LONGLONG llEnd)
+{
+    TRACE_THREAD_BUFFER *pBuffer{ GetThreadTraceBuffer() };
+    if (!pBuffer) { return; }
+
+    // Spans of the last trace are dropped on the first write of a new one
+    const LONG lGeneration{ g_lTraceGeneration };
+    if (pBuffer->lGeneration != lGeneration)
+    {
+        InterlockedExchange(&pBuffer->lCount, 0);
+        InterlockedExchange(&pBuffer->lGeneration, lGeneration);
+    }
+
+    const LONG lCount{ pBuffer->lCount };
+    if (lCount >= TRACE_BUFFER_SPANS) { return; }
+
+    pBuffer->spans[lCount] = TRACE_SPAN{ pszName, id, llBegin, llEnd };
+
+    // Publish the span after it is whole
+    InterlockedExchange(&pBuffer->lCount, lCount + 1);
+}
+
+// --------------------------------------------------------------------
+// GetTraceEventsJson
+//
+// Each span is a complete ("X") event in microseconds from the start
+//  of the trace, on the thread that recorded it. The reader is passed
+//  in the args of the event.
+// --------------------------------------------------------------------
+
+std::string GetTraceEventsJson()
+{
+    LARGE_INTEGER frequency{};
+    QueryPerformanceFrequency(&frequency);
+
+    const double microsecondsPerTick{ 1000000.0 / static_cast<double>(frequency.QuadPart) };
+    const LONGLONG llTraceStart{ InterlockedCompareExchange64(&g_llTraceStart, 0, 0) };
+    const LONG lGeneration{ g_lTraceGeneration };
+    const DWORD dwProcessId{ GetCurrentProcessId() };
+
+    std::string json{ "{\"traceEvents\":[" };
+    bool bIsFirst{ true };
+
+    char szEvent[256]{};
+
+    for (TRACE_THREAD_BUFFER *pBuffer = g_pTraceBuffers; pBuffer; pBuffer = pBuffer->pNext)
+    {
+        if (pBuffer->lGeneration != lGeneration) { continue; }
+
+        const LONG lCount{ InterlockedCompareExchange(&pBuffer->lCount, 0, 0) };
+        for (LONG i = 0; i < lCount; i++)
+        {
+            const TRACE_SPAN &span{ pBuffer->spans[i] };
+
+            sprintf_s(
+                szEvent,
+                "%s{\"name\":\"%s\",\"cat\":\"capture\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lu,\"tid\":%lu,\"args\":{\"reader\":\"%p\"}}",
+                bIsFirst ? "" : ",",
+                span.pszName,
+                static_cast<double>(span.llBegin - llTraceStart) * microsecondsPerTick,
+                static_cast<double>(span.llEnd - span.llBegin) * microsecondsPerTick,
+                dwProcessId,
+                pBuffer->dwThreadId,
+                span.id
+                );
+
+            json += szEvent;
+            bIsFirst = false;
+        }
+    }
+
+    json += "],\"displayTimeUnit\":\"ms\"}";
+
+    return json;
+}
+
+#pragma managed(pop)
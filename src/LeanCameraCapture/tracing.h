@@ -0,0 +1,57 @@
+/*-----------------------------------------------------------------*\
+ *
+ * tracing.h
+ *   LeanCameraCapture
+ *     lean-camera-capture
+ *
+ * MIT - see LICENSE at root directory
+ *
+ * CREATED: 2026-10-19 07:55 AM
+ * AUTHORS: Mohammed Elghamry <elghamry.connect[at]outlook[dot]com>
+ *
+\*-----------------------------------------------------------------*/
+
+#pragma once
+
+#include "leancamercapture.h"
+
+#pragma managed(push, off)
+
+/// <summary>
+/// [Internal][Native] Non-zero while spans are recorded, read before taking any time so disabled tracing costs a load.
+/// </summary>
+extern volatile LONG g_lIsTracingEnabled;
+
+/// <summary>
+/// [Internal][Native] Gets if spans are recorded.
+/// </summary>
+inline bool GetIsTracingEnabled() { return g_lIsTracingEnabled != 0; }
+
+/// <summary>
+/// [Internal][Native] Start recording spans, dropping the spans of the last trace.
+/// </summary>
+void StartTracing();
+
+/// <summary>
+/// [Internal][Native] Stop recording spans, the recorded spans are kept until the next start.
+/// </summary>
+void StopTracing();
+
+/// <summary>
+/// [Internal][Native] Gets the time for the spans in performance counter ticks.
+/// </summary>
+LONGLONG GetTraceTime();
+
+/// <summary>
+/// [Internal][Native] Record a span into the buffer of the calling thread, without locking.
+///  `pszName` has to be a string literal, and `id` tells the spans of different readers apart.
+/// </summary>
+void RecordTraceSpan(const char *pszName, const void *id, LONGLONG llBegin, LONGLONG llEnd);
+
+/// <summary>
+/// [Internal][Native] Gets the recorded spans of all the threads as Chrome Trace Event JSON,
+///  which loads in `chrome://tracing` and Perfetto. Can be called while recording.
+/// </summary>
+std::string GetTraceEventsJson() noexcept(false);
+
+#pragma managed(pop)